@@ -97,7 +97,7 @@ T AABoxG<T>::GetDepth() const
 template <typename T>
 Vector3G<T> AABoxG<T>::GetCenter() const
 {
-    return (GetMin() + GetMax()) / 2.0f;
+    return (GetMin() + GetMax()) / static_cast<T>(2);
 }
 
 template <typename T>
@@ -127,7 +127,7 @@ T AABoxG<T>::GetVolume() const
 template <typename T>
 Vector3G<T> AABoxG<T>::GetExtents() const
 {
-    return (GetMax() - GetMin()) / 2.0f;
+    return (GetMax() - GetMin()) / static_cast<T>(2);
 }
 
 template <typename T>
@@ -185,9 +185,9 @@ bool AABoxG<T>::Contains(const Vector3G<T> &point) const
 template <typename T>
 bool AABoxG<T>::Overlap(const AABoxG<T> &aaBox) const
 {
-    return (GetMin().x <= aaBox.GetMax().x && GetMax().x >= GetMin().x &&
-            GetMin().y <= aaBox.GetMax().y && GetMax().y >= GetMin().y &&
-            GetMin().z <= aaBox.GetMax().z && GetMax().z >= GetMin().z);
+    return (GetMin().x <= aaBox.GetMax().x && GetMax().x >= aaBox.GetMin().x &&
+            GetMin().y <= aaBox.GetMax().y && GetMax().y >= aaBox.GetMin().y &&
+            GetMin().z <= aaBox.GetMax().z && GetMax().z >= aaBox.GetMin().z);
 }
 
 template <typename T>
@@ -375,17 +375,37 @@ std::array<QuadG<T>, 6> AABoxG<T>::GetQuads() const
     return aaBoxQuads;
 }
 
+// Arvo's method: every new coordinate is the translation plus, for each
+// axis of the box, the smaller (or larger) of the matrix entry times the box
+// min and max. Gives the bounds of the eight transformed corners (for affine
+// matrices) without building them.
 template <typename T>
 AABoxG<T> operator*(const Matrix4G<T> &m, const AABoxG<T> &b)
 {
-    auto points = b.GetPoints();
-    for (uint i = 0; i < 8; ++i)
+    const Vector3G<T> &bMin = b.GetMin();
+    const Vector3G<T> &bMax = b.GetMax();
+    if (bMin.x > bMax.x || bMin.y > bMax.y || bMin.z > bMax.z)
     {
-        points[i] = m.TransformedPoint(points[i]);
+        return AABoxG<T>();
+    }
+
+    Vector3G<T> newMin = m.c3.xyz();
+    Vector3G<T> newMax = newMin;
+    for (std::size_t j = 0; j < 3; ++j)
+    {
+        const auto &column = m[j];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const T a = column[i] * bMin[j];
+            const T c = column[i] * bMax[j];
+            newMin[i] += Math::Min(a, c);
+            newMax[i] += Math::Max(a, c);
+        }
     }
 
     AABoxG<T> bbox;
-    bbox.CreateFromPositions(points);
+    bbox.SetMin(newMin);
+    bbox.SetMax(newMax);
     return bbox;
 }
 
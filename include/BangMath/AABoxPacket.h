@@ -0,0 +1,49 @@
+#pragma once
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class AABoxG;
+template <typename>
+class RayG;
+
+// N axis aligned boxes stored as structure of arrays, to test one ray against
+// all of them at once in SIMD4G blocks (e.g. the children of a wide BVH
+// node). N must be a multiple of 4. Slots never set are empty and never hit.
+template <typename T, int N>
+class AABoxPacketG
+{
+public:
+    AABoxPacketG();
+    explicit AABoxPacketG(const AABoxG<T> *aaBoxes);
+
+    void SetAABox(int i, const AABoxG<T> &aaBox);
+    AABoxG<T> GetAABox(int i) const;
+
+    // Returns a mask with bit i set when the ray hits box i before
+    // maxDistance. distancesOut, if given, gets N entry distances, 0 for boxes
+    // containing the ray origin.
+    int IntersectRay(const RayG<T> &ray,
+                     T maxDistance,
+                     T *distancesOut = nullptr) const;
+
+    static constexpr int GetSize();
+
+private:
+    alignas(32) T m_min[3][N];
+    alignas(32) T m_max[3][N];
+    int m_validMask = 0;
+};
+
+template <typename T>
+using AABoxPacket4G = AABoxPacketG<T, 4>;
+template <typename T>
+using AABoxPacket8G = AABoxPacketG<T, 8>;
+
+BANG_MATH_DEFINE_USINGS(AABoxPacket4)
+BANG_MATH_DEFINE_USINGS(AABoxPacket8)
+}
+
+#include "BangMath/AABoxPacket.tcc"
@@ -0,0 +1,115 @@
+#include "BangMath/AABoxPacket.h"
+
+#include "BangMath/AABox.h"
+#include "BangMath/Math.h"
+#include "BangMath/Ray.h"
+#include "BangMath/SIMD.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T, int N>
+AABoxPacketG<T, N>::AABoxPacketG()
+{
+    static_assert(N > 0 && N % 4 == 0 && N <= 16,
+                  "AABoxPacketG size must be a multiple of 4, up to 16");
+
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        for (int i = 0; i < N; ++i)
+        {
+            m_min[axis][i] = T(0);
+            m_max[axis][i] = T(0);
+        }
+    }
+}
+
+template <typename T, int N>
+AABoxPacketG<T, N>::AABoxPacketG(const AABoxG<T> *aaBoxes) : AABoxPacketG()
+{
+    for (int i = 0; i < N; ++i)
+    {
+        SetAABox(i, aaBoxes[i]);
+    }
+}
+
+template <typename T, int N>
+void AABoxPacketG<T, N>::SetAABox(int i, const AABoxG<T> &aaBox)
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        m_min[axis][i] = aaBox.GetMin()[axis];
+        m_max[axis][i] = aaBox.GetMax()[axis];
+    }
+
+    // Empty boxes (min > max) would pass the slab test, mask them out
+    if (aaBox.GetMin() <= aaBox.GetMax())
+    {
+        m_validMask |= (1 << i);
+    }
+    else
+    {
+        m_validMask &= ~(1 << i);
+    }
+}
+
+template <typename T, int N>
+AABoxG<T> AABoxPacketG<T, N>::GetAABox(int i) const
+{
+    if ((m_validMask & (1 << i)) == 0)
+    {
+        return AABoxG<T>::Empty();
+    }
+
+    return AABoxG<T>(Vector3G<T>(m_min[0][i], m_min[1][i], m_min[2][i]),
+                     Vector3G<T>(m_max[0][i], m_max[1][i], m_max[2][i]));
+}
+
+template <typename T, int N>
+int AABoxPacketG<T, N>::IntersectRay(const RayG<T> &ray,
+                                     T maxDistance,
+                                     T *distancesOut) const
+{
+    using SIMD = SIMD4G<T>;
+
+    const auto &origin = ray.GetOrigin();
+    const auto &direction = ray.GetDirection();
+    const SIMD ox(origin.x), oy(origin.y), oz(origin.z);
+    const SIMD invX((direction.x != 0) ? T(1) / direction.x : Math::Max<T>());
+    const SIMD invY((direction.y != 0) ? T(1) / direction.y : Math::Max<T>());
+    const SIMD invZ((direction.z != 0) ? T(1) / direction.z : Math::Max<T>());
+    const SIMD zero(T(0));
+    const SIMD maxDistances(maxDistance);
+
+    int hitMask = 0;
+    for (int b = 0; b < N; b += 4)
+    {
+        const SIMD tx0 = (SIMD::Load(m_min[0] + b) - ox) * invX;
+        const SIMD tx1 = (SIMD::Load(m_max[0] + b) - ox) * invX;
+        const SIMD ty0 = (SIMD::Load(m_min[1] + b) - oy) * invY;
+        const SIMD ty1 = (SIMD::Load(m_max[1] + b) - oy) * invY;
+        const SIMD tz0 = (SIMD::Load(m_min[2] + b) - oz) * invZ;
+        const SIMD tz1 = (SIMD::Load(m_max[2] + b) - oz) * invZ;
+
+        const SIMD tNear =
+            SIMD::Max(SIMD::Max(SIMD::Min(tx0, tx1), SIMD::Min(ty0, ty1)),
+                      SIMD::Max(SIMD::Min(tz0, tz1), zero));
+        const SIMD tFar =
+            SIMD::Min(SIMD::Min(SIMD::Max(tx0, tx1), SIMD::Max(ty0, ty1)),
+                      SIMD::Min(SIMD::Max(tz0, tz1), maxDistances));
+
+        hitMask |= (SIMD::LessEqualMask(tNear, tFar) << b);
+        if (distancesOut)
+        {
+            tNear.Store(distancesOut + b);
+        }
+    }
+    return (hitMask & m_validMask);
+}
+
+template <typename T, int N>
+constexpr int AABoxPacketG<T, N>::GetSize()
+{
+    return N;
+}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+// std::allocator replacement that returns Alignment-aligned blocks, so that
+// containers can be fed directly to the aligned SIMD4G kernels.
+template <typename T, std::size_t Alignment = 32>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    template <typename OtherT>
+    struct rebind
+    {
+        using other = AlignedAllocator<OtherT, Alignment>;
+    };
+
+    AlignedAllocator() = default;
+
+    template <typename OtherT>
+    AlignedAllocator(const AlignedAllocator<OtherT, Alignment> &);
+
+    T *allocate(std::size_t n);
+    void deallocate(T *p, std::size_t n);
+};
+
+template <typename T, class OtherT, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &,
+                const AlignedAllocator<OtherT, Alignment> &);
+
+template <typename T, class OtherT, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &,
+                const AlignedAllocator<OtherT, Alignment> &);
+}
+
+#include "BangMath/AlignedAllocator.tcc"
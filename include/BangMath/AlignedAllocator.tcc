@@ -0,0 +1,55 @@
+#include "BangMath/AlignedAllocator.h"
+
+#include <cstdint>
+#include <new>
+
+namespace Bang
+{
+template <typename T, std::size_t Alignment>
+template <typename OtherT>
+AlignedAllocator<T, Alignment>::AlignedAllocator(
+    const AlignedAllocator<OtherT, Alignment> &)
+{
+}
+
+template <typename T, std::size_t Alignment>
+T *AlignedAllocator<T, Alignment>::allocate(std::size_t n)
+{
+    static_assert((Alignment & (Alignment - 1)) == 0,
+                  "Alignment must be a power of two");
+
+    // Over-allocate, and keep the original pointer just before the block
+    const std::size_t extra = Alignment + sizeof(void *);
+    void *raw = ::operator new(n * sizeof(T) + extra);
+    const std::uintptr_t rawAddress = reinterpret_cast<std::uintptr_t>(raw);
+    const std::uintptr_t alignedAddress =
+        (rawAddress + sizeof(void *) + Alignment - 1) &
+        ~static_cast<std::uintptr_t>(Alignment - 1);
+    void **aligned = reinterpret_cast<void **>(alignedAddress);
+    aligned[-1] = raw;
+    return reinterpret_cast<T *>(aligned);
+}
+
+template <typename T, std::size_t Alignment>
+void AlignedAllocator<T, Alignment>::deallocate(T *p, std::size_t)
+{
+    if (p)
+    {
+        ::operator delete(reinterpret_cast<void **>(p)[-1]);
+    }
+}
+
+template <typename T, class OtherT, std::size_t Alignment>
+bool operator==(const AlignedAllocator<T, Alignment> &,
+                const AlignedAllocator<OtherT, Alignment> &)
+{
+    return true;
+}
+
+template <typename T, class OtherT, std::size_t Alignment>
+bool operator!=(const AlignedAllocator<T, Alignment> &,
+                const AlignedAllocator<OtherT, Alignment> &)
+{
+    return false;
+}
+}
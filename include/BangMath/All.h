@@ -1,32 +1,59 @@
 #pragma once
 
 #include "BangMath/AABox.h"
+#include "BangMath/AABoxPacket.h"
+#include "BangMath/AlignedAllocator.h"
 #include "BangMath/AARect.h"
 #include "BangMath/Axis.h"
+#include "BangMath/BVH.h"
 #include "BangMath/Box.h"
 #include "BangMath/Color.h"
+#include "BangMath/ConvexHull.h"
+#include "BangMath/ConvexHull2D.h"
+#include "BangMath/ContactManifold.h"
+#include "BangMath/CullResult.h"
 #include "BangMath/Defines.h"
+#include "BangMath/DualQuaternion.h"
+#include "BangMath/DynamicAABBTree.h"
+#include "BangMath/Frustum.h"
 #include "BangMath/Geometry.h"
+#include "BangMath/KDTree.h"
 #include "BangMath/Math.h"
 #include "BangMath/Matrix3.h"
+#include "BangMath/Matrix3x4.h"
 #include "BangMath/Matrix4.h"
+#include "BangMath/Matrix4SIMD.h"
 #include "BangMath/Orientation.h"
+#include "BangMath/Parallel.h"
 #include "BangMath/Plane.h"
 #include "BangMath/Polygon.h"
 #include "BangMath/Polygon2D.h"
+#include "BangMath/PolygonTriangulator.h"
+#include "BangMath/PreparedPolygon2D.h"
 #include "BangMath/Quad.h"
 #include "BangMath/Quaternion.h"
+#include "BangMath/QuaternionSIMD.h"
 #include "BangMath/Random.h"
+#include "BangMath/RandomEngines.h"
+#include "BangMath/RandomGenerator.h"
 #include "BangMath/Ray.h"
+#include "BangMath/RayPacket.h"
 #include "BangMath/Ray2D.h"
 #include "BangMath/Rect.h"
+#include "BangMath/Sampling.h"
+#include "BangMath/SIMD.h"
 #include "BangMath/Segment.h"
 #include "BangMath/Segment2D.h"
 #include "BangMath/SimplexNoise.h"
+#include "BangMath/Skinning.h"
+#include "BangMath/SpatialGrid.h"
 #include "BangMath/Sphere.h"
+#include "BangMath/SweepAndPrune.h"
+#include "BangMath/TransformHierarchy.h"
 #include "BangMath/Transformation.h"
 #include "BangMath/Triangle.h"
 #include "BangMath/Triangle2D.h"
 #include "BangMath/Vector2.h"
 #include "BangMath/Vector3.h"
 #include "BangMath/Vector4.h"
+#include "BangMath/VectorSoA.h"
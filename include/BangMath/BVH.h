@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class RayG;
+template <typename>
+class SphereG;
+template <typename>
+class Vector3G;
+
+// Bounding volume hierarchy over a set of primitives, each one given by its
+// AABoxG. Built top-down with a binned surface area heuristic and stored as a
+// flat array of nodes in depth-first order: the left child of an interior
+// node is always the next node, so only the right child index is stored.
+//
+// Primitives are referred to by their index in the array of boxes passed to
+// Build. Ray queries test the primitive boxes (hit distance being where the ray
+// enters the box) unless an intersector is given, which is called as
+// intersector(primitive, ray, &distance) and must return whether the primitive
+// was hit, e.g. to test the actual triangles with Geometry.
+template <typename T>
+class BVHG
+{
+public:
+    struct Node
+    {
+        AABoxG<T> aaBox;
+        // Leaf: first index into GetPrimitiveIndices().
+        // Interior: index of the right child node.
+        std::uint32_t first = 0;
+        // Number of primitives in a leaf, 0 for interior nodes
+        std::uint32_t count = 0;
+
+        bool IsLeaf() const;
+    };
+
+    BVHG() = default;
+
+    void Build(const std::vector<AABoxG<T>> &primitiveBoxes,
+               std::size_t maxLeafSize = 4);
+    void Build(const AABoxG<T> *primitiveBoxes,
+               std::size_t primitiveCount,
+               std::size_t maxLeafSize = 4);
+
+    // Recomputes the node boxes for moved primitives, keeping the topology.
+    // The boxes must be as many as the ones used to build. Cheaper than a
+    // rebuild, but the tree quality degrades as primitives move far.
+    void Refit(const std::vector<AABoxG<T>> &primitiveBoxes);
+    void Refit(const AABoxG<T> *primitiveBoxes);
+
+    void Clear();
+
+    // Closest hit. Returns false if nothing is hit before maxDistance.
+    bool Raycast(const RayG<T> &ray,
+                 T maxDistance,
+                 T *hitDistance = nullptr,
+                 std::size_t *hitPrimitive = nullptr) const;
+    template <class Intersector>
+    bool Raycast(const RayG<T> &ray,
+                 T maxDistance,
+                 Intersector intersector,
+                 T *hitDistance = nullptr,
+                 std::size_t *hitPrimitive = nullptr) const;
+
+    // Any hit, stops at the first primitive hit before maxDistance
+    bool RaycastAny(const RayG<T> &ray,
+                    T maxDistance,
+                    std::size_t *hitPrimitive = nullptr) const;
+    template <class Intersector>
+    bool RaycastAny(const RayG<T> &ray,
+                    T maxDistance,
+                    Intersector intersector,
+                    std::size_t *hitPrimitive = nullptr) const;
+
+    // Appends to primitivesOut the primitives whose box overlaps the query
+    void QueryOverlaps(const AABoxG<T> &aaBox,
+                       std::vector<std::size_t> *primitivesOut) const;
+    void QueryOverlaps(const SphereG<T> &sphere,
+                       std::vector<std::size_t> *primitivesOut) const;
+
+    // Calls visitor(primitive) for every primitive whose box overlaps
+    template <class Visitor>
+    void VisitOverlaps(const AABoxG<T> &aaBox, Visitor visitor) const;
+    template <class Visitor>
+    void VisitOverlaps(const SphereG<T> &sphere, Visitor visitor) const;
+
+    bool IsEmpty() const;
+    const AABoxG<T> &GetAABox() const;
+    std::size_t GetPrimitiveCount() const;
+    const std::vector<Node> &GetNodes() const;
+    const std::vector<std::uint32_t> &GetPrimitiveIndices() const;
+
+private:
+    static constexpr int NumBins = 12;
+    static constexpr int MaxDepth = 64;
+
+    std::vector<Node> m_nodes;
+    std::vector<std::uint32_t> m_primitiveIndices;
+    // Primitive boxes in the order of m_primitiveIndices
+    std::vector<AABoxG<T>> m_primitiveBoxes;
+
+    std::uint32_t BuildNode(const AABoxG<T> *primitiveBoxes,
+                            const std::vector<Vector3G<T>> &centroids,
+                            std::size_t begin,
+                            std::size_t end,
+                            std::size_t maxLeafSize,
+                            int depth);
+
+    template <class SlotIntersector>
+    bool Traverse(const RayG<T> &ray,
+                  T maxDistance,
+                  const SlotIntersector &intersectSlot,
+                  bool anyHit,
+                  T *hitDistance,
+                  std::size_t *hitPrimitive) const;
+
+    template <class Overlaps, class Visitor>
+    void TraverseOverlaps(const Overlaps &overlaps, Visitor &visitor) const;
+
+    static Vector3G<T> GetInverseDirection(const RayG<T> &ray);
+    static bool IntersectRayBox(const Vector3G<T> &origin,
+                                const Vector3G<T> &invDirection,
+                                const AABoxG<T> &aaBox,
+                                T maxDistance,
+                                T *nearDistance);
+    static bool OverlapBoxBox(const AABoxG<T> &b0, const AABoxG<T> &b1);
+    static bool OverlapSphereBox(const SphereG<T> &sphere,
+                                 const AABoxG<T> &aaBox);
+    static void Grow(AABoxG<T> *aaBox, const AABoxG<T> &other);
+    static int GetBin(T value, T min, T binScale);
+};
+
+BANG_MATH_DEFINE_USINGS(BVH)
+}
+
+#include "BangMath/BVH.tcc"
@@ -0,0 +1,620 @@
+#include "BangMath/BVH.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "BangMath/Math.h"
+#include "BangMath/Ray.h"
+#include "BangMath/Sphere.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+bool BVHG<T>::Node::IsLeaf() const
+{
+    return (count > 0);
+}
+
+template <typename T>
+void BVHG<T>::Build(const std::vector<AABoxG<T>> &primitiveBoxes,
+                    std::size_t maxLeafSize)
+{
+    Build(primitiveBoxes.data(), primitiveBoxes.size(), maxLeafSize);
+}
+
+template <typename T>
+void BVHG<T>::Build(const AABoxG<T> *primitiveBoxes,
+                    std::size_t primitiveCount,
+                    std::size_t maxLeafSize)
+{
+    Clear();
+    if (primitiveCount == 0)
+    {
+        return;
+    }
+
+    std::vector<Vector3G<T>> centroids(primitiveCount);
+    for (std::size_t i = 0; i < primitiveCount; ++i)
+    {
+        centroids[i] = primitiveBoxes[i].GetCenter();
+    }
+
+    m_primitiveIndices.resize(primitiveCount);
+    std::iota(m_primitiveIndices.begin(), m_primitiveIndices.end(), 0u);
+
+    m_nodes.reserve(2 * primitiveCount - 1);
+    BuildNode(primitiveBoxes,
+              centroids,
+              0,
+              primitiveCount,
+              std::max(maxLeafSize, std::size_t(1)),
+              0);
+
+    // Keep a copy of the boxes in leaf order, so leaves read them linearly
+    m_primitiveBoxes.resize(primitiveCount);
+    for (std::size_t i = 0; i < primitiveCount; ++i)
+    {
+        m_primitiveBoxes[i] = primitiveBoxes[m_primitiveIndices[i]];
+    }
+}
+
+template <typename T>
+void BVHG<T>::Refit(const std::vector<AABoxG<T>> &primitiveBoxes)
+{
+    Refit(primitiveBoxes.data());
+}
+
+template <typename T>
+void BVHG<T>::Refit(const AABoxG<T> *primitiveBoxes)
+{
+    for (std::size_t i = 0; i < m_primitiveBoxes.size(); ++i)
+    {
+        m_primitiveBoxes[i] = primitiveBoxes[m_primitiveIndices[i]];
+    }
+
+    // Children always come after their parent, so walking backwards
+    // updates every node after its children
+    for (std::size_t n = m_nodes.size(); n-- > 0;)
+    {
+        Node &node = m_nodes[n];
+        node.aaBox = AABoxG<T>::Empty();
+        if (node.IsLeaf())
+        {
+            for (std::uint32_t i = 0; i < node.count; ++i)
+            {
+                Grow(&node.aaBox, m_primitiveBoxes[node.first + i]);
+            }
+        }
+        else
+        {
+            Grow(&node.aaBox, m_nodes[n + 1].aaBox);
+            Grow(&node.aaBox, m_nodes[node.first].aaBox);
+        }
+    }
+}
+
+template <typename T>
+void BVHG<T>::Clear()
+{
+    m_nodes.clear();
+    m_primitiveIndices.clear();
+    m_primitiveBoxes.clear();
+}
+
+template <typename T>
+bool BVHG<T>::Raycast(const RayG<T> &ray,
+                      T maxDistance,
+                      T *hitDistance,
+                      std::size_t *hitPrimitive) const
+{
+    const auto invDirection = GetInverseDirection(ray);
+    const auto intersectSlot = [&](std::size_t slot, T *distance) {
+        return IntersectRayBox(ray.GetOrigin(),
+                               invDirection,
+                               m_primitiveBoxes[slot],
+                               maxDistance,
+                               distance);
+    };
+    return Traverse(
+        ray, maxDistance, intersectSlot, false, hitDistance, hitPrimitive);
+}
+
+template <typename T>
+template <class Intersector>
+bool BVHG<T>::Raycast(const RayG<T> &ray,
+                      T maxDistance,
+                      Intersector intersector,
+                      T *hitDistance,
+                      std::size_t *hitPrimitive) const
+{
+    const auto intersectSlot = [&](std::size_t slot, T *distance) {
+        return intersector(
+            static_cast<std::size_t>(m_primitiveIndices[slot]), ray, distance);
+    };
+    return Traverse(
+        ray, maxDistance, intersectSlot, false, hitDistance, hitPrimitive);
+}
+
+template <typename T>
+bool BVHG<T>::RaycastAny(const RayG<T> &ray,
+                         T maxDistance,
+                         std::size_t *hitPrimitive) const
+{
+    const auto invDirection = GetInverseDirection(ray);
+    const auto intersectSlot = [&](std::size_t slot, T *distance) {
+        return IntersectRayBox(ray.GetOrigin(),
+                               invDirection,
+                               m_primitiveBoxes[slot],
+                               maxDistance,
+                               distance);
+    };
+    return Traverse(
+        ray, maxDistance, intersectSlot, true, nullptr, hitPrimitive);
+}
+
+template <typename T>
+template <class Intersector>
+bool BVHG<T>::RaycastAny(const RayG<T> &ray,
+                         T maxDistance,
+                         Intersector intersector,
+                         std::size_t *hitPrimitive) const
+{
+    const auto intersectSlot = [&](std::size_t slot, T *distance) {
+        return intersector(
+            static_cast<std::size_t>(m_primitiveIndices[slot]), ray, distance);
+    };
+    return Traverse(
+        ray, maxDistance, intersectSlot, true, nullptr, hitPrimitive);
+}
+
+template <typename T>
+void BVHG<T>::QueryOverlaps(const AABoxG<T> &aaBox,
+                            std::vector<std::size_t> *primitivesOut) const
+{
+    VisitOverlaps(aaBox, [primitivesOut](std::size_t primitive) {
+        primitivesOut->push_back(primitive);
+    });
+}
+
+template <typename T>
+void BVHG<T>::QueryOverlaps(const SphereG<T> &sphere,
+                            std::vector<std::size_t> *primitivesOut) const
+{
+    VisitOverlaps(sphere, [primitivesOut](std::size_t primitive) {
+        primitivesOut->push_back(primitive);
+    });
+}
+
+template <typename T>
+template <class Visitor>
+void BVHG<T>::VisitOverlaps(const AABoxG<T> &aaBox, Visitor visitor) const
+{
+    const auto overlaps = [&aaBox](const AABoxG<T> &box) {
+        return OverlapBoxBox(aaBox, box);
+    };
+    TraverseOverlaps(overlaps, visitor);
+}
+
+template <typename T>
+template <class Visitor>
+void BVHG<T>::VisitOverlaps(const SphereG<T> &sphere, Visitor visitor) const
+{
+    const auto overlaps = [&sphere](const AABoxG<T> &box) {
+        return OverlapSphereBox(sphere, box);
+    };
+    TraverseOverlaps(overlaps, visitor);
+}
+
+template <typename T>
+bool BVHG<T>::IsEmpty() const
+{
+    return m_nodes.empty();
+}
+
+template <typename T>
+const AABoxG<T> &BVHG<T>::GetAABox() const
+{
+    return IsEmpty() ? AABoxG<T>::Empty() : m_nodes[0].aaBox;
+}
+
+template <typename T>
+std::size_t BVHG<T>::GetPrimitiveCount() const
+{
+    return m_primitiveIndices.size();
+}
+
+template <typename T>
+const std::vector<typename BVHG<T>::Node> &BVHG<T>::GetNodes() const
+{
+    return m_nodes;
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &BVHG<T>::GetPrimitiveIndices() const
+{
+    return m_primitiveIndices;
+}
+
+// Binned SAH, see Wald, "On fast Construction of SAH-based Bounding Volume
+// Hierarchies" (2007)
+template <typename T>
+std::uint32_t BVHG<T>::BuildNode(const AABoxG<T> *primitiveBoxes,
+                                 const std::vector<Vector3G<T>> &centroids,
+                                 std::size_t begin,
+                                 std::size_t end,
+                                 std::size_t maxLeafSize,
+                                 int depth)
+{
+    const auto nodeIndex = static_cast<std::uint32_t>(m_nodes.size());
+    m_nodes.push_back(Node());
+
+    AABoxG<T> nodeBox;
+    AABoxG<T> centroidBox;
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const auto primitive = m_primitiveIndices[i];
+        Grow(&nodeBox, primitiveBoxes[primitive]);
+        centroidBox.AddPoint(centroids[primitive]);
+    }
+    m_nodes[nodeIndex].aaBox = nodeBox;
+
+    const std::size_t count = (end - begin);
+    int bestAxis = -1;
+    int bestBin = 0;
+    T bestCost = Math::Infinity<T>();
+    for (int axis = 0; axis < 3 && count > 1; ++axis)
+    {
+        const T centroidMin = centroidBox.GetMin()[axis];
+        const T extent = centroidBox.GetMax()[axis] - centroidMin;
+        if (!(extent > 0))
+        {
+            continue;
+        }
+
+        const T binScale = static_cast<T>(NumBins) / extent;
+        std::size_t binCounts[NumBins] = {};
+        AABoxG<T> binBoxes[NumBins];
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            const auto primitive = m_primitiveIndices[i];
+            const int bin =
+                GetBin(centroids[primitive][axis], centroidMin, binScale);
+            ++binCounts[bin];
+            Grow(&binBoxes[bin], primitiveBoxes[primitive]);
+        }
+
+        // Sweep from the right to get the cost of every right side, then
+        // from the left evaluating each split plane between bins
+        T rightCosts[NumBins - 1];
+        AABoxG<T> rightBox;
+        std::size_t rightCount = 0;
+        for (int bin = NumBins - 1; bin > 0; --bin)
+        {
+            Grow(&rightBox, binBoxes[bin]);
+            rightCount += binCounts[bin];
+            rightCosts[bin - 1] =
+                (rightCount > 0) ? (rightCount * rightBox.GetArea()) : T(0);
+        }
+
+        AABoxG<T> leftBox;
+        std::size_t leftCount = 0;
+        for (int bin = 0; bin < NumBins - 1; ++bin)
+        {
+            Grow(&leftBox, binBoxes[bin]);
+            leftCount += binCounts[bin];
+            if (leftCount == 0 || leftCount == count)
+            {
+                continue;
+            }
+
+            const T cost = leftCount * leftBox.GetArea() + rightCosts[bin];
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestAxis = axis;
+                bestBin = bin;
+            }
+        }
+    }
+
+    // Costs are relative to the node area, with the cost of intersecting a
+    // primitive being 1 and the cost of a traversal step TraversalCost
+    constexpr T TraversalCost = T(1);
+    const T nodeArea = nodeBox.GetArea();
+    const T leafCost = count * nodeArea;
+    const T splitCost = TraversalCost * nodeArea + bestCost;
+    const bool isLeaf = (count <= 1) || (depth >= MaxDepth) ||
+                        (count <= maxLeafSize && leafCost <= splitCost);
+    if (isLeaf)
+    {
+        m_nodes[nodeIndex].first = static_cast<std::uint32_t>(begin);
+        m_nodes[nodeIndex].count = static_cast<std::uint32_t>(count);
+        return nodeIndex;
+    }
+
+    std::size_t mid = begin + count / 2;
+    if (bestAxis >= 0)
+    {
+        const T centroidMin = centroidBox.GetMin()[bestAxis];
+        const T binScale =
+            static_cast<T>(NumBins) /
+            (centroidBox.GetMax()[bestAxis] - centroidMin);
+        const auto midIt = std::partition(
+            m_primitiveIndices.begin() + begin,
+            m_primitiveIndices.begin() + end,
+            [&](std::uint32_t primitive) {
+                return GetBin(centroids[primitive][bestAxis],
+                              centroidMin,
+                              binScale) <= bestBin;
+            });
+        mid = static_cast<std::size_t>(midIt - m_primitiveIndices.begin());
+    }
+
+    // The left child is always nodeIndex + 1
+    BuildNode(primitiveBoxes, centroids, begin, mid, maxLeafSize, depth + 1);
+    const auto rightIndex = BuildNode(
+        primitiveBoxes, centroids, mid, end, maxLeafSize, depth + 1);
+    m_nodes[nodeIndex].first = rightIndex;
+    m_nodes[nodeIndex].count = 0;
+    return nodeIndex;
+}
+
+template <typename T>
+template <class SlotIntersector>
+bool BVHG<T>::Traverse(const RayG<T> &ray,
+                       T maxDistance,
+                       const SlotIntersector &intersectSlot,
+                       bool anyHit,
+                       T *hitDistance,
+                       std::size_t *hitPrimitive) const
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    const auto &origin = ray.GetOrigin();
+    const auto invDirection = GetInverseDirection(ray);
+
+    T nodeDistance;
+    if (!IntersectRayBox(
+            origin, invDirection, m_nodes[0].aaBox, maxDistance, &nodeDistance))
+    {
+        return false;
+    }
+
+    struct StackEntry
+    {
+        std::uint32_t node;
+        T distance;
+    };
+    StackEntry stack[MaxDepth + 1];
+    int stackSize = 0;
+
+    bool hit = false;
+    T closestDistance = maxDistance;
+    std::size_t closestSlot = 0;
+    std::uint32_t nodeIndex = 0;
+    while (true)
+    {
+        const Node &node = m_nodes[nodeIndex];
+        if (node.IsLeaf())
+        {
+            for (std::uint32_t i = node.first; i < node.first + node.count;
+                 ++i)
+            {
+                T distance;
+                if (intersectSlot(i, &distance) && distance >= 0 &&
+                    distance <= closestDistance)
+                {
+                    hit = true;
+                    closestDistance = distance;
+                    closestSlot = i;
+                    if (anyHit)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            if (hit && anyHit)
+            {
+                break;
+            }
+        }
+        else
+        {
+            // Visit the nearest child first, and keep the other one for later
+            std::uint32_t nearIndex = nodeIndex + 1;
+            std::uint32_t farIndex = node.first;
+            T nearDistance, farDistance;
+            bool nearHit = IntersectRayBox(origin,
+                                           invDirection,
+                                           m_nodes[nearIndex].aaBox,
+                                           closestDistance,
+                                           &nearDistance);
+            bool farHit = IntersectRayBox(origin,
+                                          invDirection,
+                                          m_nodes[farIndex].aaBox,
+                                          closestDistance,
+                                          &farDistance);
+            if (nearHit && farHit)
+            {
+                if (farDistance < nearDistance)
+                {
+                    std::swap(nearIndex, farIndex);
+                    std::swap(nearDistance, farDistance);
+                }
+                stack[stackSize++] = {farIndex, farDistance};
+                nodeIndex = nearIndex;
+                continue;
+            }
+            else if (nearHit || farHit)
+            {
+                nodeIndex = (nearHit ? nearIndex : farIndex);
+                continue;
+            }
+        }
+
+        // Pop, skipping the nodes that are farther than the closest hit
+        bool popped = false;
+        while (stackSize > 0 && !popped)
+        {
+            const StackEntry &entry = stack[--stackSize];
+            if (entry.distance <= closestDistance)
+            {
+                nodeIndex = entry.node;
+                popped = true;
+            }
+        }
+
+        if (!popped)
+        {
+            break;
+        }
+    }
+
+    if (hit)
+    {
+        if (hitDistance)
+        {
+            *hitDistance = closestDistance;
+        }
+
+        if (hitPrimitive)
+        {
+            *hitPrimitive = m_primitiveIndices[closestSlot];
+        }
+    }
+    return hit;
+}
+
+template <typename T>
+template <class Overlaps, class Visitor>
+void BVHG<T>::TraverseOverlaps(const Overlaps &overlaps,
+                               Visitor &visitor) const
+{
+    if (IsEmpty() || !overlaps(m_nodes[0].aaBox))
+    {
+        return;
+    }
+
+    std::uint32_t stack[MaxDepth + 1];
+    int stackSize = 0;
+    std::uint32_t nodeIndex = 0;
+    while (true)
+    {
+        const Node &node = m_nodes[nodeIndex];
+        if (node.IsLeaf())
+        {
+            for (std::uint32_t i = node.first; i < node.first + node.count;
+                 ++i)
+            {
+                if (overlaps(m_primitiveBoxes[i]))
+                {
+                    visitor(static_cast<std::size_t>(m_primitiveIndices[i]));
+                }
+            }
+        }
+        else
+        {
+            const std::uint32_t leftIndex = nodeIndex + 1;
+            const std::uint32_t rightIndex = node.first;
+            const bool leftOverlaps = overlaps(m_nodes[leftIndex].aaBox);
+            const bool rightOverlaps = overlaps(m_nodes[rightIndex].aaBox);
+            if (leftOverlaps && rightOverlaps)
+            {
+                stack[stackSize++] = rightIndex;
+                nodeIndex = leftIndex;
+                continue;
+            }
+            else if (leftOverlaps || rightOverlaps)
+            {
+                nodeIndex = (leftOverlaps ? leftIndex : rightIndex);
+                continue;
+            }
+        }
+
+        if (stackSize == 0)
+        {
+            break;
+        }
+        nodeIndex = stack[--stackSize];
+    }
+}
+
+template <typename T>
+Vector3G<T> BVHG<T>::GetInverseDirection(const RayG<T> &ray)
+{
+    const auto &direction = ray.GetDirection();
+    return Vector3G<T>(
+        T(1) / direction.x, T(1) / direction.y, T(1) / direction.z);
+}
+
+// Slab test with the precomputed inverse direction. Zero direction components
+// give infinite slab distances, or NaN when the origin is on a slab plane,
+// which is skipped explicitly. The distance is clamped to 0 when the origin
+// is inside the box.
+template <typename T>
+bool BVHG<T>::IntersectRayBox(const Vector3G<T> &origin,
+                              const Vector3G<T> &invDirection,
+                              const AABoxG<T> &aaBox,
+                              T maxDistance,
+                              T *nearDistance)
+{
+    const auto &bMin = aaBox.GetMin();
+    const auto &bMax = aaBox.GetMax();
+
+    T tNear = T(0);
+    T tFar = maxDistance;
+    for (int i = 0; i < 3; ++i)
+    {
+        const T t0 = (bMin[i] - origin[i]) * invDirection[i];
+        const T t1 = (bMax[i] - origin[i]) * invDirection[i];
+        // 0 * inf is NaN when the origin lies on a plane of the slab and the
+        // ray runs along it. The ray stays inside that slab then.
+        if (Math::IsNaN(t0) || Math::IsNaN(t1))
+        {
+            continue;
+        }
+        tNear = Math::Max(tNear, Math::Min(t0, t1));
+        tFar = Math::Min(tFar, Math::Max(t0, t1));
+    }
+
+    *nearDistance = tNear;
+    return (tNear <= tFar);
+}
+
+template <typename T>
+bool BVHG<T>::OverlapBoxBox(const AABoxG<T> &b0, const AABoxG<T> &b1)
+{
+    return (b0.GetMin().x <= b1.GetMax().x && b0.GetMax().x >= b1.GetMin().x &&
+            b0.GetMin().y <= b1.GetMax().y && b0.GetMax().y >= b1.GetMin().y &&
+            b0.GetMin().z <= b1.GetMax().z && b0.GetMax().z >= b1.GetMin().z);
+}
+
+template <typename T>
+bool BVHG<T>::OverlapSphereBox(const SphereG<T> &sphere,
+                               const AABoxG<T> &aaBox)
+{
+    const auto closestPoint = aaBox.GetClosestPointInAABB(sphere.GetCenter());
+    const auto sqDistance =
+        Vector3G<T>::SqDistance(closestPoint, sphere.GetCenter());
+    return (sqDistance <= sphere.GetRadius() * sphere.GetRadius());
+}
+
+template <typename T>
+void BVHG<T>::Grow(AABoxG<T> *aaBox, const AABoxG<T> &other)
+{
+    aaBox->SetMin(Vector3G<T>::Min(aaBox->GetMin(), other.GetMin()));
+    aaBox->SetMax(Vector3G<T>::Max(aaBox->GetMax(), other.GetMax()));
+}
+
+template <typename T>
+int BVHG<T>::GetBin(T value, T min, T binScale)
+{
+    const int bin = static_cast<int>((value - min) * binScale);
+    return Math::Clamp(bin, 0, NumBins - 1);
+}
+}
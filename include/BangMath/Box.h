@@ -1,12 +1,15 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 #include "BangMath/Defines.h"
 
 namespace Bang
 {
 template <typename>
+class AABoxG;
+template <typename>
 class QuadG;
 template <typename>
 class Matrix4G;
@@ -31,6 +34,29 @@ public:
     void SetOrientation(const QuaternionG<T> &orientation);
 
     bool Contains(const Vector3G<T> &point) const;
+
+    // Separating axis tests (15 axes)
+    bool Overlap(const BoxG<T> &box) const;
+    bool Overlap(const AABoxG<T> &aaBox) const;
+    // Batch versions against many boxes, writing one result per box. The
+    // AABox one tests four boxes at a time with SIMD.
+    void Overlap(const BoxG<T> *boxes,
+                 std::size_t count,
+                 bool *overlapsOut) const;
+    void Overlap(const AABoxG<T> *aaBoxes,
+                 std::size_t count,
+                 bool *overlapsOut) const;
+
+    Vector3G<T> GetClosestPoint(const Vector3G<T> &point) const;
+    T GetSqDistance(const Vector3G<T> &point) const;
+    T GetDistance(const Vector3G<T> &point) const;
+
+    // Point in box local space (relative to the center, along the axes)
+    Vector3G<T> ToLocalSpace(const Vector3G<T> &point) const;
+    Vector3G<T> ToLocalDirection(const Vector3G<T> &direction) const;
+
+    // Unit vectors of the box local X, Y and Z
+    std::array<Vector3G<T>, 3> GetAxes() const;
     Vector3G<T> GetExtentX() const;
     Vector3G<T> GetExtentY() const;
     Vector3G<T> GetExtentZ() const;
@@ -43,6 +69,10 @@ private:
     Vector3G<T> m_center;
     Vector3G<T> m_localExtents;
     QuaternionG<T> m_orientation;
+
+    bool Overlap(const Vector3G<T> &center,
+                 const std::array<Vector3G<T>, 3> &axes,
+                 const Vector3G<T> &extents) const;
 };
 
 BANG_MATH_DEFINE_USINGS(Box)
@@ -1,5 +1,10 @@
 #include "BangMath/Box.h"
 
+#include "BangMath/AABox.h"
+#include "BangMath/Geometry.h"
+#include "BangMath/Math.h"
+#include "BangMath/SIMD.h"
+
 namespace Bang
 {
 template <typename T>
@@ -23,16 +28,204 @@ void BoxG<T>::SetOrientation(const QuaternionG<T> &orientation)
 template <typename T>
 bool BoxG<T>::Contains(const Vector3G<T> &point) const
 {
-    const auto transform = Matrix4G<T>::RotateMatrix(-GetOrientation()) *
-                           Matrix4G<T>::TranslateMatrix(-GetCenter());
-    const auto localPoint = (transform * Vector4G<T>(point, 1)).xyz();
-
+    const auto localPoint = ToLocalSpace(point);
     const auto &lExt = GetLocalExtents();
     return (localPoint.x >= -lExt.x && localPoint.x <= lExt.x) &&
            (localPoint.y >= -lExt.y && localPoint.y <= lExt.y) &&
            (localPoint.z >= -lExt.z && localPoint.z <= lExt.z);
 }
 
+template <typename T>
+bool BoxG<T>::Overlap(const BoxG<T> &box) const
+{
+    return Overlap(box.GetCenter(), box.GetAxes(), box.GetLocalExtents());
+}
+
+template <typename T>
+bool BoxG<T>::Overlap(const AABoxG<T> &aaBox) const
+{
+    const auto extents = aaBox.GetExtents();
+    if (extents.x < 0 || extents.y < 0 || extents.z < 0)  // Empty
+    {
+        return false;
+    }
+
+    const std::array<Vector3G<T>, 3> axes = {{Vector3G<T>(1, 0, 0),
+                                              Vector3G<T>(0, 1, 0),
+                                              Vector3G<T>(0, 0, 1)}};
+    return Overlap(aaBox.GetCenter(), axes, extents);
+}
+
+template <typename T>
+void BoxG<T>::Overlap(const BoxG<T> *boxes,
+                      std::size_t count,
+                      bool *overlapsOut) const
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        overlapsOut[i] = Overlap(boxes[i]);
+    }
+}
+
+template <typename T>
+void BoxG<T>::Overlap(const AABoxG<T> *aaBoxes,
+                      std::size_t count,
+                      bool *overlapsOut) const
+{
+    // Same tests as Overlap(center, axes, extents) in this box frame. With
+    // world aligned boxes the rotation between both frames is the same for
+    // all of them, so only the distances and extents change per box.
+    using SIMD = SIMD4G<T>;
+    const auto axes = GetAxes();
+    const auto &ea = GetLocalExtents();
+    T absR[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            absR[i][j] = Math::Abs(axes[i][j]) + Geometry::Epsilon<T>();
+        }
+    }
+
+    for (std::size_t first = 0; first < count; first += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - first, std::size_t(4));
+        T dx[4] = {}, dy[4] = {}, dz[4] = {};
+        T ex[4] = {}, ey[4] = {}, ez[4] = {};
+        int emptyMask = 0;
+        for (std::size_t k = 0; k < blockCount; ++k)
+        {
+            const AABoxG<T> &aaBox = aaBoxes[first + k];
+            const auto e = aaBox.GetExtents();
+            if (e.x < 0 || e.y < 0 || e.z < 0)
+            {
+                emptyMask |= (1 << k);
+                continue;
+            }
+            const auto d = aaBox.GetCenter() - GetCenter();
+            dx[k] = d.x;
+            dy[k] = d.y;
+            dz[k] = d.z;
+            ex[k] = e.x;
+            ey[k] = e.y;
+            ez[k] = e.z;
+        }
+
+        const SIMD dWorld[3] = {SIMD::Load(dx), SIMD::Load(dy), SIMD::Load(dz)};
+        const SIMD eb[3] = {SIMD::Load(ex), SIMD::Load(ey), SIMD::Load(ez)};
+        SIMD d[3];
+        for (int i = 0; i < 3; ++i)
+        {
+            d[i] = dWorld[0] * SIMD(axes[i].x) + dWorld[1] * SIMD(axes[i].y) +
+                   dWorld[2] * SIMD(axes[i].z);
+        }
+        const auto abs = [](const SIMD &v) { return SIMD::Max(v, -v); };
+
+        int separatedMask = emptyMask;
+        for (int i = 0; i < 3; ++i)
+        {
+            // This box axes
+            const SIMD rb = eb[0] * SIMD(absR[i][0]) +
+                            eb[1] * SIMD(absR[i][1]) +
+                            eb[2] * SIMD(absR[i][2]);
+            separatedMask |= SIMD::LessMask(SIMD(ea[i]) + rb, abs(d[i]));
+
+            // World axes
+            const T ra = ea[0] * absR[0][i] + ea[1] * absR[1][i] +
+                         ea[2] * absR[2][i];
+            separatedMask |=
+                SIMD::LessMask(SIMD(ra) + eb[i], abs(dWorld[i]));
+        }
+
+        // Cross products of this box axes with the world axes
+        for (int i = 0; i < 3; ++i)
+        {
+            const int i1 = (i + 1) % 3;
+            const int i2 = (i + 2) % 3;
+            for (int j = 0; j < 3; ++j)
+            {
+                const int j1 = (j + 1) % 3;
+                const int j2 = (j + 2) % 3;
+                const T ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+                const SIMD rb =
+                    eb[j1] * SIMD(absR[i][j2]) + eb[j2] * SIMD(absR[i][j1]);
+                const SIMD dist = d[i2] * SIMD(axes[i1][j]) -
+                                  d[i1] * SIMD(axes[i2][j]);
+                separatedMask |= SIMD::LessMask(SIMD(ra) + rb, abs(dist));
+            }
+        }
+
+        for (std::size_t k = 0; k < blockCount; ++k)
+        {
+            overlapsOut[first + k] = (((separatedMask >> k) & 1) == 0);
+        }
+    }
+}
+
+template <typename T>
+Vector3G<T> BoxG<T>::GetClosestPoint(const Vector3G<T> &point) const
+{
+    const auto axes = GetAxes();
+    const auto &lExt = GetLocalExtents();
+    const auto d = point - GetCenter();
+    Vector3G<T> closestPoint = GetCenter();
+    for (int i = 0; i < 3; ++i)
+    {
+        const T dist = Math::Clamp(
+            Vector3G<T>::Dot(d, axes[i]), -lExt[i], lExt[i]);
+        closestPoint += axes[i] * dist;
+    }
+    return closestPoint;
+}
+
+template <typename T>
+T BoxG<T>::GetSqDistance(const Vector3G<T> &point) const
+{
+    const auto localPoint = ToLocalSpace(point);
+    const auto &lExt = GetLocalExtents();
+    T sqDistance = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        const T excess = Math::Abs(localPoint[i]) - lExt[i];
+        if (excess > 0)
+        {
+            sqDistance += excess * excess;
+        }
+    }
+    return sqDistance;
+}
+
+template <typename T>
+T BoxG<T>::GetDistance(const Vector3G<T> &point) const
+{
+    return Math::Sqrt(GetSqDistance(point));
+}
+
+template <typename T>
+Vector3G<T> BoxG<T>::ToLocalSpace(const Vector3G<T> &point) const
+{
+    return ToLocalDirection(point - GetCenter());
+}
+
+template <typename T>
+Vector3G<T> BoxG<T>::ToLocalDirection(const Vector3G<T> &direction) const
+{
+    const auto axes = GetAxes();
+    return Vector3G<T>(Vector3G<T>::Dot(direction, axes[0]),
+                       Vector3G<T>::Dot(direction, axes[1]),
+                       Vector3G<T>::Dot(direction, axes[2]));
+}
+
+template <typename T>
+std::array<Vector3G<T>, 3> BoxG<T>::GetAxes() const
+{
+    const std::array<Vector3G<T>, 3> axes = {
+        {GetOrientation() * Vector3G<T>::Right(),
+         GetOrientation() * Vector3G<T>::Up(),
+         GetOrientation() * Vector3G<T>::Forward()}};
+    return axes;
+}
+
 template <typename T>
 Vector3G<T> BoxG<T>::GetExtentX() const
 {
@@ -93,4 +286,72 @@ const QuaternionG<T> &BoxG<T>::GetOrientation() const
 {
     return m_orientation;
 }
+
+template <typename T>
+bool BoxG<T>::Overlap(const Vector3G<T> &center,
+                      const std::array<Vector3G<T>, 3> &axes,
+                      const Vector3G<T> &extents) const
+{
+    // Gottschalk's OBB test, everything expressed in this box frame. The
+    // epsilon in absR avoids false separations from the (null) cross
+    // products of parallel edges.
+    const auto myAxes = GetAxes();
+    const auto &ea = GetLocalExtents();
+    const auto &eb = extents;
+    const auto dWorld = center - GetCenter();
+
+    T d[3], R[3][3], absR[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        d[i] = Vector3G<T>::Dot(dWorld, myAxes[i]);
+        for (int j = 0; j < 3; ++j)
+        {
+            R[i][j] = Vector3G<T>::Dot(myAxes[i], axes[j]);
+            absR[i][j] = Math::Abs(R[i][j]) + Geometry::Epsilon<T>();
+        }
+    }
+
+    // This box axes
+    for (int i = 0; i < 3; ++i)
+    {
+        const T rb = eb[0] * absR[i][0] + eb[1] * absR[i][1] +
+                     eb[2] * absR[i][2];
+        if (Math::Abs(d[i]) > ea[i] + rb)
+        {
+            return false;
+        }
+    }
+
+    // Other box axes
+    for (int j = 0; j < 3; ++j)
+    {
+        const T ra = ea[0] * absR[0][j] + ea[1] * absR[1][j] +
+                     ea[2] * absR[2][j];
+        const T dist = d[0] * R[0][j] + d[1] * R[1][j] + d[2] * R[2][j];
+        if (Math::Abs(dist) > ra + eb[j])
+        {
+            return false;
+        }
+    }
+
+    // Cross products of both boxes axes
+    for (int i = 0; i < 3; ++i)
+    {
+        const int i1 = (i + 1) % 3;
+        const int i2 = (i + 2) % 3;
+        for (int j = 0; j < 3; ++j)
+        {
+            const int j1 = (j + 1) % 3;
+            const int j2 = (j + 2) % 3;
+            const T ra = ea[i1] * absR[i2][j] + ea[i2] * absR[i1][j];
+            const T rb = eb[j1] * absR[i][j2] + eb[j2] * absR[i][j1];
+            const T dist = d[i2] * R[i1][j] - d[i1] * R[i2][j];
+            if (Math::Abs(dist) > ra + rb)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
 }
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+// Contact points between two shapes sharing a normal, stored in place with
+// a fixed capacity so that narrow phase queries never allocate. The normal
+// points from the first shape of the query towards the second one.
+template <typename T>
+class ContactManifoldG
+{
+public:
+    // Enough for a quad clipped against another quad
+    static constexpr std::size_t MaxPoints = 8;
+
+    struct Point
+    {
+        // Midpoint between the two surfaces
+        Vector3G<T> position;
+        // Depth along the normal, positive when penetrating
+        T penetration;
+    };
+
+    ContactManifoldG() = default;
+
+    void Clear();
+    void SetNormal(const Vector3G<T> &normal);
+    // Returns false (and ignores the point) when the manifold is full
+    bool AddPoint(const Vector3G<T> &position, T penetration);
+
+    bool IsEmpty() const;
+    bool IsFull() const;
+    const Vector3G<T> &GetNormal() const;
+    std::size_t GetNumPoints() const;
+    const Point &GetPoint(std::size_t i) const;
+    // Maximum penetration of all the points, 0 if empty
+    T GetMaxPenetration() const;
+
+private:
+    Vector3G<T> m_normal = Vector3G<T>::Zero();
+    std::array<Point, MaxPoints> m_points;
+    std::size_t m_numPoints = 0;
+};
+
+BANG_MATH_DEFINE_USINGS(ContactManifold)
+}
+
+#include "BangMath/ContactManifold.tcc"
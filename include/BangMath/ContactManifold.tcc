@@ -0,0 +1,75 @@
+#include "BangMath/ContactManifold.h"
+
+#include "BangMath/Math.h"
+
+namespace Bang
+{
+template <typename T>
+void ContactManifoldG<T>::Clear()
+{
+    m_normal = Vector3G<T>::Zero();
+    m_numPoints = 0;
+}
+
+template <typename T>
+void ContactManifoldG<T>::SetNormal(const Vector3G<T> &normal)
+{
+    m_normal = normal;
+}
+
+template <typename T>
+bool ContactManifoldG<T>::AddPoint(const Vector3G<T> &position, T penetration)
+{
+    if (IsFull())
+    {
+        return false;
+    }
+
+    Point &point = m_points[m_numPoints++];
+    point.position = position;
+    point.penetration = penetration;
+    return true;
+}
+
+template <typename T>
+bool ContactManifoldG<T>::IsEmpty() const
+{
+    return (m_numPoints == 0);
+}
+
+template <typename T>
+bool ContactManifoldG<T>::IsFull() const
+{
+    return (m_numPoints == MaxPoints);
+}
+
+template <typename T>
+const Vector3G<T> &ContactManifoldG<T>::GetNormal() const
+{
+    return m_normal;
+}
+
+template <typename T>
+std::size_t ContactManifoldG<T>::GetNumPoints() const
+{
+    return m_numPoints;
+}
+
+template <typename T>
+const typename ContactManifoldG<T>::Point &ContactManifoldG<T>::GetPoint(
+    std::size_t i) const
+{
+    return m_points[i];
+}
+
+template <typename T>
+T ContactManifoldG<T>::GetMaxPenetration() const
+{
+    T maxPenetration = static_cast<T>(0);
+    for (std::size_t i = 0; i < m_numPoints; ++i)
+    {
+        maxPenetration = Math::Max(maxPenetration, m_points[i].penetration);
+    }
+    return maxPenetration;
+}
+}
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename>
+class PolygonG;
+template <typename>
+class TriangleG;
+
+// Convex hull of a 3D point set, by quickhull. Starting from a tetrahedron
+// of extreme points, every face keeps the points outside it, and the
+// farthest one of a face is added by replacing the faces it sees with a fan
+// from it to their horizon. Points within a tolerance scaled to the
+// coordinates are treated as inside, so near coplanar points do not create
+// slivers. Afterwards, adjacent triangles that are coplanar within the
+// rounding error of the input are merged into polygonal faces.
+//
+// Faces are counterclockwise seen from outside, as indices into the built
+// points. Sets that are collinear or coplanar give an empty hull.
+//
+// Reusing the same object keeps its buffers' memory between builds, and the
+// batch Build reuses the hulls of the output vector.
+template <typename T>
+class ConvexHullG
+{
+public:
+    ConvexHullG() = default;
+
+    void Build(const std::vector<Vector3G<T>> &points);
+    void Build(const Vector3G<T> *points, std::size_t count);
+
+    // Builds the hull of every point set into (*hullsOut)[i]. The sets are
+    // picked in order by numThreads threads, 0 using as many as the hardware
+    // supports.
+    static void Build(const std::vector<std::vector<Vector3G<T>>> &pointSets,
+                      std::vector<ConvexHullG<T>> *hullsOut,
+                      std::size_t numThreads = 1);
+
+    // Indices of the points on the hull, sorted
+    const std::vector<std::uint32_t> &GetVertexIndices() const;
+
+    // Vertices of face i, from GetFaceStarts()[i] to GetFaceStarts()[i + 1]
+    const std::vector<std::uint32_t> &GetFaceIndices() const;
+    const std::vector<std::uint32_t> &GetFaceStarts() const;
+    std::size_t GetFaceCount() const;
+
+    // Three indices per triangle, covering the same faces
+    const std::vector<std::uint32_t> &GetTriangleIndices() const;
+
+    void GetPolygons(std::vector<PolygonG<T>> *polygonsOut) const;
+    void GetTriangles(std::vector<TriangleG<T>> *trianglesOut) const;
+
+    // Distance within which points are treated as inside while building
+    T GetTolerance() const;
+    bool IsEmpty() const;
+
+private:
+    // Hulls are built in at least double precision. In float, the planes
+    // of the thin triangles that each new point fans to are too noisy for
+    // the tolerance, and the hull ends up concave.
+    using Real = typename std::common_type<T, double>::type;
+
+    struct Face
+    {
+        Vector3G<Real> normal;
+        Real offset;
+        std::uint32_t vertices[3];
+        // Face across the edge from vertices[i] to vertices[(i + 1) % 3]
+        std::uint32_t neighbours[3];
+        // Points outside the face, linked through m_outsideNext
+        int outsideHead;
+        int farthestPoint;
+        Real farthestDistance;
+        std::uint32_t visitMark;
+        bool removed;
+    };
+
+    // Edge of a visible face whose neighbour is not visible
+    struct HorizonEdge
+    {
+        std::uint32_t face;
+        std::uint32_t edge;
+        std::uint32_t neighbour;
+        std::uint32_t neighbourEdge;
+    };
+
+    // Visible face whose edges are being walked to find the horizon
+    struct HorizonStep
+    {
+        std::uint32_t face;
+        std::uint32_t firstEdge;
+        std::uint32_t numEdges;
+    };
+
+    std::vector<Vector3G<Real>> m_points;
+    Real m_tolerance = Real(0);
+    // Coplanarity tolerance of the merged faces, scaled to the epsilon of T
+    // instead, as rounding the input to T moves points off their planes
+    Real m_mergeTolerance = Real(0);
+
+    std::vector<Face> m_faces;
+    std::vector<std::uint32_t> m_freeFaces;
+    std::vector<int> m_outsideNext;
+    std::vector<std::uint32_t> m_pendingFaces;
+    std::vector<std::uint32_t> m_visibleFaces;
+    std::vector<std::uint32_t> m_newFaces;
+    std::vector<HorizonEdge> m_horizon;
+    std::vector<HorizonStep> m_horizonSteps;
+    std::uint32_t m_visitMark = 0;
+
+    // Coplanar face group, as a union find node. Its members are linked in
+    // a ring, and every vertex of them is within the merge tolerance of the
+    // plane of planeFace.
+    struct FaceGroup
+    {
+        std::uint32_t parent;
+        std::uint32_t next;
+        // Only kept up to date for roots
+        std::uint32_t size;
+        std::uint32_t planeFace;
+        Real planeSqArea;
+    };
+
+    // Face groups, and their boundary edges sorted by group and first vertex
+    std::vector<FaceGroup> m_faceGroups;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> m_boundaryEdges;
+
+    std::vector<std::uint32_t> m_vertexIndices;
+    std::vector<std::uint32_t> m_faceIndices;
+    std::vector<std::uint32_t> m_faceStarts;
+    std::vector<std::uint32_t> m_triangleIndices;
+
+    void Clear();
+    bool BuildInitialSimplex();
+    void AddPoint(int eye, std::uint32_t eyeFace);
+    void FindHorizon(int eye, std::uint32_t eyeFace);
+    std::uint32_t AddFace(std::uint32_t a, std::uint32_t b, std::uint32_t c);
+    void AddOutsidePoint(std::uint32_t face, int point, Real distance);
+    // Adds the point to the face of faces it is farthest outside of, if any
+    void AssignPoint(int point, const std::vector<std::uint32_t> &faces);
+    Real GetDistance(const Face &face, const Vector3G<Real> &point) const;
+    void FillOutput();
+    std::uint32_t FindGroup(std::uint32_t face);
+    // Merges the smaller group into the other one if all its vertices are
+    // within the merge tolerance of the plane of the other one
+    void MergeGroups(std::uint32_t group0, std::uint32_t group1);
+};
+
+BANG_MATH_DEFINE_USINGS(ConvexHull)
+}
+
+#include "BangMath/ConvexHull.tcc"
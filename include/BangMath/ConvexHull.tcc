@@ -0,0 +1,637 @@
+#include "BangMath/ConvexHull.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "BangMath/Math.h"
+#include "BangMath/Parallel.h"
+#include "BangMath/Polygon.h"
+#include "BangMath/Triangle.h"
+
+namespace Bang
+{
+template <typename T>
+void ConvexHullG<T>::Build(const std::vector<Vector3G<T>> &points)
+{
+    Build(points.data(), points.size());
+}
+
+template <typename T>
+void ConvexHullG<T>::Build(const Vector3G<T> *points, std::size_t count)
+{
+    Clear();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_points.emplace_back(points[i]);
+    }
+    if (!BuildInitialSimplex())
+    {
+        return;
+    }
+
+    while (!m_pendingFaces.empty())
+    {
+        const std::uint32_t face = m_pendingFaces.back();
+        m_pendingFaces.pop_back();
+        if (!m_faces[face].removed && m_faces[face].outsideHead >= 0)
+        {
+            AddPoint(m_faces[face].farthestPoint, face);
+        }
+    }
+    FillOutput();
+}
+
+template <typename T>
+void ConvexHullG<T>::Build(
+    const std::vector<std::vector<Vector3G<T>>> &pointSets,
+    std::vector<ConvexHullG<T>> *hullsOut,
+    std::size_t numThreads)
+{
+    const std::size_t count = pointSets.size();
+    hullsOut->resize(count);
+    Parallel::ForTiles(
+        count, 1, numThreads, [&](std::size_t i, std::size_t, std::size_t) {
+            (*hullsOut)[i].Build(pointSets[i]);
+        });
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &ConvexHullG<T>::GetVertexIndices() const
+{
+    return m_vertexIndices;
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &ConvexHullG<T>::GetFaceIndices() const
+{
+    return m_faceIndices;
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &ConvexHullG<T>::GetFaceStarts() const
+{
+    return m_faceStarts;
+}
+
+template <typename T>
+std::size_t ConvexHullG<T>::GetFaceCount() const
+{
+    return (m_faceStarts.empty() ? 0 : m_faceStarts.size() - 1);
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &ConvexHullG<T>::GetTriangleIndices() const
+{
+    return m_triangleIndices;
+}
+
+template <typename T>
+void ConvexHullG<T>::GetPolygons(std::vector<PolygonG<T>> *polygonsOut) const
+{
+    polygonsOut->clear();
+    for (std::size_t i = 0; i < GetFaceCount(); ++i)
+    {
+        polygonsOut->emplace_back();
+        for (std::uint32_t j = m_faceStarts[i]; j < m_faceStarts[i + 1]; ++j)
+        {
+            polygonsOut->back().AddPoint(
+                Vector3G<T>(m_points[m_faceIndices[j]]));
+        }
+    }
+}
+
+template <typename T>
+void ConvexHullG<T>::GetTriangles(std::vector<TriangleG<T>> *trianglesOut) const
+{
+    trianglesOut->clear();
+    for (std::size_t i = 0; i < m_triangleIndices.size(); i += 3)
+    {
+        trianglesOut->emplace_back(
+            Vector3G<T>(m_points[m_triangleIndices[i]]),
+            Vector3G<T>(m_points[m_triangleIndices[i + 1]]),
+            Vector3G<T>(m_points[m_triangleIndices[i + 2]]));
+    }
+}
+
+template <typename T>
+T ConvexHullG<T>::GetTolerance() const
+{
+    return static_cast<T>(m_tolerance);
+}
+
+template <typename T>
+bool ConvexHullG<T>::IsEmpty() const
+{
+    return m_faceStarts.empty();
+}
+
+template <typename T>
+void ConvexHullG<T>::Clear()
+{
+    m_points.clear();
+    m_faces.clear();
+    m_freeFaces.clear();
+    m_pendingFaces.clear();
+    m_vertexIndices.clear();
+    m_faceIndices.clear();
+    m_faceStarts.clear();
+    m_triangleIndices.clear();
+    m_tolerance = Real(0);
+    m_mergeTolerance = Real(0);
+}
+
+// Tetrahedron from the two points farthest apart along an axis, the point
+// farthest from their line and the point farthest from the plane of the
+// three. Every other point is then assigned to a face it is outside of.
+template <typename T>
+bool ConvexHullG<T>::BuildInitialSimplex()
+{
+    const std::size_t count = m_points.size();
+    if (count < 4)
+    {
+        return false;
+    }
+
+    std::uint32_t minIndices[3] = {0, 0, 0};
+    std::uint32_t maxIndices[3] = {0, 0, 0};
+    Vector3G<Real> maxAbs = Vector3G<Real>::Zero();
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const Vector3G<Real> &point = m_points[i];
+        maxAbs = Vector3G<Real>::Max(maxAbs, point.Abs());
+        for (std::size_t axis = 0; axis < 3; ++axis)
+        {
+            if (point[axis] < m_points[minIndices[axis]][axis])
+            {
+                minIndices[axis] = i;
+            }
+            if (point[axis] > m_points[maxIndices[axis]][axis])
+            {
+                maxIndices[axis] = i;
+            }
+        }
+    }
+    const Real sumAbs = maxAbs.x + maxAbs.y + maxAbs.z;
+    m_tolerance = Real(3) * std::numeric_limits<Real>::epsilon() * sumAbs;
+    m_mergeTolerance =
+        Real(3) * Real(std::numeric_limits<T>::epsilon()) * sumAbs;
+
+    std::size_t widestAxis = 0;
+    for (std::size_t axis = 1; axis < 3; ++axis)
+    {
+        const Real span = m_points[maxIndices[axis]][axis] -
+                       m_points[minIndices[axis]][axis];
+        const Real widestSpan = m_points[maxIndices[widestAxis]][widestAxis] -
+                             m_points[minIndices[widestAxis]][widestAxis];
+        if (span > widestSpan)
+        {
+            widestAxis = axis;
+        }
+    }
+    std::uint32_t v0 = minIndices[widestAxis];
+    std::uint32_t v1 = maxIndices[widestAxis];
+    const Vector3G<Real> p0 = m_points[v0];
+    const Vector3G<Real> lineDir = (m_points[v1] - p0).NormalizedSafe();
+    if (Vector3G<Real>::Distance(p0, m_points[v1]) <= m_tolerance)
+    {
+        return false;
+    }
+
+    std::uint32_t v2 = v0;
+    Real maxLineDistance = Real(0);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const Real distance =
+            Vector3G<Real>::Cross(m_points[i] - p0, lineDir).Length();
+        if (distance > maxLineDistance)
+        {
+            maxLineDistance = distance;
+            v2 = i;
+        }
+    }
+    if (maxLineDistance <= m_tolerance)
+    {
+        return false;
+    }
+
+    const Vector3G<Real> planeNormal =
+        Vector3G<Real>::Cross(m_points[v1] - p0, m_points[v2] - p0)
+            .NormalizedSafe();
+    std::uint32_t v3 = v0;
+    Real maxPlaneDistance = Real(0);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const Real distance =
+            Vector3G<Real>::Dot(m_points[i] - p0, planeNormal);
+        if (Math::Abs(distance) > Math::Abs(maxPlaneDistance))
+        {
+            maxPlaneDistance = distance;
+            v3 = i;
+        }
+    }
+    if (Math::Abs(maxPlaneDistance) <= m_tolerance)
+    {
+        return false;
+    }
+
+    // Base v0 v1 v2 facing away from v3
+    if (maxPlaneDistance > 0)
+    {
+        std::swap(v1, v2);
+    }
+    const std::uint32_t faces[4] = {AddFace(v0, v1, v2),
+                                    AddFace(v0, v3, v1),
+                                    AddFace(v1, v3, v2),
+                                    AddFace(v2, v3, v0)};
+    for (std::uint32_t face : faces)
+    {
+        for (std::uint32_t edge = 0; edge < 3; ++edge)
+        {
+            const std::uint32_t from = m_faces[face].vertices[edge];
+            const std::uint32_t to = m_faces[face].vertices[(edge + 1) % 3];
+            for (std::uint32_t other : faces)
+            {
+                const std::uint32_t *vertices = m_faces[other].vertices;
+                for (std::uint32_t otherEdge = 0; otherEdge < 3; ++otherEdge)
+                {
+                    if (vertices[otherEdge] == to &&
+                        vertices[(otherEdge + 1) % 3] == from)
+                    {
+                        m_faces[face].neighbours[edge] = other;
+                    }
+                }
+            }
+        }
+    }
+
+    m_outsideNext.assign(count, -1);
+    m_newFaces.assign(faces, faces + 4);
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (i != v0 && i != v1 && i != v2 && i != v3)
+        {
+            AssignPoint(static_cast<int>(i), m_newFaces);
+        }
+    }
+    m_pendingFaces.assign(faces, faces + 4);
+    return true;
+}
+
+// Replaces the faces the eye sees by a fan from it to their horizon, and
+// hands their outside points to the new faces
+template <typename T>
+void ConvexHullG<T>::AddPoint(int eye, std::uint32_t eyeFace)
+{
+    FindHorizon(eye, eyeFace);
+
+    m_newFaces.clear();
+    const std::uint32_t eyeIndex = static_cast<std::uint32_t>(eye);
+    for (const HorizonEdge &horizonEdge : m_horizon)
+    {
+        const Face &face = m_faces[horizonEdge.face];
+        const std::uint32_t from = face.vertices[horizonEdge.edge];
+        const std::uint32_t to = face.vertices[(horizonEdge.edge + 1) % 3];
+        const std::uint32_t newFace = AddFace(from, to, eyeIndex);
+        m_faces[newFace].neighbours[0] = horizonEdge.neighbour;
+        m_faces[horizonEdge.neighbour].neighbours[horizonEdge.neighbourEdge] =
+            newFace;
+        m_newFaces.push_back(newFace);
+    }
+
+    // The horizon is a loop, so each new face shares its edges towards the
+    // eye with the next and previous ones
+    const std::size_t numNewFaces = m_newFaces.size();
+    for (std::size_t i = 0; i < numNewFaces; ++i)
+    {
+        Face &face = m_faces[m_newFaces[i]];
+        face.neighbours[1] = m_newFaces[(i + 1) % numNewFaces];
+        face.neighbours[2] = m_newFaces[(i + numNewFaces - 1) % numNewFaces];
+    }
+
+    for (std::uint32_t visibleFace : m_visibleFaces)
+    {
+        int point = m_faces[visibleFace].outsideHead;
+        while (point >= 0)
+        {
+            const int next = m_outsideNext[point];
+            if (point != eye)
+            {
+                AssignPoint(point, m_newFaces);
+            }
+            point = next;
+        }
+        m_faces[visibleFace].removed = true;
+        m_freeFaces.push_back(visibleFace);
+    }
+
+    for (std::uint32_t newFace : m_newFaces)
+    {
+        if (m_faces[newFace].outsideHead >= 0)
+        {
+            m_pendingFaces.push_back(newFace);
+        }
+    }
+}
+
+// Depth first walk of the faces the eye sees, crossing their edges in
+// order, so the horizon edges are found as a counterclockwise loop
+template <typename T>
+void ConvexHullG<T>::FindHorizon(int eye, std::uint32_t eyeFace)
+{
+    const Vector3G<Real> &eyePoint = m_points[eye];
+    ++m_visitMark;
+    m_horizon.clear();
+    m_visibleFaces.clear();
+    m_horizonSteps.clear();
+
+    m_faces[eyeFace].visitMark = m_visitMark;
+    m_visibleFaces.push_back(eyeFace);
+    m_horizonSteps.push_back({eyeFace, 0, 3});
+    while (!m_horizonSteps.empty())
+    {
+        HorizonStep &step = m_horizonSteps.back();
+        if (step.numEdges == 0)
+        {
+            m_horizonSteps.pop_back();
+            continue;
+        }
+
+        const std::uint32_t face = step.face;
+        const std::uint32_t edge = step.firstEdge;
+        step.firstEdge = (step.firstEdge + 1) % 3;
+        --step.numEdges;
+
+        const std::uint32_t neighbour = m_faces[face].neighbours[edge];
+        Face &neighbourFace = m_faces[neighbour];
+        if (neighbourFace.visitMark == m_visitMark)
+        {
+            continue;
+        }
+
+        std::uint32_t neighbourEdge = 0;
+        while (neighbourFace.neighbours[neighbourEdge] != face)
+        {
+            ++neighbourEdge;
+        }
+        if (GetDistance(neighbourFace, eyePoint) > m_tolerance)
+        {
+            // Walk its other edges, starting after the one just crossed
+            neighbourFace.visitMark = m_visitMark;
+            m_visibleFaces.push_back(neighbour);
+            m_horizonSteps.push_back({neighbour, (neighbourEdge + 1) % 3, 2});
+        }
+        else
+        {
+            m_horizon.push_back({face, edge, neighbour, neighbourEdge});
+        }
+    }
+}
+
+template <typename T>
+std::uint32_t ConvexHullG<T>::AddFace(std::uint32_t a,
+                                      std::uint32_t b,
+                                      std::uint32_t c)
+{
+    std::uint32_t faceIndex;
+    if (m_freeFaces.empty())
+    {
+        faceIndex = static_cast<std::uint32_t>(m_faces.size());
+        m_faces.emplace_back();
+    }
+    else
+    {
+        faceIndex = m_freeFaces.back();
+        m_freeFaces.pop_back();
+    }
+
+    Face &face = m_faces[faceIndex];
+    const Vector3G<Real> &pa = m_points[a];
+    face.normal = Vector3G<Real>::Cross(m_points[b] - pa, m_points[c] - pa)
+                      .NormalizedSafe();
+    face.offset = Vector3G<Real>::Dot(face.normal, pa);
+    face.vertices[0] = a;
+    face.vertices[1] = b;
+    face.vertices[2] = c;
+    face.outsideHead = -1;
+    face.farthestPoint = -1;
+    face.farthestDistance = Real(0);
+    face.visitMark = 0;
+    face.removed = false;
+    return faceIndex;
+}
+
+template <typename T>
+void ConvexHullG<T>::AddOutsidePoint(std::uint32_t faceIndex,
+                                     int point,
+                                     Real distance)
+{
+    Face &face = m_faces[faceIndex];
+    m_outsideNext[point] = face.outsideHead;
+    face.outsideHead = point;
+    if (face.farthestPoint < 0 || distance > face.farthestDistance)
+    {
+        face.farthestPoint = point;
+        face.farthestDistance = distance;
+    }
+}
+
+template <typename T>
+void ConvexHullG<T>::AssignPoint(int point,
+                                 const std::vector<std::uint32_t> &faces)
+{
+    const Vector3G<Real> &position = m_points[point];
+    Real maxDistance = m_tolerance;
+    std::uint32_t bestFace = 0;
+    bool found = false;
+    for (std::uint32_t face : faces)
+    {
+        const Real distance = GetDistance(m_faces[face], position);
+        if (distance > maxDistance)
+        {
+            maxDistance = distance;
+            bestFace = face;
+            found = true;
+        }
+    }
+    if (found)
+    {
+        AddOutsidePoint(bestFace, point, maxDistance);
+    }
+}
+
+template <typename T>
+typename ConvexHullG<T>::Real ConvexHullG<T>::GetDistance(
+    const Face &face,
+    const Vector3G<Real> &point) const
+{
+    return Vector3G<Real>::Dot(face.normal, point) - face.offset;
+}
+
+// Groups the triangles with their neighbours while the groups stay flat
+// within the merge tolerance, and walks the boundary of each group
+template <typename T>
+void ConvexHullG<T>::FillOutput()
+{
+    const std::uint32_t numFaces = static_cast<std::uint32_t>(m_faces.size());
+    m_faceGroups.resize(numFaces);
+    for (std::uint32_t face = 0; face < numFaces; ++face)
+    {
+        const Face &f = m_faces[face];
+        FaceGroup &group = m_faceGroups[face];
+        group.parent = face;
+        group.next = face;
+        group.size = 1;
+        group.planeFace = face;
+        group.planeSqArea =
+            Vector3G<Real>::Cross(m_points[f.vertices[1]] -
+                                      m_points[f.vertices[0]],
+                                  m_points[f.vertices[2]] -
+                                      m_points[f.vertices[0]])
+                .SqLength();
+    }
+
+    for (std::uint32_t face = 0; face < numFaces; ++face)
+    {
+        const Face &f = m_faces[face];
+        if (f.removed)
+        {
+            continue;
+        }
+
+        for (std::uint32_t i = 0; i < 3; ++i)
+        {
+            m_triangleIndices.push_back(f.vertices[i]);
+
+            const std::uint32_t neighbour = f.neighbours[i];
+            if (neighbour < face)
+            {
+                continue;
+            }
+            MergeGroups(FindGroup(face), FindGroup(neighbour));
+        }
+    }
+
+    // Boundary edges keyed by group and first vertex, to find the edge that
+    // follows each one around its group
+    m_boundaryEdges.clear();
+    for (std::uint32_t face = 0; face < numFaces; ++face)
+    {
+        const Face &f = m_faces[face];
+        if (f.removed)
+        {
+            continue;
+        }
+
+        const std::uint64_t group = FindGroup(face);
+        for (std::uint32_t i = 0; i < 3; ++i)
+        {
+            if (FindGroup(f.neighbours[i]) != group)
+            {
+                m_boundaryEdges.emplace_back((group << 32) | f.vertices[i],
+                                             f.vertices[(i + 1) % 3]);
+            }
+        }
+    }
+    std::sort(m_boundaryEdges.begin(), m_boundaryEdges.end());
+
+    for (std::size_t begin = 0; begin < m_boundaryEdges.size();)
+    {
+        const std::uint64_t group = m_boundaryEdges[begin].first >> 32;
+        std::size_t end = begin + 1;
+        while (end < m_boundaryEdges.size() &&
+               (m_boundaryEdges[end].first >> 32) == group)
+        {
+            ++end;
+        }
+
+        m_faceStarts.push_back(
+            static_cast<std::uint32_t>(m_faceIndices.size()));
+        const auto first = m_boundaryEdges.begin() + begin;
+        const auto last = m_boundaryEdges.begin() + end;
+        auto edge = first;
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            m_faceIndices.push_back(
+                static_cast<std::uint32_t>(edge->first & 0xFFFFFFFFu));
+            const std::uint64_t nextKey = (group << 32) | edge->second;
+            edge = std::lower_bound(
+                first,
+                last,
+                std::make_pair(nextKey, std::uint32_t(0)));
+            if (edge == last || edge->first != nextKey || edge == first)
+            {
+                break;
+            }
+        }
+        begin = end;
+    }
+    if (!m_faceStarts.empty())
+    {
+        m_faceStarts.push_back(
+            static_cast<std::uint32_t>(m_faceIndices.size()));
+    }
+
+    m_vertexIndices = m_faceIndices;
+    std::sort(m_vertexIndices.begin(), m_vertexIndices.end());
+    m_vertexIndices.erase(
+        std::unique(m_vertexIndices.begin(), m_vertexIndices.end()),
+        m_vertexIndices.end());
+}
+
+template <typename T>
+std::uint32_t ConvexHullG<T>::FindGroup(std::uint32_t face)
+{
+    while (m_faceGroups[face].parent != face)
+    {
+        m_faceGroups[face].parent =
+            m_faceGroups[m_faceGroups[face].parent].parent;
+        face = m_faceGroups[face].parent;
+    }
+    return face;
+}
+
+// Checking every vertex against the plane of the group, and not only the
+// neighbouring triangles against each other, keeps the faces flat: a sliver
+// along an edge of the hull is close to the planes of both sides, and would
+// otherwise chain them into one group. The smaller group is the one checked
+// and moved, so every face is moved O(log n) times. On ties the plane kept
+// is the one of the larger triangle, as slivers have noisy planes.
+template <typename T>
+void ConvexHullG<T>::MergeGroups(std::uint32_t group0, std::uint32_t group1)
+{
+    if (group0 == group1)
+    {
+        return;
+    }
+
+    const FaceGroup &g0 = m_faceGroups[group0];
+    const FaceGroup &g1 = m_faceGroups[group1];
+    if (g0.size > g1.size ||
+        (g0.size == g1.size && g0.planeSqArea > g1.planeSqArea))
+    {
+        std::swap(group0, group1);
+    }
+
+    FaceGroup &small = m_faceGroups[group0];
+    FaceGroup &large = m_faceGroups[group1];
+    const Face &plane = m_faces[large.planeFace];
+    std::uint32_t member = group0;
+    do
+    {
+        for (std::uint32_t vertex : m_faces[member].vertices)
+        {
+            if (Math::Abs(GetDistance(plane, m_points[vertex])) >
+                m_mergeTolerance)
+            {
+                return;
+            }
+        }
+        member = m_faceGroups[member].next;
+    } while (member != group0);
+
+    // Splice the rings and attach the small root
+    std::swap(small.next, large.next);
+    small.parent = group1;
+    large.size += small.size;
+}
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector2.h"
+
+namespace Bang
+{
+template <typename>
+class Polygon2DG;
+
+// Convex hull of a 2D point set, by Andrew's monotone chain: the points are
+// sorted by x and y, and the lower and upper chains are built keeping only
+// left turns. O(N log N). Collinear points on the hull edges are dropped.
+//
+// The hull is given counterclockwise, as indices into the built points.
+// Reusing the same object keeps its buffers' memory between builds.
+template <typename T>
+class ConvexHull2DG
+{
+public:
+    ConvexHull2DG() = default;
+
+    void Build(const std::vector<Vector2G<T>> &points);
+    void Build(const Vector2G<T> *points, std::size_t count);
+
+    const std::vector<std::uint32_t> &GetIndices() const;
+    Polygon2DG<T> GetPolygon() const;
+    bool IsEmpty() const;
+
+private:
+    std::vector<Vector2G<T>> m_points;
+    std::vector<std::uint32_t> m_sortedIndices;
+    std::vector<std::uint32_t> m_indices;
+};
+
+BANG_MATH_DEFINE_USINGS(ConvexHull2D)
+}
+
+#include "BangMath/ConvexHull2D.tcc"
@@ -0,0 +1,101 @@
+#include "BangMath/ConvexHull2D.h"
+
+#include <algorithm>
+
+#include "BangMath/Polygon2D.h"
+
+namespace Bang
+{
+template <typename T>
+void ConvexHull2DG<T>::Build(const std::vector<Vector2G<T>> &points)
+{
+    Build(points.data(), points.size());
+}
+
+template <typename T>
+void ConvexHull2DG<T>::Build(const Vector2G<T> *points, std::size_t count)
+{
+    m_points.assign(points, points + count);
+    m_sortedIndices.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_sortedIndices[i] = static_cast<std::uint32_t>(i);
+    }
+    std::sort(m_sortedIndices.begin(),
+              m_sortedIndices.end(),
+              [points](std::uint32_t a, std::uint32_t b) {
+                  return (points[a].x < points[b].x) ||
+                         (points[a].x == points[b].x &&
+                          points[a].y < points[b].y);
+              });
+    m_sortedIndices.erase(
+        std::unique(m_sortedIndices.begin(),
+                    m_sortedIndices.end(),
+                    [points](std::uint32_t a, std::uint32_t b) {
+                        return points[a] == points[b];
+                    }),
+        m_sortedIndices.end());
+
+    m_indices.clear();
+    const std::size_t numPoints = m_sortedIndices.size();
+    if (numPoints < 3)
+    {
+        m_indices = m_sortedIndices;
+        return;
+    }
+
+    // Pops the last hull point while it does not make a left turn towards
+    // the new one, not going below minSize points
+    const auto addPoint = [&](std::uint32_t index, std::size_t minSize) {
+        const Vector2G<T> &point = points[index];
+        while (m_indices.size() >= minSize)
+        {
+            const Vector2G<T> &a = points[m_indices[m_indices.size() - 2]];
+            const Vector2G<T> &b = points[m_indices.back()];
+            if (Vector2G<T>::Cross(b - a, point - b) > 0)
+            {
+                break;
+            }
+            m_indices.pop_back();
+        }
+        m_indices.push_back(index);
+    };
+
+    // Lower chain left to right, then upper chain right to left
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        addPoint(m_sortedIndices[i], 2);
+    }
+    const std::size_t lowerSize = m_indices.size() + 1;
+    for (std::size_t i = numPoints - 1; i-- > 0;)
+    {
+        addPoint(m_sortedIndices[i], lowerSize);
+    }
+
+    // The last point is the first one again
+    m_indices.pop_back();
+}
+
+template <typename T>
+const std::vector<std::uint32_t> &ConvexHull2DG<T>::GetIndices() const
+{
+    return m_indices;
+}
+
+template <typename T>
+Polygon2DG<T> ConvexHull2DG<T>::GetPolygon() const
+{
+    Polygon2DG<T> polygon;
+    for (std::uint32_t index : m_indices)
+    {
+        polygon.AddPoint(m_points[index]);
+    }
+    return polygon;
+}
+
+template <typename T>
+bool ConvexHull2DG<T>::IsEmpty() const
+{
+    return m_indices.empty();
+}
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+namespace Bang
+{
+enum class CullResult
+{
+    OUTSIDE,
+    INTERSECTING,
+    INSIDE
+};
+}
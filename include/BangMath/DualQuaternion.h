@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename>
+class Matrix3x4G;
+template <typename>
+class Matrix4G;
+template <typename>
+class TransformationG;
+
+// Rigid transform (rotation, then translation) as a dual quaternion
+// real + e * dual, where real is the rotation and dual is half the
+// translation times the rotation. Unlike matrices, blending unit dual
+// quaternions and normalizing the sum gives a rigid transform again, which
+// is what dual quaternion skinning relies on to avoid the candy wrapper
+// collapse of linear blend skinning.
+//
+// Scale is not represented: it is dropped when converting from
+// TransformationG and Matrix4G.
+template <typename T>
+class DualQuaternionG
+{
+public:
+    static const DualQuaternionG<T> &Identity();
+
+    QuaternionG<T> real;
+    QuaternionG<T> dual;
+
+    DualQuaternionG();
+    DualQuaternionG(const QuaternionG<T> &_real, const QuaternionG<T> &_dual);
+    explicit DualQuaternionG(const TransformationG<T> &transformation);
+    explicit DualQuaternionG(const Matrix4G<T> &transformMatrix);
+
+    static DualQuaternionG<T> FromRotationTranslation(
+        const QuaternionG<T> &rotation,
+        const Vector3G<T> &translation);
+
+    // Unit real part, and dual part orthogonal to it
+    DualQuaternionG<T> Normalized() const;
+    // Inverse of a unit dual quaternion
+    DualQuaternionG<T> Conjugated() const;
+
+    Vector3G<T> TransformedPoint(const Vector3G<T> &point) const;
+    Vector3G<T> TransformedVector(const Vector3G<T> &vector) const;
+
+    // For unit dual quaternions
+    const QuaternionG<T> &GetRotation() const;
+    Vector3G<T> GetTranslation() const;
+    TransformationG<T> GetTransformation() const;
+    Matrix4G<T> GetMatrix() const;
+    Matrix3x4G<T> GetMatrix3x4() const;
+
+    // Dual quaternion skinning. For every vertex, the dual quaternions of its
+    // bones are added up by weight, each flipped to the hemisphere of the
+    // first one with a non zero weight, normalized, and the position and
+    // normal are transformed by the result. Vertex i has influencesPerVertex
+    // bone indices and weights starting at i * influencesPerVertex. Vertices
+    // without a non zero weight are copied unchanged. normals and normalsOut
+    // can be null, and the outputs can be the same buffers as the inputs.
+    static void Skin(const DualQuaternionG<T> *bones,
+                     const std::uint32_t *boneIndices,
+                     const T *boneWeights,
+                     std::size_t influencesPerVertex,
+                     const Vector3G<T> *positions,
+                     const Vector3G<T> *normals,
+                     Vector3G<T> *positionsOut,
+                     Vector3G<T> *normalsOut,
+                     std::size_t count);
+};
+
+template <typename T>
+bool operator==(const DualQuaternionG<T> &dq1, const DualQuaternionG<T> &dq2);
+
+template <typename T>
+bool operator!=(const DualQuaternionG<T> &dq1, const DualQuaternionG<T> &dq2);
+
+// Composition: transforms by dq2, then by dq1
+template <typename T>
+DualQuaternionG<T> operator*(const DualQuaternionG<T> &dq1,
+                             const DualQuaternionG<T> &dq2);
+
+template <typename T>
+DualQuaternionG<T> &operator*=(DualQuaternionG<T> &lhs,
+                               const DualQuaternionG<T> &rhs);
+
+template <typename T>
+DualQuaternionG<T> operator*(const DualQuaternionG<T> &dq, T a);
+
+template <typename T>
+DualQuaternionG<T> operator*(T a, const DualQuaternionG<T> &dq);
+
+template <typename T>
+DualQuaternionG<T> operator+(const DualQuaternionG<T> &dq1,
+                             const DualQuaternionG<T> &dq2);
+
+template <typename T>
+DualQuaternionG<T> &operator+=(DualQuaternionG<T> &lhs,
+                               const DualQuaternionG<T> &rhs);
+
+template <typename T>
+DualQuaternionG<T> operator-(const DualQuaternionG<T> &dq);
+
+template <typename T>
+std::ostream &operator<<(std::ostream &log, const DualQuaternionG<T> &dq)
+{
+    log << "(" << dq.real << ", " << dq.dual << ")";
+    return log;
+}
+
+BANG_MATH_DEFINE_USINGS(DualQuaternion)
+}
+
+#include "BangMath/DualQuaternion.tcc"
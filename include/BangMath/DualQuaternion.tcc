@@ -0,0 +1,251 @@
+#include "BangMath/DualQuaternion.h"
+
+#include "BangMath/Math.h"
+#include "BangMath/Matrix3x4.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Transformation.h"
+
+namespace Bang
+{
+template <typename T>
+const DualQuaternionG<T> &DualQuaternionG<T>::Identity()
+{
+    static const DualQuaternionG<T> identity;
+    return identity;
+}
+
+template <typename T>
+DualQuaternionG<T>::DualQuaternionG()
+    : real(QuaternionG<T>::Identity()), dual(0, 0, 0, 0)
+{
+}
+
+template <typename T>
+DualQuaternionG<T>::DualQuaternionG(const QuaternionG<T> &_real,
+                                    const QuaternionG<T> &_dual)
+    : real(_real), dual(_dual)
+{
+}
+
+template <typename T>
+DualQuaternionG<T>::DualQuaternionG(const TransformationG<T> &transformation)
+    : DualQuaternionG<T>(FromRotationTranslation(transformation.GetRotation(),
+                                                 transformation.GetPosition()))
+{
+}
+
+template <typename T>
+DualQuaternionG<T>::DualQuaternionG(const Matrix4G<T> &transformMatrix)
+    : DualQuaternionG<T>(FromRotationTranslation(
+          transformMatrix.GetRotation(), transformMatrix.GetTranslation()))
+{
+}
+
+template <typename T>
+DualQuaternionG<T> DualQuaternionG<T>::FromRotationTranslation(
+    const QuaternionG<T> &rotation,
+    const Vector3G<T> &translation)
+{
+    const QuaternionG<T> translationQuat(
+        translation.x, translation.y, translation.z, static_cast<T>(0));
+    return DualQuaternionG<T>(
+        rotation, static_cast<T>(0.5) * (translationQuat * rotation));
+}
+
+template <typename T>
+DualQuaternionG<T> DualQuaternionG<T>::Normalized() const
+{
+    const T invLength = static_cast<T>(1) / real.Length();
+    const QuaternionG<T> unitReal = invLength * real;
+    const QuaternionG<T> scaledDual = invLength * dual;
+    return DualQuaternionG<T>(
+        unitReal,
+        scaledDual +
+            (-QuaternionG<T>::Dot(unitReal, scaledDual) * unitReal));
+}
+
+template <typename T>
+DualQuaternionG<T> DualQuaternionG<T>::Conjugated() const
+{
+    return DualQuaternionG<T>(real.Conjugated(), dual.Conjugated());
+}
+
+template <typename T>
+Vector3G<T> DualQuaternionG<T>::TransformedPoint(
+    const Vector3G<T> &point) const
+{
+    return (real * point) + GetTranslation();
+}
+
+template <typename T>
+Vector3G<T> DualQuaternionG<T>::TransformedVector(
+    const Vector3G<T> &vector) const
+{
+    return real * vector;
+}
+
+template <typename T>
+const QuaternionG<T> &DualQuaternionG<T>::GetRotation() const
+{
+    return real;
+}
+
+template <typename T>
+Vector3G<T> DualQuaternionG<T>::GetTranslation() const
+{
+    // Vector part of 2 * dual * conjugated(real). Its scalar part is zero
+    // when dual is orthogonal to real, and is ignored otherwise.
+    const Vector3G<T> realVector(real.x, real.y, real.z);
+    const Vector3G<T> dualVector(dual.x, dual.y, dual.z);
+    return static_cast<T>(2) *
+           ((real.w * dualVector) - (dual.w * realVector) +
+            Vector3G<T>::Cross(realVector, dualVector));
+}
+
+template <typename T>
+TransformationG<T> DualQuaternionG<T>::GetTransformation() const
+{
+    return TransformationG<T>(GetTranslation(), real, Vector3G<T>::One());
+}
+
+template <typename T>
+Matrix4G<T> DualQuaternionG<T>::GetMatrix() const
+{
+    return Matrix4G<T>(GetMatrix3x4());
+}
+
+template <typename T>
+Matrix3x4G<T> DualQuaternionG<T>::GetMatrix3x4() const
+{
+    return Matrix3x4G<T>::TransformMatrix(
+        GetTranslation(), real, Vector3G<T>::One());
+}
+
+template <typename T>
+void DualQuaternionG<T>::Skin(const DualQuaternionG<T> *bones,
+                              const std::uint32_t *boneIndices,
+                              const T *boneWeights,
+                              std::size_t influencesPerVertex,
+                              const Vector3G<T> *positions,
+                              const Vector3G<T> *normals,
+                              Vector3G<T> *positionsOut,
+                              Vector3G<T> *normalsOut,
+                              std::size_t count)
+{
+    const bool skinNormals = (normals && normalsOut);
+    for (std::size_t v = 0; v < count; ++v)
+    {
+        const std::uint32_t *indices = boneIndices + v * influencesPerVertex;
+        const T *weights = boneWeights + v * influencesPerVertex;
+
+        // Bones on the other hemisphere of the first contributing one are
+        // the same transform, but would cancel it out in the sum
+        const QuaternionG<T> *pivot = nullptr;
+        QuaternionG<T> blendedReal(0, 0, 0, 0);
+        QuaternionG<T> blendedDual(0, 0, 0, 0);
+        for (std::size_t i = 0; i < influencesPerVertex; ++i)
+        {
+            const T weight = weights[i];
+            if (weight == static_cast<T>(0))
+            {
+                continue;
+            }
+            const DualQuaternionG<T> &bone = bones[indices[i]];
+            if (!pivot)
+            {
+                pivot = &bone.real;
+            }
+            const T signedWeight =
+                (QuaternionG<T>::Dot(*pivot, bone.real) < static_cast<T>(0)
+                     ? -weight
+                     : weight);
+            blendedReal += signedWeight * bone.real;
+            blendedDual += signedWeight * bone.dual;
+        }
+
+        const T sqLength = blendedReal.SqLength();
+        if (sqLength == static_cast<T>(0))
+        {
+            positionsOut[v] = positions[v];
+            if (skinNormals)
+            {
+                normalsOut[v] = normals[v];
+            }
+            continue;
+        }
+
+        // The translation does not need the dual part to be orthogonal, so
+        // scaling both parts is enough
+        const T invLength = static_cast<T>(1) / Math::Sqrt(sqLength);
+        const DualQuaternionG<T> blended(invLength * blendedReal,
+                                         invLength * blendedDual);
+        positionsOut[v] = blended.TransformedPoint(positions[v]);
+        if (skinNormals)
+        {
+            normalsOut[v] = blended.TransformedVector(normals[v]);
+        }
+    }
+}
+
+template <typename T>
+bool operator==(const DualQuaternionG<T> &dq1, const DualQuaternionG<T> &dq2)
+{
+    return dq1.real == dq2.real && dq1.dual == dq2.dual;
+}
+
+template <typename T>
+bool operator!=(const DualQuaternionG<T> &dq1, const DualQuaternionG<T> &dq2)
+{
+    return !(dq1 == dq2);
+}
+
+template <typename T>
+DualQuaternionG<T> operator*(const DualQuaternionG<T> &dq1,
+                             const DualQuaternionG<T> &dq2)
+{
+    return DualQuaternionG<T>(dq1.real * dq2.real,
+                              (dq1.real * dq2.dual) + (dq1.dual * dq2.real));
+}
+
+template <typename T>
+DualQuaternionG<T> &operator*=(DualQuaternionG<T> &lhs,
+                               const DualQuaternionG<T> &rhs)
+{
+    lhs = lhs * rhs;
+    return lhs;
+}
+
+template <typename T>
+DualQuaternionG<T> operator*(const DualQuaternionG<T> &dq, T a)
+{
+    return DualQuaternionG<T>(a * dq.real, a * dq.dual);
+}
+
+template <typename T>
+DualQuaternionG<T> operator*(T a, const DualQuaternionG<T> &dq)
+{
+    return dq * a;
+}
+
+template <typename T>
+DualQuaternionG<T> operator+(const DualQuaternionG<T> &dq1,
+                             const DualQuaternionG<T> &dq2)
+{
+    return DualQuaternionG<T>(dq1.real + dq2.real, dq1.dual + dq2.dual);
+}
+
+template <typename T>
+DualQuaternionG<T> &operator+=(DualQuaternionG<T> &lhs,
+                               const DualQuaternionG<T> &rhs)
+{
+    lhs.real += rhs.real;
+    lhs.dual += rhs.dual;
+    return lhs;
+}
+
+template <typename T>
+DualQuaternionG<T> operator-(const DualQuaternionG<T> &dq)
+{
+    return DualQuaternionG<T>(-dq.real, -dq.dual);
+}
+}
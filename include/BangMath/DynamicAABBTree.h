@@ -0,0 +1,185 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class RayG;
+template <typename>
+class SphereG;
+template <typename>
+class Vector3G;
+
+// Bounding volume tree for moving objects, to be used as a broad phase.
+// Leaves keep a "fat" box: the object box grown by a margin and by the
+// predicted displacement, so objects moving a bit do not touch the tree.
+// Objects are inserted, removed and moved incrementally. After every change
+// the ancestors of the leaf are refitted and rotated to lower their surface
+// area, which keeps the SAH cost of the tree low without rebuilds.
+//
+// Nodes live in a pooled array (reused through a free list) and objects are
+// referred to by the integer handle returned by Insert, valid until Remove.
+// Queries test the fat boxes unless an intersector is given, which is called
+// as intersector(handle, ray, &distance) like in BVHG.
+template <typename T>
+class DynamicAABBTreeG
+{
+public:
+    using Handle = std::int32_t;
+    static constexpr Handle NullHandle = -1;
+
+    struct Node
+    {
+        // Fat box for leaves, union of the children boxes otherwise
+        AABoxG<T> aaBox;
+        std::size_t userData = 0;
+        // Next free node while the node is in the free list
+        Handle parent = NullHandle;
+        Handle children[2] = {NullHandle, NullHandle};
+        // 0 for leaves, -1 for free nodes
+        int height = -1;
+        // Inserted or reinserted since the last ClearMoved()
+        bool moved = false;
+
+        bool IsLeaf() const;
+    };
+
+    // margin: distance the fat boxes are grown on every side.
+    // displacementMultiplier: how many displacements ahead the fat boxes of
+    // moving objects are grown towards the displacement direction.
+    explicit DynamicAABBTreeG(T margin = static_cast<T>(0.1),
+                              T displacementMultiplier = static_cast<T>(2));
+
+    Handle Insert(const AABoxG<T> &aaBox, std::size_t userData = 0);
+    void Remove(Handle handle);
+    // Updates the box of a moved object. The leaf is only reinserted when the
+    // box escapes its fat box (or the fat box got too large for it). Returns
+    // whether it was reinserted.
+    bool Move(Handle handle, const AABoxG<T> &aaBox);
+    bool Move(Handle handle,
+              const AABoxG<T> &aaBox,
+              const Vector3G<T> &displacement);
+    void Clear();
+
+    // Closest hit. Returns false if nothing is hit before maxDistance.
+    bool Raycast(const RayG<T> &ray,
+                 T maxDistance,
+                 T *hitDistance = nullptr,
+                 Handle *hitHandle = nullptr) const;
+    template <class Intersector>
+    bool Raycast(const RayG<T> &ray,
+                 T maxDistance,
+                 Intersector intersector,
+                 T *hitDistance = nullptr,
+                 Handle *hitHandle = nullptr) const;
+
+    // Appends to handlesOut the objects whose fat box overlaps the query
+    void QueryOverlaps(const AABoxG<T> &aaBox,
+                       std::vector<Handle> *handlesOut) const;
+    void QueryOverlaps(const SphereG<T> &sphere,
+                       std::vector<Handle> *handlesOut) const;
+
+    // Calls visitor(handle) for every object whose fat box overlaps
+    template <class Visitor>
+    void VisitOverlaps(const AABoxG<T> &aaBox, Visitor visitor) const;
+    template <class Visitor>
+    void VisitOverlaps(const SphereG<T> &sphere, Visitor visitor) const;
+
+    // Pairs of objects with overlapping fat boxes, each one reported once as
+    // (smaller handle, greater handle)
+    void QueryPairs(std::vector<std::pair<Handle, Handle>> *pairsOut) const;
+    template <class Visitor>
+    void VisitPairs(Visitor visitor) const;
+    // Same, but only the pairs with an object inserted or reinserted since
+    // the last ClearMoved(). Pairs between objects that did not leave their
+    // fat boxes can not have changed, so this is all a pair cache needs.
+    template <class Visitor>
+    void VisitMovedPairs(Visitor visitor) const;
+    void ClearMoved();
+
+    const AABoxG<T> &GetFatAABox(Handle handle) const;
+    std::size_t GetUserData(Handle handle) const;
+    bool WasMoved(Handle handle) const;
+
+    bool IsEmpty() const;
+    std::size_t GetObjectCount() const;
+    Handle GetRoot() const;
+    int GetHeight() const;
+    // Sum of the interior node areas over the root area. It is proportional
+    // to the SAH cost of the tree, so lower is better.
+    T GetAreaRatio() const;
+    const std::vector<Node> &GetNodes() const;
+
+private:
+    std::vector<Node> m_nodes;
+    Handle m_root = NullHandle;
+    Handle m_freeList = NullHandle;
+    std::size_t m_objectCount = 0;
+    std::vector<Handle> m_movedHandles;
+    T m_margin;
+    T m_displacementMultiplier;
+
+    // Stack of nodes to visit. Only allocates when the tree is deeper than
+    // the inline capacity.
+    template <class Entry>
+    class TraversalStack
+    {
+    public:
+        void Push(const Entry &entry);
+        Entry Pop();
+        bool IsEmpty() const;
+
+    private:
+        static constexpr int InlineCapacity = 128;
+        Entry m_inline[InlineCapacity];
+        int m_inlineSize = 0;
+        std::vector<Entry> m_overflow;
+    };
+
+    Handle AllocateNode();
+    void FreeNode(Handle handle);
+    void InsertLeaf(Handle leaf);
+    void RemoveLeaf(Handle leaf);
+    Handle FindBestSibling(const AABoxG<T> &aaBox) const;
+    void RefitAncestors(Handle handle);
+    void Rotate(Handle handle);
+    void SwapChildren(Handle parentA,
+                      int childA,
+                      Handle parentB,
+                      int childB);
+    void MarkMoved(Handle handle);
+    AABoxG<T> GetFatAABox(const AABoxG<T> &aaBox,
+                          const Vector3G<T> &displacement) const;
+
+    template <class LeafIntersector>
+    bool Traverse(const RayG<T> &ray,
+                  T maxDistance,
+                  const LeafIntersector &intersectLeaf,
+                  T *hitDistance,
+                  Handle *hitHandle) const;
+
+    template <class Overlaps, class Visitor>
+    void TraverseOverlaps(const Overlaps &overlaps, Visitor &visitor) const;
+
+    static AABoxG<T> Union(const AABoxG<T> &b0, const AABoxG<T> &b1);
+    static bool Contains(const AABoxG<T> &outer, const AABoxG<T> &inner);
+    static bool IntersectRayBox(const Vector3G<T> &origin,
+                                const Vector3G<T> &invDirection,
+                                const AABoxG<T> &aaBox,
+                                T maxDistance,
+                                T *nearDistance);
+    static bool OverlapSphereBox(const SphereG<T> &sphere,
+                                 const AABoxG<T> &aaBox);
+};
+
+BANG_MATH_DEFINE_USINGS(DynamicAABBTree)
+}
+
+#include "BangMath/DynamicAABBTree.tcc"
@@ -0,0 +1,845 @@
+#include "BangMath/DynamicAABBTree.h"
+
+#include <algorithm>
+
+#include "BangMath/Math.h"
+#include "BangMath/Ray.h"
+#include "BangMath/Sphere.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr typename DynamicAABBTreeG<T>::Handle DynamicAABBTreeG<T>::NullHandle;
+
+template <typename T>
+bool DynamicAABBTreeG<T>::Node::IsLeaf() const
+{
+    return (height == 0);
+}
+
+template <typename T>
+DynamicAABBTreeG<T>::DynamicAABBTreeG(T margin, T displacementMultiplier)
+    : m_margin(margin), m_displacementMultiplier(displacementMultiplier)
+{
+}
+
+template <typename T>
+typename DynamicAABBTreeG<T>::Handle DynamicAABBTreeG<T>::Insert(
+    const AABoxG<T> &aaBox,
+    std::size_t userData)
+{
+    const Handle handle = AllocateNode();
+    Node &leaf = m_nodes[handle];
+    leaf.aaBox = GetFatAABox(aaBox, Vector3G<T>::Zero());
+    leaf.userData = userData;
+    leaf.height = 0;
+    InsertLeaf(handle);
+    MarkMoved(handle);
+    ++m_objectCount;
+    return handle;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::Remove(Handle handle)
+{
+    if (m_nodes[handle].moved)
+    {
+        const auto it = std::find(
+            m_movedHandles.begin(), m_movedHandles.end(), handle);
+        *it = m_movedHandles.back();
+        m_movedHandles.pop_back();
+    }
+    RemoveLeaf(handle);
+    FreeNode(handle);
+    --m_objectCount;
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::Move(Handle handle, const AABoxG<T> &aaBox)
+{
+    return Move(handle, aaBox, Vector3G<T>::Zero());
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::Move(Handle handle,
+                               const AABoxG<T> &aaBox,
+                               const Vector3G<T> &displacement)
+{
+    const AABoxG<T> fatAABox = GetFatAABox(aaBox, displacement);
+    const AABoxG<T> &treeAABox = m_nodes[handle].aaBox;
+    if (Contains(treeAABox, aaBox))
+    {
+        // Still inside, but a fat box much larger than needed (e.g. grown
+        // for a fast object that stopped) would give too many false pairs
+        const Vector3G<T> hugeMargin(4 * m_margin);
+        const AABoxG<T> hugeAABox(fatAABox.GetMin() - hugeMargin,
+                                  fatAABox.GetMax() + hugeMargin);
+        if (Contains(hugeAABox, treeAABox))
+        {
+            return false;
+        }
+    }
+
+    RemoveLeaf(handle);
+    m_nodes[handle].aaBox = fatAABox;
+    InsertLeaf(handle);
+    MarkMoved(handle);
+    return true;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::Clear()
+{
+    m_nodes.clear();
+    m_movedHandles.clear();
+    m_root = NullHandle;
+    m_freeList = NullHandle;
+    m_objectCount = 0;
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::Raycast(const RayG<T> &ray,
+                                  T maxDistance,
+                                  T *hitDistance,
+                                  Handle *hitHandle) const
+{
+    const auto &origin = ray.GetOrigin();
+    const auto &direction = ray.GetDirection();
+    const Vector3G<T> invDirection(
+        T(1) / direction.x, T(1) / direction.y, T(1) / direction.z);
+    const auto intersectLeaf = [&](Handle handle, T *distance) {
+        return IntersectRayBox(origin,
+                               invDirection,
+                               m_nodes[handle].aaBox,
+                               maxDistance,
+                               distance);
+    };
+    return Traverse(ray, maxDistance, intersectLeaf, hitDistance, hitHandle);
+}
+
+template <typename T>
+template <class Intersector>
+bool DynamicAABBTreeG<T>::Raycast(const RayG<T> &ray,
+                                  T maxDistance,
+                                  Intersector intersector,
+                                  T *hitDistance,
+                                  Handle *hitHandle) const
+{
+    const auto intersectLeaf = [&](Handle handle, T *distance) {
+        return intersector(handle, ray, distance);
+    };
+    return Traverse(ray, maxDistance, intersectLeaf, hitDistance, hitHandle);
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::QueryOverlaps(const AABoxG<T> &aaBox,
+                                        std::vector<Handle> *handlesOut) const
+{
+    VisitOverlaps(aaBox, [handlesOut](Handle handle) {
+        handlesOut->push_back(handle);
+    });
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::QueryOverlaps(const SphereG<T> &sphere,
+                                        std::vector<Handle> *handlesOut) const
+{
+    VisitOverlaps(sphere, [handlesOut](Handle handle) {
+        handlesOut->push_back(handle);
+    });
+}
+
+template <typename T>
+template <class Visitor>
+void DynamicAABBTreeG<T>::VisitOverlaps(const AABoxG<T> &aaBox,
+                                        Visitor visitor) const
+{
+    const auto overlaps = [&aaBox](const AABoxG<T> &box) {
+        return aaBox.Overlap(box);
+    };
+    TraverseOverlaps(overlaps, visitor);
+}
+
+template <typename T>
+template <class Visitor>
+void DynamicAABBTreeG<T>::VisitOverlaps(const SphereG<T> &sphere,
+                                        Visitor visitor) const
+{
+    const auto overlaps = [&sphere](const AABoxG<T> &box) {
+        return OverlapSphereBox(sphere, box);
+    };
+    TraverseOverlaps(overlaps, visitor);
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::QueryPairs(
+    std::vector<std::pair<Handle, Handle>> *pairsOut) const
+{
+    VisitPairs([pairsOut](Handle handle0, Handle handle1) {
+        pairsOut->emplace_back(handle0, handle1);
+    });
+}
+
+template <typename T>
+template <class Visitor>
+void DynamicAABBTreeG<T>::VisitPairs(Visitor visitor) const
+{
+    const Handle numNodes = static_cast<Handle>(m_nodes.size());
+    for (Handle handle = 0; handle < numNodes; ++handle)
+    {
+        if (!m_nodes[handle].IsLeaf())
+        {
+            continue;
+        }
+
+        const AABoxG<T> &aaBox = m_nodes[handle].aaBox;
+        const auto overlaps = [&aaBox](const AABoxG<T> &box) {
+            return aaBox.Overlap(box);
+        };
+        auto pairVisitor = [&](Handle other) {
+            if (other > handle)
+            {
+                visitor(handle, other);
+            }
+        };
+        TraverseOverlaps(overlaps, pairVisitor);
+    }
+}
+
+template <typename T>
+template <class Visitor>
+void DynamicAABBTreeG<T>::VisitMovedPairs(Visitor visitor) const
+{
+    for (const Handle handle : m_movedHandles)
+    {
+        const AABoxG<T> &aaBox = m_nodes[handle].aaBox;
+        const auto overlaps = [&aaBox](const AABoxG<T> &box) {
+            return aaBox.Overlap(box);
+        };
+        auto pairVisitor = [&](Handle other) {
+            // Pairs of two moved objects are reported by the smaller handle
+            if (other == handle || (m_nodes[other].moved && other < handle))
+            {
+                return;
+            }
+            visitor(Math::Min(handle, other), Math::Max(handle, other));
+        };
+        TraverseOverlaps(overlaps, pairVisitor);
+    }
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::ClearMoved()
+{
+    for (const Handle handle : m_movedHandles)
+    {
+        m_nodes[handle].moved = false;
+    }
+    m_movedHandles.clear();
+}
+
+template <typename T>
+const AABoxG<T> &DynamicAABBTreeG<T>::GetFatAABox(Handle handle) const
+{
+    return m_nodes[handle].aaBox;
+}
+
+template <typename T>
+std::size_t DynamicAABBTreeG<T>::GetUserData(Handle handle) const
+{
+    return m_nodes[handle].userData;
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::WasMoved(Handle handle) const
+{
+    return m_nodes[handle].moved;
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::IsEmpty() const
+{
+    return (m_root == NullHandle);
+}
+
+template <typename T>
+std::size_t DynamicAABBTreeG<T>::GetObjectCount() const
+{
+    return m_objectCount;
+}
+
+template <typename T>
+typename DynamicAABBTreeG<T>::Handle DynamicAABBTreeG<T>::GetRoot() const
+{
+    return m_root;
+}
+
+template <typename T>
+int DynamicAABBTreeG<T>::GetHeight() const
+{
+    return (IsEmpty() ? 0 : m_nodes[m_root].height);
+}
+
+template <typename T>
+T DynamicAABBTreeG<T>::GetAreaRatio() const
+{
+    if (IsEmpty())
+    {
+        return T(0);
+    }
+
+    T interiorArea = T(0);
+    for (const Node &node : m_nodes)
+    {
+        if (node.height > 0)
+        {
+            interiorArea += node.aaBox.GetArea();
+        }
+    }
+    return interiorArea / m_nodes[m_root].aaBox.GetArea();
+}
+
+template <typename T>
+const std::vector<typename DynamicAABBTreeG<T>::Node>
+    &DynamicAABBTreeG<T>::GetNodes() const
+{
+    return m_nodes;
+}
+
+template <typename T>
+template <class Entry>
+void DynamicAABBTreeG<T>::TraversalStack<Entry>::Push(const Entry &entry)
+{
+    if (m_inlineSize < InlineCapacity)
+    {
+        m_inline[m_inlineSize++] = entry;
+    }
+    else
+    {
+        m_overflow.push_back(entry);
+    }
+}
+
+template <typename T>
+template <class Entry>
+Entry DynamicAABBTreeG<T>::TraversalStack<Entry>::Pop()
+{
+    if (!m_overflow.empty())
+    {
+        const Entry entry = m_overflow.back();
+        m_overflow.pop_back();
+        return entry;
+    }
+    return m_inline[--m_inlineSize];
+}
+
+template <typename T>
+template <class Entry>
+bool DynamicAABBTreeG<T>::TraversalStack<Entry>::IsEmpty() const
+{
+    return (m_inlineSize == 0);
+}
+
+template <typename T>
+typename DynamicAABBTreeG<T>::Handle DynamicAABBTreeG<T>::AllocateNode()
+{
+    Handle handle;
+    if (m_freeList == NullHandle)
+    {
+        handle = static_cast<Handle>(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+    else
+    {
+        handle = m_freeList;
+        m_freeList = m_nodes[handle].parent;
+        m_nodes[handle] = Node();
+    }
+    return handle;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::FreeNode(Handle handle)
+{
+    Node &node = m_nodes[handle];
+    node.parent = m_freeList;
+    node.height = -1;
+    node.moved = false;
+    m_freeList = handle;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::InsertLeaf(Handle leaf)
+{
+    if (m_root == NullHandle)
+    {
+        m_root = leaf;
+        m_nodes[leaf].parent = NullHandle;
+        return;
+    }
+
+    const Handle sibling = FindBestSibling(m_nodes[leaf].aaBox);
+    const Handle oldParent = m_nodes[sibling].parent;
+
+    // May grow the pool, so no node references are kept across it
+    const Handle newParent = AllocateNode();
+    Node &parentNode = m_nodes[newParent];
+    parentNode.parent = oldParent;
+    parentNode.children[0] = sibling;
+    parentNode.children[1] = leaf;
+    parentNode.height = 1;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == NullHandle)
+    {
+        m_root = newParent;
+    }
+    else
+    {
+        Node &oldParentNode = m_nodes[oldParent];
+        oldParentNode.children[oldParentNode.children[0] == sibling ? 0 : 1] =
+            newParent;
+    }
+    RefitAncestors(newParent);
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::RemoveLeaf(Handle leaf)
+{
+    if (leaf == m_root)
+    {
+        m_root = NullHandle;
+        return;
+    }
+
+    const Handle parent = m_nodes[leaf].parent;
+    const Node &parentNode = m_nodes[parent];
+    const Handle grandParent = parentNode.parent;
+    const Handle sibling =
+        parentNode.children[parentNode.children[0] == leaf ? 1 : 0];
+
+    // The sibling takes the place of the parent
+    m_nodes[sibling].parent = grandParent;
+    FreeNode(parent);
+    m_nodes[leaf].parent = NullHandle;
+    if (grandParent == NullHandle)
+    {
+        m_root = sibling;
+        return;
+    }
+
+    Node &grandParentNode = m_nodes[grandParent];
+    grandParentNode.children[grandParentNode.children[0] == parent ? 0 : 1] =
+        sibling;
+    RefitAncestors(grandParent);
+}
+
+// Descends towards the cheapest place for a new leaf. At each node, compares
+// the cost of making the leaf its sibling (a new parent with the union area)
+// against the lower bound of descending into each child: the area the child
+// would grow, plus the growth every ancestor pays (the inheritance cost).
+template <typename T>
+typename DynamicAABBTreeG<T>::Handle DynamicAABBTreeG<T>::FindBestSibling(
+    const AABoxG<T> &aaBox) const
+{
+    Handle handle = m_root;
+    while (!m_nodes[handle].IsLeaf())
+    {
+        const Node &node = m_nodes[handle];
+        const T area = node.aaBox.GetArea();
+        const T combinedArea = Union(node.aaBox, aaBox).GetArea();
+        const T cost = 2 * combinedArea;
+        const T inheritanceCost = 2 * (combinedArea - area);
+
+        T childCosts[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            const Node &child = m_nodes[node.children[i]];
+            T childCost = Union(child.aaBox, aaBox).GetArea();
+            if (!child.IsLeaf())
+            {
+                childCost -= child.aaBox.GetArea();
+            }
+            childCosts[i] = childCost + inheritanceCost;
+        }
+
+        if (cost < childCosts[0] && cost < childCosts[1])
+        {
+            break;
+        }
+        handle = node.children[childCosts[1] < childCosts[0] ? 1 : 0];
+    }
+    return handle;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::RefitAncestors(Handle handle)
+{
+    while (handle != NullHandle)
+    {
+        Node &node = m_nodes[handle];
+        const Node &child0 = m_nodes[node.children[0]];
+        const Node &child1 = m_nodes[node.children[1]];
+        node.aaBox = Union(child0.aaBox, child1.aaBox);
+        node.height = 1 + Math::Max(child0.height, child1.height);
+        Rotate(handle);
+        handle = node.parent;
+    }
+}
+
+// Tries the swaps between a child of the node and a grandchild on the other
+// side, and between two grandchildren on different sides. These keep the
+// node box the same but change the boxes of its children, so the one that
+// reduces their area the most is applied.
+template <typename T>
+void DynamicAABBTreeG<T>::Rotate(Handle handle)
+{
+    const Node &node = m_nodes[handle];
+    const Handle children[2] = {node.children[0], node.children[1]};
+    const Node *childNodes[2] = {&m_nodes[children[0]],
+                                 &m_nodes[children[1]]};
+    const T childAreas[2] = {childNodes[0]->aaBox.GetArea(),
+                             childNodes[1]->aaBox.GetArea()};
+
+    T bestGain = T(0);
+    Handle bestParentA = NullHandle;
+    Handle bestParentB = NullHandle;
+    int bestChildA = 0;
+    int bestChildB = 0;
+
+    // Child i swapped with grandchild j under the other child
+    for (int i = 0; i < 2; ++i)
+    {
+        const Node &other = *childNodes[1 - i];
+        if (other.IsLeaf())
+        {
+            continue;
+        }
+        for (int j = 0; j < 2; ++j)
+        {
+            const AABoxG<T> &kept = m_nodes[other.children[1 - j]].aaBox;
+            const T newArea =
+                Union(childNodes[i]->aaBox, kept).GetArea();
+            const T gain = childAreas[1 - i] - newArea;
+            if (gain > bestGain)
+            {
+                bestGain = gain;
+                bestParentA = handle;
+                bestChildA = i;
+                bestParentB = children[1 - i];
+                bestChildB = j;
+            }
+        }
+    }
+
+    // Grandchild i under the first child swapped with grandchild j under
+    // the second one
+    if (!childNodes[0]->IsLeaf() && !childNodes[1]->IsLeaf())
+    {
+        for (int i = 0; i < 2; ++i)
+        {
+            const Handle grandChild0 = childNodes[0]->children[i];
+            const Handle kept0 = childNodes[0]->children[1 - i];
+            for (int j = 0; j < 2; ++j)
+            {
+                const Handle grandChild1 = childNodes[1]->children[j];
+                const Handle kept1 = childNodes[1]->children[1 - j];
+                const T newArea0 =
+                    Union(m_nodes[kept0].aaBox, m_nodes[grandChild1].aaBox)
+                        .GetArea();
+                const T newArea1 =
+                    Union(m_nodes[kept1].aaBox, m_nodes[grandChild0].aaBox)
+                        .GetArea();
+                const T gain =
+                    childAreas[0] + childAreas[1] - newArea0 - newArea1;
+                if (gain > bestGain)
+                {
+                    bestGain = gain;
+                    bestParentA = children[0];
+                    bestChildA = i;
+                    bestParentB = children[1];
+                    bestChildB = j;
+                }
+            }
+        }
+    }
+
+    if (bestParentA == NullHandle)
+    {
+        return;
+    }
+
+    SwapChildren(bestParentA, bestChildA, bestParentB, bestChildB);
+
+    // Refit the current children, as one may have been swapped for a
+    // grandchild, then the node height (its box is the same)
+    for (int i = 0; i < 2; ++i)
+    {
+        Node &child = m_nodes[m_nodes[handle].children[i]];
+        if (!child.IsLeaf())
+        {
+            const Node &grandChild0 = m_nodes[child.children[0]];
+            const Node &grandChild1 = m_nodes[child.children[1]];
+            child.aaBox = Union(grandChild0.aaBox, grandChild1.aaBox);
+            child.height =
+                1 + Math::Max(grandChild0.height, grandChild1.height);
+        }
+    }
+    Node &rotatedNode = m_nodes[handle];
+    rotatedNode.height =
+        1 + Math::Max(m_nodes[rotatedNode.children[0]].height,
+                      m_nodes[rotatedNode.children[1]].height);
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::SwapChildren(Handle parentA,
+                                       int childA,
+                                       Handle parentB,
+                                       int childB)
+{
+    Node &parentNodeA = m_nodes[parentA];
+    Node &parentNodeB = m_nodes[parentB];
+    const Handle handleA = parentNodeA.children[childA];
+    const Handle handleB = parentNodeB.children[childB];
+    parentNodeA.children[childA] = handleB;
+    parentNodeB.children[childB] = handleA;
+    m_nodes[handleA].parent = parentB;
+    m_nodes[handleB].parent = parentA;
+}
+
+template <typename T>
+void DynamicAABBTreeG<T>::MarkMoved(Handle handle)
+{
+    Node &node = m_nodes[handle];
+    if (!node.moved)
+    {
+        node.moved = true;
+        m_movedHandles.push_back(handle);
+    }
+}
+
+// Grown by the margin on every side, and by the scaled displacement towards
+// where the object is going
+template <typename T>
+AABoxG<T> DynamicAABBTreeG<T>::GetFatAABox(
+    const AABoxG<T> &aaBox,
+    const Vector3G<T> &displacement) const
+{
+    const Vector3G<T> margin(m_margin);
+    Vector3G<T> fatMin = aaBox.GetMin() - margin;
+    Vector3G<T> fatMax = aaBox.GetMax() + margin;
+    for (int i = 0; i < 3; ++i)
+    {
+        const T predicted = displacement[i] * m_displacementMultiplier;
+        if (predicted < 0)
+        {
+            fatMin[i] += predicted;
+        }
+        else
+        {
+            fatMax[i] += predicted;
+        }
+    }
+    return AABoxG<T>(fatMin, fatMax);
+}
+
+// Closest first: the nearest hit child is visited right away and the other
+// one pushed with its distance, skipped later if something closer was hit
+template <typename T>
+template <class LeafIntersector>
+bool DynamicAABBTreeG<T>::Traverse(const RayG<T> &ray,
+                                   T maxDistance,
+                                   const LeafIntersector &intersectLeaf,
+                                   T *hitDistance,
+                                   Handle *hitHandle) const
+{
+    if (IsEmpty())
+    {
+        return false;
+    }
+
+    const auto &origin = ray.GetOrigin();
+    const auto &direction = ray.GetDirection();
+    const Vector3G<T> invDirection(
+        T(1) / direction.x, T(1) / direction.y, T(1) / direction.z);
+
+    struct StackEntry
+    {
+        Handle node;
+        T distance;
+    };
+    TraversalStack<StackEntry> stack;
+
+    T rootDistance;
+    if (!IntersectRayBox(origin,
+                         invDirection,
+                         m_nodes[m_root].aaBox,
+                         maxDistance,
+                         &rootDistance))
+    {
+        return false;
+    }
+    stack.Push({m_root, rootDistance});
+
+    bool hit = false;
+    T closestDistance = maxDistance;
+    Handle closestHandle = NullHandle;
+    while (!stack.IsEmpty())
+    {
+        const StackEntry entry = stack.Pop();
+        if (entry.distance > closestDistance)
+        {
+            continue;
+        }
+
+        const Node &node = m_nodes[entry.node];
+        if (node.IsLeaf())
+        {
+            T distance;
+            if (intersectLeaf(entry.node, &distance) && distance >= 0 &&
+                distance <= closestDistance)
+            {
+                hit = true;
+                closestDistance = distance;
+                closestHandle = entry.node;
+            }
+            continue;
+        }
+
+        StackEntry childEntries[2];
+        int numHits = 0;
+        for (int i = 0; i < 2; ++i)
+        {
+            const Handle child = node.children[i];
+            T distance;
+            if (IntersectRayBox(origin,
+                                invDirection,
+                                m_nodes[child].aaBox,
+                                closestDistance,
+                                &distance))
+            {
+                childEntries[numHits++] = {child, distance};
+            }
+        }
+        if (numHits == 2 && childEntries[0].distance < childEntries[1].distance)
+        {
+            std::swap(childEntries[0], childEntries[1]);
+        }
+        for (int i = 0; i < numHits; ++i)
+        {
+            stack.Push(childEntries[i]);
+        }
+    }
+
+    if (hit)
+    {
+        if (hitDistance)
+        {
+            *hitDistance = closestDistance;
+        }
+        if (hitHandle)
+        {
+            *hitHandle = closestHandle;
+        }
+    }
+    return hit;
+}
+
+template <typename T>
+template <class Overlaps, class Visitor>
+void DynamicAABBTreeG<T>::TraverseOverlaps(const Overlaps &overlaps,
+                                           Visitor &visitor) const
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    TraversalStack<Handle> stack;
+    stack.Push(m_root);
+    while (!stack.IsEmpty())
+    {
+        const Handle handle = stack.Pop();
+        const Node &node = m_nodes[handle];
+        if (!overlaps(node.aaBox))
+        {
+            continue;
+        }
+
+        if (node.IsLeaf())
+        {
+            visitor(handle);
+        }
+        else
+        {
+            stack.Push(node.children[1]);
+            stack.Push(node.children[0]);
+        }
+    }
+}
+
+template <typename T>
+AABoxG<T> DynamicAABBTreeG<T>::Union(const AABoxG<T> &b0,
+                                     const AABoxG<T> &b1)
+{
+    return AABoxG<T>(Vector3G<T>::Min(b0.GetMin(), b1.GetMin()),
+                     Vector3G<T>::Max(b0.GetMax(), b1.GetMax()));
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::Contains(const AABoxG<T> &outer,
+                                   const AABoxG<T> &inner)
+{
+    return (outer.GetMin().x <= inner.GetMin().x &&
+            outer.GetMin().y <= inner.GetMin().y &&
+            outer.GetMin().z <= inner.GetMin().z &&
+            inner.GetMax().x <= outer.GetMax().x &&
+            inner.GetMax().y <= outer.GetMax().y &&
+            inner.GetMax().z <= outer.GetMax().z);
+}
+
+// Same slab test as BVHG: zero direction components give infinite slab
+// distances, or NaN when the origin is on a slab plane, which is skipped
+// explicitly. The distance is clamped to 0 inside the box.
+template <typename T>
+bool DynamicAABBTreeG<T>::IntersectRayBox(const Vector3G<T> &origin,
+                                          const Vector3G<T> &invDirection,
+                                          const AABoxG<T> &aaBox,
+                                          T maxDistance,
+                                          T *nearDistance)
+{
+    const auto &bMin = aaBox.GetMin();
+    const auto &bMax = aaBox.GetMax();
+
+    T tNear = T(0);
+    T tFar = maxDistance;
+    for (int i = 0; i < 3; ++i)
+    {
+        const T t0 = (bMin[i] - origin[i]) * invDirection[i];
+        const T t1 = (bMax[i] - origin[i]) * invDirection[i];
+        // 0 * inf is NaN when the origin lies on a plane of the slab and the
+        // ray runs along it. The ray stays inside that slab then.
+        if (Math::IsNaN(t0) || Math::IsNaN(t1))
+        {
+            continue;
+        }
+        tNear = Math::Max(tNear, Math::Min(t0, t1));
+        tFar = Math::Min(tFar, Math::Max(t0, t1));
+    }
+
+    *nearDistance = tNear;
+    return (tNear <= tFar);
+}
+
+template <typename T>
+bool DynamicAABBTreeG<T>::OverlapSphereBox(const SphereG<T> &sphere,
+                                           const AABoxG<T> &aaBox)
+{
+    const auto closestPoint = aaBox.GetClosestPointInAABB(sphere.GetCenter());
+    const auto sqDistance =
+        Vector3G<T>::SqDistance(closestPoint, sphere.GetCenter());
+    return (sqDistance <= sphere.GetRadius() * sphere.GetRadius());
+}
+}
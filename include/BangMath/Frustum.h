@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "BangMath/CullResult.h"
+#include "BangMath/Defines.h"
+#include "BangMath/Vector4.h"
+
+namespace Bang
+{
+template <typename>
+class AABoxG;
+template <typename>
+class Matrix4G;
+template <typename>
+class PlaneG;
+template <typename>
+class SphereG;
+template <typename>
+class Vector3G;
+
+enum class FrustumPlane
+{
+    LEFT,
+    RIGHT,
+    BOTTOM,
+    TOP,
+    ZNEAR,
+    ZFAR
+};
+
+// View frustum as six planes pointing inwards, extracted from a
+// view-projection matrix (Gribb & Hartmann), so that it matches whatever
+// Perspective/Ortho and view produced it.
+//
+// Plane masks have bit i set for plane i (in FrustumPlane order) when that
+// plane still has to be tested. For hierarchical culling, pass the mask of
+// the parent when culling its children: planes the parent is completely
+// inside of are cleared from the mask and skipped. outsidePlane, if given,
+// is the plane that rejected this object last time (plane coherency). It is
+// tested first and updated whenever the object is found outside.
+template <typename T>
+class FrustumG
+{
+public:
+    static constexpr int NumPlanes = 6;
+    static constexpr int AllPlanesMask = (1 << NumPlanes) - 1;
+
+    FrustumG() = default;
+    explicit FrustumG(const Matrix4G<T> &viewProjection);
+
+    void SetFromViewProjection(const Matrix4G<T> &viewProjection);
+
+    PlaneG<T> GetPlane(FrustumPlane plane) const;
+    // (normal.x, normal.y, normal.z, d), with dot(normal, p) + d >= 0 inside
+    const Vector4G<T> &GetPlaneEquation(FrustumPlane plane) const;
+
+    bool Contains(const Vector3G<T> &point) const;
+
+    CullResult Cull(const AABoxG<T> &aaBox,
+                    int *planeMask = nullptr,
+                    int *outsidePlane = nullptr) const;
+    CullResult Cull(const SphereG<T> &sphere,
+                    int *planeMask = nullptr,
+                    int *outsidePlane = nullptr) const;
+
+    // Batch culling, four objects at a time with SIMD4G.
+    // resultsOut must hold count values.
+    void Cull(const AABoxG<T> *aaBoxes,
+              std::size_t count,
+              CullResult *resultsOut) const;
+    void Cull(const SphereG<T> *spheres,
+              std::size_t count,
+              CullResult *resultsOut) const;
+
+private:
+    std::array<Vector4G<T>, NumPlanes> m_planes;
+
+    template <class DistanceFunction>
+    CullResult CullPlanes(DistanceFunction getDistanceAndRadius,
+                          int *planeMask,
+                          int *outsidePlane) const;
+
+    static void StoreResults(int outsideMask,
+                             int intersectingMask,
+                             std::size_t count,
+                             CullResult *resultsOut);
+};
+
+BANG_MATH_DEFINE_USINGS(Frustum)
+}
+
+#include "BangMath/Frustum.tcc"
@@ -0,0 +1,291 @@
+#include "BangMath/Frustum.h"
+
+#include "BangMath/AABox.h"
+#include "BangMath/Math.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Plane.h"
+#include "BangMath/SIMD.h"
+#include "BangMath/Sphere.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+FrustumG<T>::FrustumG(const Matrix4G<T> &viewProjection)
+{
+    SetFromViewProjection(viewProjection);
+}
+
+template <typename T>
+void FrustumG<T>::SetFromViewProjection(const Matrix4G<T> &viewProjection)
+{
+    const auto &m = viewProjection;
+    const Vector4G<T> row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const Vector4G<T> row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const Vector4G<T> row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const Vector4G<T> row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    // Clip space is -w <= x, y, z <= w
+    m_planes[static_cast<int>(FrustumPlane::LEFT)] = row3 + row0;
+    m_planes[static_cast<int>(FrustumPlane::RIGHT)] = row3 - row0;
+    m_planes[static_cast<int>(FrustumPlane::BOTTOM)] = row3 + row1;
+    m_planes[static_cast<int>(FrustumPlane::TOP)] = row3 - row1;
+    m_planes[static_cast<int>(FrustumPlane::ZNEAR)] = row3 + row2;
+    m_planes[static_cast<int>(FrustumPlane::ZFAR)] = row3 - row2;
+
+    // Normalize, so that plane equations give actual distances
+    for (auto &plane : m_planes)
+    {
+        const T normalLength = plane.xyz().Length();
+        if (normalLength > 0)
+        {
+            plane = plane / normalLength;
+        }
+    }
+}
+
+template <typename T>
+PlaneG<T> FrustumG<T>::GetPlane(FrustumPlane plane) const
+{
+    const auto &equation = GetPlaneEquation(plane);
+    const auto normal = equation.xyz();
+    return PlaneG<T>(normal * -equation.w, normal);
+}
+
+template <typename T>
+const Vector4G<T> &FrustumG<T>::GetPlaneEquation(FrustumPlane plane) const
+{
+    return m_planes[static_cast<int>(plane)];
+}
+
+template <typename T>
+bool FrustumG<T>::Contains(const Vector3G<T> &point) const
+{
+    for (const auto &plane : m_planes)
+    {
+        if (Vector3G<T>::Dot(plane.xyz(), point) + plane.w < 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+CullResult FrustumG<T>::Cull(const AABoxG<T> &aaBox,
+                             int *planeMask,
+                             int *outsidePlane) const
+{
+    const auto center = aaBox.GetCenter();
+    const auto extents = aaBox.GetExtents();
+    const auto getDistanceAndRadius =
+        [&](const Vector4G<T> &plane, T *distance, T *radius) {
+            *distance = Vector3G<T>::Dot(plane.xyz(), center) + plane.w;
+            *radius = Math::Abs(plane.x) * extents.x +
+                      Math::Abs(plane.y) * extents.y +
+                      Math::Abs(plane.z) * extents.z;
+        };
+    return CullPlanes(getDistanceAndRadius, planeMask, outsidePlane);
+}
+
+template <typename T>
+CullResult FrustumG<T>::Cull(const SphereG<T> &sphere,
+                             int *planeMask,
+                             int *outsidePlane) const
+{
+    const auto getDistanceAndRadius =
+        [&](const Vector4G<T> &plane, T *distance, T *radius) {
+            *distance =
+                Vector3G<T>::Dot(plane.xyz(), sphere.GetCenter()) + plane.w;
+            *radius = sphere.GetRadius();
+        };
+    return CullPlanes(getDistanceAndRadius, planeMask, outsidePlane);
+}
+
+template <typename T>
+void FrustumG<T>::Cull(const AABoxG<T> *aaBoxes,
+                       std::size_t count,
+                       CullResult *resultsOut) const
+{
+    using SIMD = SIMD4G<T>;
+
+    SIMD planeX[NumPlanes], planeY[NumPlanes], planeZ[NumPlanes];
+    SIMD planeW[NumPlanes];
+    SIMD absPlaneX[NumPlanes], absPlaneY[NumPlanes], absPlaneZ[NumPlanes];
+    for (int p = 0; p < NumPlanes; ++p)
+    {
+        planeX[p] = SIMD(m_planes[p].x);
+        planeY[p] = SIMD(m_planes[p].y);
+        planeZ[p] = SIMD(m_planes[p].z);
+        planeW[p] = SIMD(m_planes[p].w);
+        absPlaneX[p] = SIMD(Math::Abs(m_planes[p].x));
+        absPlaneY[p] = SIMD(Math::Abs(m_planes[p].y));
+        absPlaneZ[p] = SIMD(Math::Abs(m_planes[p].z));
+    }
+
+    const SIMD zero(T(0));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+
+        T centers[3][4] = {}, extents[3][4] = {};
+        for (std::size_t j = 0; j < blockCount; ++j)
+        {
+            const auto center = aaBoxes[i + j].GetCenter();
+            const auto extent = aaBoxes[i + j].GetExtents();
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                centers[axis][j] = center[axis];
+                extents[axis][j] = extent[axis];
+            }
+        }
+
+        const SIMD cx = SIMD::Load(centers[0]);
+        const SIMD cy = SIMD::Load(centers[1]);
+        const SIMD cz = SIMD::Load(centers[2]);
+        const SIMD ex = SIMD::Load(extents[0]);
+        const SIMD ey = SIMD::Load(extents[1]);
+        const SIMD ez = SIMD::Load(extents[2]);
+
+        int outsideMask = 0, intersectingMask = 0;
+        for (int p = 0; p < NumPlanes; ++p)
+        {
+            const SIMD distance =
+                cx * planeX[p] + cy * planeY[p] + cz * planeZ[p] + planeW[p];
+            const SIMD radius =
+                ex * absPlaneX[p] + ey * absPlaneY[p] + ez * absPlaneZ[p];
+            outsideMask |= SIMD::LessMask(distance + radius, zero);
+            intersectingMask |= SIMD::LessMask(distance - radius, zero);
+        }
+
+        StoreResults(
+            outsideMask, intersectingMask, blockCount, resultsOut + i);
+    }
+}
+
+template <typename T>
+void FrustumG<T>::Cull(const SphereG<T> *spheres,
+                       std::size_t count,
+                       CullResult *resultsOut) const
+{
+    using SIMD = SIMD4G<T>;
+
+    SIMD planeX[NumPlanes], planeY[NumPlanes], planeZ[NumPlanes];
+    SIMD planeW[NumPlanes];
+    for (int p = 0; p < NumPlanes; ++p)
+    {
+        planeX[p] = SIMD(m_planes[p].x);
+        planeY[p] = SIMD(m_planes[p].y);
+        planeZ[p] = SIMD(m_planes[p].z);
+        planeW[p] = SIMD(m_planes[p].w);
+    }
+
+    const SIMD zero(T(0));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+
+        T centers[3][4] = {}, radii[4] = {};
+        for (std::size_t j = 0; j < blockCount; ++j)
+        {
+            const auto &center = spheres[i + j].GetCenter();
+            for (int axis = 0; axis < 3; ++axis)
+            {
+                centers[axis][j] = center[axis];
+            }
+            radii[j] = spheres[i + j].GetRadius();
+        }
+
+        const SIMD cx = SIMD::Load(centers[0]);
+        const SIMD cy = SIMD::Load(centers[1]);
+        const SIMD cz = SIMD::Load(centers[2]);
+        const SIMD radius = SIMD::Load(radii);
+
+        int outsideMask = 0, intersectingMask = 0;
+        for (int p = 0; p < NumPlanes; ++p)
+        {
+            const SIMD distance =
+                cx * planeX[p] + cy * planeY[p] + cz * planeZ[p] + planeW[p];
+            outsideMask |= SIMD::LessMask(distance + radius, zero);
+            intersectingMask |= SIMD::LessMask(distance - radius, zero);
+        }
+
+        StoreResults(
+            outsideMask, intersectingMask, blockCount, resultsOut + i);
+    }
+}
+
+template <typename T>
+template <class DistanceFunction>
+CullResult FrustumG<T>::CullPlanes(DistanceFunction getDistanceAndRadius,
+                                   int *planeMask,
+                                   int *outsidePlane) const
+{
+    int mask = (planeMask ? *planeMask : AllPlanesMask);
+    const int firstPlane =
+        (outsidePlane && *outsidePlane >= 0 && *outsidePlane < NumPlanes)
+            ? *outsidePlane
+            : 0;
+
+    CullResult result = CullResult::INSIDE;
+    for (int k = 0; k < NumPlanes; ++k)
+    {
+        const int p = (firstPlane + k) % NumPlanes;
+        if ((mask & (1 << p)) == 0)
+        {
+            continue;
+        }
+
+        T distance, radius;
+        getDistanceAndRadius(m_planes[p], &distance, &radius);
+        if (distance + radius < 0)
+        {
+            if (outsidePlane)
+            {
+                *outsidePlane = p;
+            }
+            return CullResult::OUTSIDE;
+        }
+
+        if (distance - radius >= 0)
+        {
+            // Completely inside this plane, so are the children
+            mask &= ~(1 << p);
+        }
+        else
+        {
+            result = CullResult::INTERSECTING;
+        }
+    }
+
+    if (planeMask)
+    {
+        *planeMask = mask;
+    }
+    return result;
+}
+
+template <typename T>
+void FrustumG<T>::StoreResults(int outsideMask,
+                               int intersectingMask,
+                               std::size_t count,
+                               CullResult *resultsOut)
+{
+    for (std::size_t j = 0; j < count; ++j)
+    {
+        const int bit = (1 << j);
+        if (outsideMask & bit)
+        {
+            resultsOut[j] = CullResult::OUTSIDE;
+        }
+        else if (intersectingMask & bit)
+        {
+            resultsOut[j] = CullResult::INTERSECTING;
+        }
+        else
+        {
+            resultsOut[j] = CullResult::INSIDE;
+        }
+    }
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <vector>
 
 #include "BangMath/Orientation.h"
@@ -12,6 +13,8 @@ class AABoxG;
 template <typename>
 class BoxG;
 template <typename>
+class ContactManifoldG;
+template <typename>
 class PlaneG;
 template <typename>
 class PolygonG;
@@ -80,6 +83,14 @@ public:
                                   bool *intersected,
                                   T *intersectionDistance);
 
+    // Slab test in the box local space. Only hits in front of the ray
+    // origin count, with a distance of 0 if the origin is inside the box.
+    template <typename T>
+    static void IntersectRayBox(const RayG<T> &ray,
+                                const BoxG<T> &box,
+                                bool *intersected,
+                                T *intersectionDistance);
+
     // Computes the intersection between a ray and a sphere
     template <typename T>
     static void IntersectRaySphere(const RayG<T> &ray,
@@ -151,6 +162,23 @@ public:
         const std::array<QuadG<T>, 6> &box0,
         const std::array<QuadG<T>, 6> &box1);
 
+    // Contact manifold between two boxes, from the separating axis test and
+    // the clipping of the incident face against the reference face. Fills
+    // the manifold without allocating, with the normal pointing from the
+    // first box to the second one. Returns false if they do not overlap.
+    template <typename T>
+    static bool IntersectBoxBox(const BoxG<T> &box0,
+                                const BoxG<T> &box1,
+                                ContactManifoldG<T> *manifold);
+    template <typename T>
+    static bool IntersectBoxAABox(const BoxG<T> &box,
+                                  const AABoxG<T> &aaBox,
+                                  ContactManifoldG<T> *manifold);
+    template <typename T>
+    static bool IntersectAABoxAABox(const AABoxG<T> &aaBox0,
+                                    const AABoxG<T> &aaBox1,
+                                    ContactManifoldG<T> *manifold);
+
     template <typename T>
     static bool IsPointInsideBox(const Vector3G<T> &p,
                                  const std::array<QuadG<T>, 6> &box);
@@ -197,15 +225,50 @@ public:
     static Vector3G<T> PointProjectedToSphere(const Vector3G<T> &point,
                                               const SphereG<T> &sphere);
 
+    // Tolerance of the geometric tests. The separating axis tests, BoxG ones
+    // included, add it to the rotation terms to avoid false separations of
+    // near parallel axes.
+    template <typename T>
+    static constexpr T Epsilon()
+    {
+        return static_cast<T>(1e-5);
+    }
+
     Geometry() = delete;
     virtual ~Geometry() = delete;
 
 private:
+    // Center, unit axes and half extents of an oriented box
     template <typename T>
-    static constexpr T Epsilon()
+    struct BoxFrame
     {
-        return static_cast<T>(1e-5);
-    }
+        Vector3G<T> center;
+        std::array<Vector3G<T>, 3> axes;
+        Vector3G<T> extents;
+    };
+
+    template <typename T>
+    static BoxFrame<T> GetBoxFrame(const BoxG<T> &box);
+    template <typename T>
+    static BoxFrame<T> GetBoxFrame(const AABoxG<T> &aaBox);
+
+    template <typename T>
+    static bool IntersectBoxFrames(const BoxFrame<T> &box0,
+                                   const BoxFrame<T> &box1,
+                                   ContactManifoldG<T> *manifold);
+    template <typename T>
+    static void ClipIncidentFace(const BoxFrame<T> &referenceBox,
+                                 int referenceAxis,
+                                 const Vector3G<T> &referenceNormal,
+                                 const BoxFrame<T> &incidentBox,
+                                 ContactManifoldG<T> *manifold);
+    // Keeps the part of the polygon where Dot(normal, p) <= offset
+    template <typename T>
+    static std::size_t ClipPolygon(const std::array<Vector3G<T>, 8> &polygon,
+                                   std::size_t numPoints,
+                                   const Vector3G<T> &normal,
+                                   T offset,
+                                   std::array<Vector3G<T>, 8> *clippedOut);
 };
 }
 
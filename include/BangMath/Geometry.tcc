@@ -5,6 +5,7 @@
 #include <vector>
 
 #include "BangMath/Axis.h"
+#include "BangMath/ContactManifold.h"
 #include "BangMath/Math.h"
 
 namespace Bang
@@ -203,6 +204,52 @@ void Geometry::IntersectRayAABox(const RayG<T> &ray,
     *intersectionDistance = tmin;
 }
 
+template <typename T>
+void Geometry::IntersectRayBox(const RayG<T> &ray,
+                               const BoxG<T> &box,
+                               bool *intersected,
+                               T *intersectionDistance)
+{
+    const auto origin = box.ToLocalSpace(ray.GetOrigin());
+    const auto direction = box.ToLocalDirection(ray.GetDirection());
+    const auto &extents = box.GetLocalExtents();
+
+    T tMin = 0;
+    T tMax = Math::Infinity<T>();
+    for (int i = 0; i < 3; ++i)
+    {
+        if (Math::Abs(direction[i]) < Epsilon<T>())
+        {
+            // Parallel to the slab, must start inside it
+            if (Math::Abs(origin[i]) > extents[i])
+            {
+                *intersected = false;
+                return;
+            }
+            continue;
+        }
+
+        const T invDirection = static_cast<T>(1) / direction[i];
+        T t0 = (-extents[i] - origin[i]) * invDirection;
+        T t1 = (extents[i] - origin[i]) * invDirection;
+        if (t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+
+        tMin = Math::Max(tMin, t0);
+        tMax = Math::Min(tMax, t1);
+        if (tMin > tMax)
+        {
+            *intersected = false;
+            return;
+        }
+    }
+
+    *intersected = true;
+    *intersectionDistance = tMin;
+}
+
 // https://www.scratchapixel.com/lessons/3d-basic-rendering/
 // minimal-ray-tracer-rendering-simple-shapes/ray-sphere-intersection
 template <typename T>
@@ -657,6 +704,34 @@ std::vector<Vector3G<T>> Geometry::IntersectBoxBox(
     return result;
 }
 
+template <typename T>
+bool Geometry::IntersectBoxBox(const BoxG<T> &box0,
+                               const BoxG<T> &box1,
+                               ContactManifoldG<T> *manifold)
+{
+    return Geometry::IntersectBoxFrames(
+        Geometry::GetBoxFrame(box0), Geometry::GetBoxFrame(box1), manifold);
+}
+
+template <typename T>
+bool Geometry::IntersectBoxAABox(const BoxG<T> &box,
+                                 const AABoxG<T> &aaBox,
+                                 ContactManifoldG<T> *manifold)
+{
+    return Geometry::IntersectBoxFrames(
+        Geometry::GetBoxFrame(box), Geometry::GetBoxFrame(aaBox), manifold);
+}
+
+template <typename T>
+bool Geometry::IntersectAABoxAABox(const AABoxG<T> &aaBox0,
+                                   const AABoxG<T> &aaBox1,
+                                   ContactManifoldG<T> *manifold)
+{
+    return Geometry::IntersectBoxFrames(Geometry::GetBoxFrame(aaBox0),
+                                        Geometry::GetBoxFrame(aaBox1),
+                                        manifold);
+}
+
 template <typename T>
 bool Geometry::IsPointInsideBox(const Vector3G<T> &p,
                                 const std::array<QuadG<T>, 6> &box)
@@ -776,4 +851,297 @@ Vector3G<T> Geometry::PointProjectedToSphere(const Vector3G<T> &point,
         closestRayPointToSphereV.Normalized();
     return sphere.GetCenter() - closestRayPointToSphereDir * sphere.GetRadius();
 }
+
+template <typename T>
+Geometry::BoxFrame<T> Geometry::GetBoxFrame(const BoxG<T> &box)
+{
+    BoxFrame<T> frame;
+    frame.center = box.GetCenter();
+    frame.axes = box.GetAxes();
+    frame.extents = box.GetLocalExtents();
+    return frame;
+}
+
+template <typename T>
+Geometry::BoxFrame<T> Geometry::GetBoxFrame(const AABoxG<T> &aaBox)
+{
+    BoxFrame<T> frame;
+    frame.center = aaBox.GetCenter();
+    frame.axes[0] = Vector3G<T>(1, 0, 0);
+    frame.axes[1] = Vector3G<T>(0, 1, 0);
+    frame.axes[2] = Vector3G<T>(0, 0, 1);
+    frame.extents = aaBox.GetExtents();
+    return frame;
+}
+
+template <typename T>
+bool Geometry::IntersectBoxFrames(const BoxFrame<T> &box0,
+                                  const BoxFrame<T> &box1,
+                                  ContactManifoldG<T> *manifold)
+{
+    manifold->Clear();
+
+    const Vector3G<T> &e0 = box0.extents;
+    const Vector3G<T> &e1 = box1.extents;
+    for (int i = 0; i < 3; ++i)
+    {
+        if (e0[i] < 0 || e1[i] < 0)  // Empty boxes
+        {
+            return false;
+        }
+    }
+
+    // Rotation of box1 axes into box0 axes. Epsilon avoids false separations
+    // from the (null) cross products of parallel edges.
+    T absR[3][3];
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            absR[i][j] = Math::Abs(Vector3G<T>::Dot(box0.axes[i],
+                                                    box1.axes[j])) +
+                         Epsilon<T>();
+        }
+    }
+
+    // Separating axis test. Keep the axis of minimum penetration, which is
+    // the one with the largest (negative) separation.
+    const Vector3G<T> d = box1.center - box0.center;
+    T bestSeparation = -Math::Infinity<T>();
+    int bestAxis = -1;
+    Vector3G<T> bestNormal;
+
+    // Face axes of box0 (0 to 2) and of box1 (3 to 5)
+    for (int i = 0; i < 3; ++i)
+    {
+        const T dist = Vector3G<T>::Dot(d, box0.axes[i]);
+        const T r1 = e1[0] * absR[i][0] + e1[1] * absR[i][1] +
+                     e1[2] * absR[i][2];
+        const T separation = Math::Abs(dist) - (e0[i] + r1);
+        if (separation > 0)
+        {
+            return false;
+        }
+        if (separation > bestSeparation)
+        {
+            bestSeparation = separation;
+            bestAxis = i;
+            bestNormal = (dist < 0) ? -box0.axes[i] : box0.axes[i];
+        }
+    }
+    for (int j = 0; j < 3; ++j)
+    {
+        const T dist = Vector3G<T>::Dot(d, box1.axes[j]);
+        const T r0 = e0[0] * absR[0][j] + e0[1] * absR[1][j] +
+                     e0[2] * absR[2][j];
+        const T separation = Math::Abs(dist) - (r0 + e1[j]);
+        if (separation > 0)
+        {
+            return false;
+        }
+        if (separation > bestSeparation)
+        {
+            bestSeparation = separation;
+            bestAxis = 3 + j;
+            bestNormal = (dist < 0) ? -box1.axes[j] : box1.axes[j];
+        }
+    }
+
+    // Edge axes (6 + 3 * i + j). They must be clearly better than the face
+    // axes to be picked, which keeps resting contacts stable.
+    const T faceSeparation = bestSeparation;
+    for (int i = 0; i < 3; ++i)
+    {
+        for (int j = 0; j < 3; ++j)
+        {
+            Vector3G<T> axis =
+                Vector3G<T>::Cross(box0.axes[i], box1.axes[j]);
+            const T axisLength = axis.Length();
+            if (axisLength < Epsilon<T>())
+            {
+                continue;  // Parallel edges, covered by the face axes
+            }
+            axis /= axisLength;
+
+            const T dist = Vector3G<T>::Dot(d, axis);
+            T r0 = 0, r1 = 0;
+            for (int k = 0; k < 3; ++k)
+            {
+                r0 += e0[k] * Math::Abs(Vector3G<T>::Dot(box0.axes[k], axis));
+                r1 += e1[k] * Math::Abs(Vector3G<T>::Dot(box1.axes[k], axis));
+            }
+            const T separation = Math::Abs(dist) - (r0 + r1);
+            if (separation > 0)
+            {
+                return false;
+            }
+            if (separation > bestSeparation &&
+                separation > static_cast<T>(0.95) * faceSeparation +
+                                 Epsilon<T>())
+            {
+                bestSeparation = separation;
+                bestAxis = 6 + 3 * i + j;
+                bestNormal = (dist < 0) ? -axis : axis;
+            }
+        }
+    }
+
+    // Every separation was NaN: degenerate or NaN boxes
+    if (bestAxis < 0)
+    {
+        return false;
+    }
+
+    manifold->SetNormal(bestNormal);
+    if (bestAxis < 3)
+    {
+        Geometry::ClipIncidentFace(
+            box0, bestAxis, bestNormal, box1, manifold);
+    }
+    else if (bestAxis < 6)
+    {
+        Geometry::ClipIncidentFace(
+            box1, bestAxis - 3, -bestNormal, box0, manifold);
+    }
+    else
+    {
+        // Edge-edge: single contact between the closest points of the edge
+        // of box0 furthest along the normal and the edge of box1 furthest
+        // against it
+        const int i = (bestAxis - 6) / 3;
+        const int j = (bestAxis - 6) % 3;
+        Vector3G<T> p0 = box0.center;
+        Vector3G<T> p1 = box1.center;
+        for (int k = 0; k < 3; ++k)
+        {
+            if (k != i)
+            {
+                const bool along =
+                    (Vector3G<T>::Dot(box0.axes[k], bestNormal) > 0);
+                p0 += box0.axes[k] * (along ? e0[k] : -e0[k]);
+            }
+            if (k != j)
+            {
+                const bool along =
+                    (Vector3G<T>::Dot(box1.axes[k], bestNormal) > 0);
+                p1 += box1.axes[k] * (along ? -e1[k] : e1[k]);
+            }
+        }
+
+        const Vector3G<T> &dir0 = box0.axes[i];
+        const Vector3G<T> &dir1 = box1.axes[j];
+        const Vector3G<T> w = p0 - p1;
+        const T b = Vector3G<T>::Dot(dir0, dir1);
+        const T d0 = Vector3G<T>::Dot(dir0, w);
+        const T d1 = Vector3G<T>::Dot(dir1, w);
+        const T denom = static_cast<T>(1) - b * b;
+        const T s = Math::Clamp((b * d1 - d0) / denom, -e0[i], e0[i]);
+        const T t = Math::Clamp((d1 - b * d0) / denom, -e1[j], e1[j]);
+        const Vector3G<T> closest0 = p0 + dir0 * s;
+        const Vector3G<T> closest1 = p1 + dir1 * t;
+        manifold->AddPoint((closest0 + closest1) / static_cast<T>(2),
+                           -bestSeparation);
+    }
+
+    return !manifold->IsEmpty();
+}
+
+template <typename T>
+void Geometry::ClipIncidentFace(const BoxFrame<T> &referenceBox,
+                                int referenceAxis,
+                                const Vector3G<T> &referenceNormal,
+                                const BoxFrame<T> &incidentBox,
+                                ContactManifoldG<T> *manifold)
+{
+    // Incident face: the face of the incident box most anti-parallel to the
+    // reference normal
+    int incidentAxis = 0;
+    T maxAbsDot = -1;
+    for (int k = 0; k < 3; ++k)
+    {
+        const T absDot = Math::Abs(
+            Vector3G<T>::Dot(incidentBox.axes[k], referenceNormal));
+        if (absDot > maxAbsDot)
+        {
+            maxAbsDot = absDot;
+            incidentAxis = k;
+        }
+    }
+    const Vector3G<T> &incidentAxisDir = incidentBox.axes[incidentAxis];
+    const T incidentSign =
+        (Vector3G<T>::Dot(incidentAxisDir, referenceNormal) > 0) ? -1 : 1;
+    const Vector3G<T> faceCenter =
+        incidentBox.center +
+        incidentAxisDir * (incidentSign * incidentBox.extents[incidentAxis]);
+    const int u = (incidentAxis + 1) % 3;
+    const int v = (incidentAxis + 2) % 3;
+    const Vector3G<T> eu = incidentBox.axes[u] * incidentBox.extents[u];
+    const Vector3G<T> ev = incidentBox.axes[v] * incidentBox.extents[v];
+
+    std::array<Vector3G<T>, 8> polygon, clipped;
+    polygon[0] = faceCenter + eu + ev;
+    polygon[1] = faceCenter - eu + ev;
+    polygon[2] = faceCenter - eu - ev;
+    polygon[3] = faceCenter + eu - ev;
+    std::size_t numPoints = 4;
+
+    // Clip against the four side planes of the reference face
+    for (int side = 1; side <= 2 && numPoints > 0; ++side)
+    {
+        const int a = (referenceAxis + side) % 3;
+        const Vector3G<T> &axis = referenceBox.axes[a];
+        const T center = Vector3G<T>::Dot(referenceBox.center, axis);
+        const T extent = referenceBox.extents[a];
+        numPoints = Geometry::ClipPolygon(
+            polygon, numPoints, axis, center + extent, &clipped);
+        numPoints = Geometry::ClipPolygon(
+            clipped, numPoints, -axis, -center + extent, &polygon);
+    }
+
+    // Keep the points below the reference face
+    const T faceOffset =
+        Vector3G<T>::Dot(referenceBox.center, referenceNormal) +
+        referenceBox.extents[referenceAxis];
+    for (std::size_t k = 0; k < numPoints; ++k)
+    {
+        const Vector3G<T> &p = polygon[k];
+        const T penetration =
+            faceOffset - Vector3G<T>::Dot(p, referenceNormal);
+        if (penetration >= 0)
+        {
+            manifold->AddPoint(
+                p + referenceNormal * (penetration / static_cast<T>(2)),
+                penetration);
+        }
+    }
+}
+
+template <typename T>
+std::size_t Geometry::ClipPolygon(const std::array<Vector3G<T>, 8> &polygon,
+                                  std::size_t numPoints,
+                                  const Vector3G<T> &normal,
+                                  T offset,
+                                  std::array<Vector3G<T>, 8> *clippedOut)
+{
+    // Sutherland-Hodgman. Clipping a convex polygon adds one point at most,
+    // so a quad clipped four times fits in 8 points.
+    std::size_t numClipped = 0;
+    for (std::size_t i = 0; i < numPoints; ++i)
+    {
+        const Vector3G<T> &p = polygon[i];
+        const Vector3G<T> &q = polygon[(i + 1) % numPoints];
+        const T dp = Vector3G<T>::Dot(normal, p) - offset;
+        const T dq = Vector3G<T>::Dot(normal, q) - offset;
+        if (dp <= 0 && numClipped < clippedOut->size())
+        {
+            (*clippedOut)[numClipped++] = p;
+        }
+        if (((dp < 0 && dq > 0) || (dp > 0 && dq < 0)) &&
+            numClipped < clippedOut->size())
+        {
+            (*clippedOut)[numClipped++] = p + (q - p) * (dp / (dp - dq));
+        }
+    }
+    return numClipped;
+}
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class Vector2G;
+template <typename>
+class Vector3G;
+
+// Static k-d tree over 2D or 3D points, for nearest neighbour and radius
+// searches (snapping, point cloud registration...). Use KDTreeG for
+// Vector3G points and KDTree2DG for Vector2G points.
+//
+// The tree is implicit: Build() reorders a copy of the points so that the
+// median of every range splits it along its widest axis, with the lower half
+// before it and the upper half after it. Ranges of up to LeafSize points
+// are leaves, scanned linearly. No nodes or pointers are stored, so the
+// queries walk a flat array. Building takes O(N log N).
+//
+// Points are reported by their index in the built array.
+template <typename T, int Dimensions>
+class KDTreeNG
+{
+public:
+    using Point = typename std::
+        conditional<Dimensions == 2, Vector2G<T>, Vector3G<T>>::type;
+    static constexpr std::size_t NullIndex =
+        std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t LeafSize = 8;
+
+    void Build(const std::vector<Point> &points);
+    void Build(const Point *points, std::size_t count);
+    void Clear();
+
+    // Index of the closest point, NullIndex if the tree is empty
+    std::size_t GetNearest(const Point &point,
+                           T *sqDistanceOut = nullptr) const;
+
+    // Appends the k closest points, closest first, and their squared
+    // distances if sqDistancesOut is not null. With epsilon > 0 the search
+    // is approximate: the i-th point returned is at most (1 + epsilon) times
+    // farther than the true i-th closest, visiting far fewer nodes.
+    void QueryKNearest(const Point &point,
+                       std::size_t k,
+                       std::vector<std::size_t> *indicesOut,
+                       std::vector<T> *sqDistancesOut = nullptr,
+                       T epsilon = T(0)) const;
+
+    // Batch version, writing k results per query to indicesOut (and
+    // sqDistancesOut if not null), closest first. Slots beyond the number of
+    // points get NullIndex. The queries are split in tiles that numThreads
+    // threads pick in order, 0 using as many as the hardware supports.
+    void QueryKNearest(const Point *points,
+                       std::size_t count,
+                       std::size_t k,
+                       std::size_t *indicesOut,
+                       T *sqDistancesOut = nullptr,
+                       std::size_t numThreads = 1,
+                       T epsilon = T(0)) const;
+
+    // Appends the points closer than radius
+    void QueryRadius(const Point &point,
+                     T radius,
+                     std::vector<std::size_t> *indicesOut) const;
+
+    // Calls visitor(index, sqDistance) for the points closer than radius
+    template <class Visitor>
+    void VisitRadius(const Point &point, T radius, Visitor visitor) const;
+
+    bool IsEmpty() const;
+    std::size_t GetPointCount() const;
+
+private:
+    struct Entry
+    {
+        Point point;
+        std::uint32_t index;
+    };
+
+    // Range of entries to visit, and a lower bound of its squared distance
+    struct Range
+    {
+        std::uint32_t begin;
+        std::uint32_t end;
+        T sqDistance;
+    };
+
+    // Queries handed to a thread at a time in the batch version
+    static constexpr std::size_t QueriesPerTile = 64;
+
+    std::vector<Entry> m_entries;
+    // Split axis of the ranges whose median is at each position
+    std::vector<std::uint8_t> m_splitAxes;
+
+    void BuildRange(std::size_t begin, std::size_t end);
+
+    // Calls visitEntry(entry, sqDistance) for the entries of every range
+    // whose distance bound, scaled by boundScale, is below getMaxSqDistance()
+    template <class GetMaxSqDistance, class VisitEntry>
+    void Traverse(const Point &point,
+                  T boundScale,
+                  const GetMaxSqDistance &getMaxSqDistance,
+                  const VisitEntry &visitEntry) const;
+
+    // Max heap of the k closest found, by squared distance
+    void SearchKNearest(const Point &point,
+                        std::size_t k,
+                        T epsilon,
+                        std::vector<std::pair<T, std::size_t>> *closest) const;
+};
+
+template <typename T>
+using KDTreeG = KDTreeNG<T, 3>;
+template <typename T>
+using KDTree2DG = KDTreeNG<T, 2>;
+
+BANG_MATH_DEFINE_USINGS(KDTree)
+BANG_MATH_DEFINE_USINGS(KDTree2D)
+}
+
+#include "BangMath/KDTree.tcc"
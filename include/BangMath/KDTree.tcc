@@ -0,0 +1,306 @@
+#include "BangMath/KDTree.h"
+
+#include <algorithm>
+
+#include "BangMath/Math.h"
+#include "BangMath/Parallel.h"
+#include "BangMath/Vector2.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T, int Dimensions>
+constexpr std::size_t KDTreeNG<T, Dimensions>::NullIndex;
+
+template <typename T, int Dimensions>
+constexpr std::size_t KDTreeNG<T, Dimensions>::LeafSize;
+
+template <typename T, int Dimensions>
+constexpr std::size_t KDTreeNG<T, Dimensions>::QueriesPerTile;
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::Build(const std::vector<Point> &points)
+{
+    Build(points.data(), points.size());
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::Build(const Point *points, std::size_t count)
+{
+    m_entries.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        m_entries[i].point = points[i];
+        m_entries[i].index = static_cast<std::uint32_t>(i);
+    }
+    m_splitAxes.assign(count, 0);
+    BuildRange(0, count);
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::Clear()
+{
+    m_entries.clear();
+    m_splitAxes.clear();
+}
+
+template <typename T, int Dimensions>
+std::size_t KDTreeNG<T, Dimensions>::GetNearest(const Point &point,
+                                                T *sqDistanceOut) const
+{
+    std::vector<std::pair<T, std::size_t>> closest;
+    SearchKNearest(point, 1, T(0), &closest);
+    if (closest.empty())
+    {
+        return NullIndex;
+    }
+
+    if (sqDistanceOut)
+    {
+        *sqDistanceOut = closest[0].first;
+    }
+    return closest[0].second;
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::QueryKNearest(
+    const Point &point,
+    std::size_t k,
+    std::vector<std::size_t> *indicesOut,
+    std::vector<T> *sqDistancesOut,
+    T epsilon) const
+{
+    std::vector<std::pair<T, std::size_t>> closest;
+    SearchKNearest(point, k, epsilon, &closest);
+    for (const auto &neighbour : closest)
+    {
+        indicesOut->push_back(neighbour.second);
+        if (sqDistancesOut)
+        {
+            sqDistancesOut->push_back(neighbour.first);
+        }
+    }
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::QueryKNearest(const Point *points,
+                                            std::size_t count,
+                                            std::size_t k,
+                                            std::size_t *indicesOut,
+                                            T *sqDistancesOut,
+                                            std::size_t numThreads,
+                                            T epsilon) const
+{
+    const std::size_t numTiles = (count + QueriesPerTile - 1) / QueriesPerTile;
+    numThreads = Parallel::GetThreadCount(numThreads, numTiles);
+
+    // Search heap of each thread
+    std::vector<std::vector<std::pair<T, std::size_t>>> threadClosest(
+        numThreads);
+    Parallel::ForTiles(
+        count,
+        QueriesPerTile,
+        numThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t thread) {
+            std::vector<std::pair<T, std::size_t>> &closest =
+                threadClosest[thread];
+            for (std::size_t query = begin; query < end; ++query)
+            {
+                SearchKNearest(points[query], k, epsilon, &closest);
+                for (std::size_t i = 0; i < k; ++i)
+                {
+                    const bool found = (i < closest.size());
+                    indicesOut[query * k + i] =
+                        (found ? closest[i].second : NullIndex);
+                    if (sqDistancesOut)
+                    {
+                        sqDistancesOut[query * k + i] =
+                            (found ? closest[i].first
+                                   : std::numeric_limits<T>::max());
+                    }
+                }
+            }
+        });
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::QueryRadius(
+    const Point &point,
+    T radius,
+    std::vector<std::size_t> *indicesOut) const
+{
+    VisitRadius(point, radius, [indicesOut](std::size_t index, T) {
+        indicesOut->push_back(index);
+    });
+}
+
+template <typename T, int Dimensions>
+template <class Visitor>
+void KDTreeNG<T, Dimensions>::VisitRadius(const Point &point,
+                                          T radius,
+                                          Visitor visitor) const
+{
+    const T sqRadius = radius * radius;
+    Traverse(point,
+             T(1),
+             [sqRadius]() { return sqRadius; },
+             [&](const Entry &entry, T sqDistance) {
+                 if (sqDistance <= sqRadius)
+                 {
+                     visitor(static_cast<std::size_t>(entry.index),
+                             sqDistance);
+                 }
+             });
+}
+
+template <typename T, int Dimensions>
+bool KDTreeNG<T, Dimensions>::IsEmpty() const
+{
+    return m_entries.empty();
+}
+
+template <typename T, int Dimensions>
+std::size_t KDTreeNG<T, Dimensions>::GetPointCount() const
+{
+    return m_entries.size();
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::BuildRange(std::size_t begin, std::size_t end)
+{
+    const std::size_t count = end - begin;
+    if (count <= LeafSize)
+    {
+        return;
+    }
+
+    Point min = m_entries[begin].point;
+    Point max = min;
+    for (std::size_t i = begin + 1; i < end; ++i)
+    {
+        min = Point::Min(min, m_entries[i].point);
+        max = Point::Max(max, m_entries[i].point);
+    }
+    const Point extents = max - min;
+    std::size_t axis = 0;
+    for (std::size_t i = 1; i < std::size_t(Dimensions); ++i)
+    {
+        if (extents[i] > extents[axis])
+        {
+            axis = i;
+        }
+    }
+
+    const std::size_t mid = begin + count / 2;
+    std::nth_element(m_entries.begin() + begin,
+                     m_entries.begin() + mid,
+                     m_entries.begin() + end,
+                     [axis](const Entry &lhs, const Entry &rhs) {
+                         return lhs.point[axis] < rhs.point[axis];
+                     });
+    m_splitAxes[mid] = static_cast<std::uint8_t>(axis);
+
+    BuildRange(begin, mid);
+    BuildRange(mid + 1, end);
+}
+
+// Depth first, visiting the side of the median where the point is first. The
+// other side is pushed with the distance to the splitting plane as its bound
+// and skipped when popped if it can no longer have closer points.
+template <typename T, int Dimensions>
+template <class GetMaxSqDistance, class VisitEntry>
+void KDTreeNG<T, Dimensions>::Traverse(
+    const Point &point,
+    T boundScale,
+    const GetMaxSqDistance &getMaxSqDistance,
+    const VisitEntry &visitEntry) const
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    // One range pushed per level, at most 32 levels for 32 bit indices
+    Range stack[64];
+    int stackSize = 0;
+    Range range = {0, static_cast<std::uint32_t>(m_entries.size()), T(0)};
+    while (true)
+    {
+        while (range.sqDistance * boundScale <= getMaxSqDistance())
+        {
+            const std::uint32_t count = range.end - range.begin;
+            if (count <= LeafSize)
+            {
+                for (std::uint32_t i = range.begin; i < range.end; ++i)
+                {
+                    const Entry &entry = m_entries[i];
+                    visitEntry(entry, Point::SqDistance(entry.point, point));
+                }
+                break;
+            }
+
+            const std::uint32_t mid = range.begin + count / 2;
+            const Entry &median = m_entries[mid];
+            visitEntry(median, Point::SqDistance(median.point, point));
+
+            const std::size_t axis = m_splitAxes[mid];
+            const T diff = point[axis] - median.point[axis];
+            const T planeSqDistance =
+                Math::Max(range.sqDistance, diff * diff);
+            const Range lower = {range.begin, mid, range.sqDistance};
+            const Range upper = {mid + 1, range.end, range.sqDistance};
+            Range far = (diff < 0 ? upper : lower);
+            far.sqDistance = planeSqDistance;
+            if (far.begin < far.end &&
+                far.sqDistance * boundScale <= getMaxSqDistance())
+            {
+                stack[stackSize++] = far;
+            }
+            range = (diff < 0 ? lower : upper);
+        }
+
+        if (stackSize == 0)
+        {
+            break;
+        }
+        range = stack[--stackSize];
+    }
+}
+
+template <typename T, int Dimensions>
+void KDTreeNG<T, Dimensions>::SearchKNearest(
+    const Point &point,
+    std::size_t k,
+    T epsilon,
+    std::vector<std::pair<T, std::size_t>> *closest) const
+{
+    closest->clear();
+    if (k == 0)
+    {
+        return;
+    }
+
+    const auto getMaxSqDistance = [closest, k]() {
+        return (closest->size() < k ? std::numeric_limits<T>::max()
+                                    : closest->front().first);
+    };
+    const auto visitEntry = [closest, k](const Entry &entry, T sqDistance) {
+        const std::size_t index = entry.index;
+        if (closest->size() < k)
+        {
+            closest->emplace_back(sqDistance, index);
+            std::push_heap(closest->begin(), closest->end());
+        }
+        else if (sqDistance < closest->front().first)
+        {
+            std::pop_heap(closest->begin(), closest->end());
+            closest->back() = std::make_pair(sqDistance, index);
+            std::push_heap(closest->begin(), closest->end());
+        }
+    };
+
+    const T boundScale = (T(1) + epsilon) * (T(1) + epsilon);
+    Traverse(point, boundScale, getMaxSqDistance, visitEntry);
+    std::sort_heap(closest->begin(), closest->end());
+}
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename>
+class Matrix3G;
+template <typename>
+class Matrix4G;
+template <typename>
+class QuaternionG;
+
+// Affine transform matrix: a Matrix4G without its constant last row
+// (0, 0, 0, 1). Linear part in the first three columns, translation in the
+// last one. Composing two of them, or transforming a point, skips the
+// products by that row, and the inverses of rigid and TRS matrices are
+// built from the transposed columns instead of cofactors.
+template <typename T>
+class Matrix3x4G
+{
+public:
+    static const Matrix3x4G<T> &Identity();
+
+    Vector3G<T> c0, c1, c2, c3;  // Matrix columns from left to right
+
+    Matrix3x4G();
+
+    template <typename OtherT>
+    Matrix3x4G(const Matrix3x4G<OtherT> &m);
+
+    Matrix3x4G(const Vector3G<T> &col0,
+               const Vector3G<T> &col1,
+               const Vector3G<T> &col2,
+               const Vector3G<T> &col3);
+
+    Matrix3x4G(const Matrix3G<T> &linear, const Vector3G<T> &translation);
+
+    // Drops the last row, which must be (0, 0, 0, 1)
+    explicit Matrix3x4G(const Matrix4G<T> &m);
+
+    Vector3G<T> TransformedPoint(const Vector3G<T> &point) const;
+    Vector3G<T> TransformedVector(const Vector3G<T> &vector) const;
+
+    // Batch versions of TransformedPoint/TransformedVector. The output can be
+    // the same buffer as the input.
+    void TransformPoints(const Vector3G<T> *points,
+                         Vector3G<T> *pointsOut,
+                         std::size_t count) const;
+    void TransformVectors(const Vector3G<T> *vectors,
+                          Vector3G<T> *vectorsOut,
+                          std::size_t count) const;
+
+    // General inverse, through the 3x3 inverse of the linear part
+    Matrix3x4G<T> Inversed(T invertiblePrecision = T(0.00000001),
+                           bool *isInvertible = nullptr) const;
+    // Inverse for rotation and translation only: the transposed rotation
+    Matrix3x4G<T> InversedRigid() const;
+    // Inverse for translation, rotation and scale, in that order: the
+    // transposed columns divided by their squared lengths
+    Matrix3x4G<T> InversedTRS() const;
+
+    Matrix3G<T> GetLinear() const;
+    void SetTranslation(const Vector3G<T> &translation);
+    const Vector3G<T> &GetTranslation() const;
+    T GetDeterminant() const;
+
+    T *Data();
+    const T *Data() const;
+
+    static Matrix3x4G<T> TransformMatrix(const Vector3G<T> &position,
+                                         const QuaternionG<T> &rotation,
+                                         const Vector3G<T> &scale);
+    static Matrix3x4G<T> TransformMatrixInverse(const Vector3G<T> &position,
+                                                const QuaternionG<T> &rotation,
+                                                const Vector3G<T> &scale);
+
+    Vector3G<T> &operator[](std::size_t i);
+    const Vector3G<T> &operator[](std::size_t i) const;
+
+private:
+    // Matrix with the given rows as linear part, taking translation to the
+    // origin
+    static Matrix3x4G<T> MakeInverseFromRows(const Vector3G<T> &row0,
+                                             const Vector3G<T> &row1,
+                                             const Vector3G<T> &row2,
+                                             const Vector3G<T> &translation);
+};
+
+template <typename T>
+Matrix3x4G<T> operator*(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2);
+
+template <typename T>
+void operator*=(Matrix3x4G<T> &m, const Matrix3x4G<T> &rhs);
+
+template <typename T>
+bool operator==(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2);
+
+template <typename T>
+bool operator!=(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2);
+
+template <typename T>
+std::ostream &operator<<(std::ostream &log, const Matrix3x4G<T> &m)
+{
+    log << std::endl;
+    for (std::size_t i = 0; i < 3; ++i)
+    {
+        log << (i == 0 ? "(" : " ") << m.c0[i] << ", " << m.c1[i] << ", "
+            << m.c2[i] << ", " << m.c3[i] << (i == 2 ? ")" : ",")
+            << std::endl;
+    }
+    return log;
+}
+
+BANG_MATH_DEFINE_USINGS(Matrix3x4)
+}
+
+#include "BangMath/Matrix3x4.tcc"
@@ -0,0 +1,258 @@
+#include "BangMath/Matrix3x4.h"
+
+#include <cassert>
+
+#include "BangMath/Math.h"
+#include "BangMath/Matrix3.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Matrix4SIMD.h"
+#include "BangMath/Quaternion.h"
+
+namespace Bang
+{
+template <typename T>
+const Matrix3x4G<T> &Matrix3x4G<T>::Identity()
+{
+    static const Matrix3x4G<T> m;
+    return m;
+}
+
+template <typename T>
+Matrix3x4G<T>::Matrix3x4G()
+    : c0(1, 0, 0), c1(0, 1, 0), c2(0, 0, 1), c3(0, 0, 0)
+{
+}
+
+template <typename T>
+template <typename OtherT>
+Matrix3x4G<T>::Matrix3x4G(const Matrix3x4G<OtherT> &m)
+    : c0(m.c0), c1(m.c1), c2(m.c2), c3(m.c3)
+{
+}
+
+template <typename T>
+Matrix3x4G<T>::Matrix3x4G(const Vector3G<T> &col0,
+                          const Vector3G<T> &col1,
+                          const Vector3G<T> &col2,
+                          const Vector3G<T> &col3)
+    : c0(col0), c1(col1), c2(col2), c3(col3)
+{
+}
+
+template <typename T>
+Matrix3x4G<T>::Matrix3x4G(const Matrix3G<T> &linear,
+                          const Vector3G<T> &translation)
+    : c0(linear.c0), c1(linear.c1), c2(linear.c2), c3(translation)
+{
+}
+
+template <typename T>
+Matrix3x4G<T>::Matrix3x4G(const Matrix4G<T> &m)
+    : c0(m.c0.xyz()), c1(m.c1.xyz()), c2(m.c2.xyz()), c3(m.c3.xyz())
+{
+}
+
+template <typename T>
+Vector3G<T> Matrix3x4G<T>::TransformedPoint(const Vector3G<T> &point) const
+{
+    return (c0 * point.x) + (c1 * point.y) + (c2 * point.z) + c3;
+}
+
+template <typename T>
+Vector3G<T> Matrix3x4G<T>::TransformedVector(const Vector3G<T> &vector) const
+{
+    return (c0 * vector.x) + (c1 * vector.y) + (c2 * vector.z);
+}
+
+template <typename T>
+void Matrix3x4G<T>::TransformPoints(const Vector3G<T> *points,
+                                    Vector3G<T> *pointsOut,
+                                    std::size_t count) const
+{
+    // The kernel only reads the first three rows
+    Matrix4SIMD::Transform(Matrix4G<T>(*this),
+                           points,
+                           sizeof(Vector3G<T>),
+                           pointsOut,
+                           sizeof(Vector3G<T>),
+                           count,
+                           static_cast<T>(1));
+}
+
+template <typename T>
+void Matrix3x4G<T>::TransformVectors(const Vector3G<T> *vectors,
+                                     Vector3G<T> *vectorsOut,
+                                     std::size_t count) const
+{
+    Matrix4SIMD::Transform(Matrix4G<T>(*this),
+                           vectors,
+                           sizeof(Vector3G<T>),
+                           vectorsOut,
+                           sizeof(Vector3G<T>),
+                           count,
+                           static_cast<T>(0));
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::MakeInverseFromRows(const Vector3G<T> &row0,
+                                                const Vector3G<T> &row1,
+                                                const Vector3G<T> &row2,
+                                                const Vector3G<T> &translation)
+{
+    return Matrix3x4G<T>(Vector3G<T>(row0.x, row1.x, row2.x),
+                         Vector3G<T>(row0.y, row1.y, row2.y),
+                         Vector3G<T>(row0.z, row1.z, row2.z),
+                         -Vector3G<T>(Vector3G<T>::Dot(row0, translation),
+                                      Vector3G<T>::Dot(row1, translation),
+                                      Vector3G<T>::Dot(row2, translation)));
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::Inversed(T invertiblePrecision,
+                                      bool *isInvertibleOut) const
+{
+    // Rows of the inverse of the linear part, times the determinant
+    const Vector3G<T> row0 = Vector3G<T>::Cross(c1, c2);
+    const Vector3G<T> row1 = Vector3G<T>::Cross(c2, c0);
+    const Vector3G<T> row2 = Vector3G<T>::Cross(c0, c1);
+    const T det = Vector3G<T>::Dot(c0, row0);
+
+    const bool isInvertible = (Math::Abs(det) > invertiblePrecision);
+    if (isInvertibleOut)
+    {
+        *isInvertibleOut = isInvertible;
+    }
+    if (!isInvertible)
+    {
+        return *this;
+    }
+
+    const T invDet = static_cast<T>(1) / det;
+    return MakeInverseFromRows(row0 * invDet, row1 * invDet, row2 * invDet, c3);
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::InversedRigid() const
+{
+    return MakeInverseFromRows(c0, c1, c2, c3);
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::InversedTRS() const
+{
+    return MakeInverseFromRows(c0 / Vector3G<T>::Dot(c0, c0),
+                               c1 / Vector3G<T>::Dot(c1, c1),
+                               c2 / Vector3G<T>::Dot(c2, c2),
+                               c3);
+}
+
+template <typename T>
+Matrix3G<T> Matrix3x4G<T>::GetLinear() const
+{
+    return Matrix3G<T>(c0, c1, c2);
+}
+
+template <typename T>
+void Matrix3x4G<T>::SetTranslation(const Vector3G<T> &translation)
+{
+    c3 = translation;
+}
+
+template <typename T>
+const Vector3G<T> &Matrix3x4G<T>::GetTranslation() const
+{
+    return c3;
+}
+
+template <typename T>
+T Matrix3x4G<T>::GetDeterminant() const
+{
+    return Vector3G<T>::Dot(c0, Vector3G<T>::Cross(c1, c2));
+}
+
+template <typename T>
+T *Matrix3x4G<T>::Data()
+{
+    return static_cast<T *>(&(c0.x));
+}
+
+template <typename T>
+const T *Matrix3x4G<T>::Data() const
+{
+    return static_cast<const T *>(&(c0.x));
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::TransformMatrix(const Vector3G<T> &position,
+                                             const QuaternionG<T> &rotation,
+                                             const Vector3G<T> &scale)
+{
+    const Matrix4G<T> r = Matrix4G<T>::RotateMatrix(rotation);
+    return Matrix3x4G<T>(r.c0.xyz() * scale.x,
+                         r.c1.xyz() * scale.y,
+                         r.c2.xyz() * scale.z,
+                         position);
+}
+
+template <typename T>
+Matrix3x4G<T> Matrix3x4G<T>::TransformMatrixInverse(
+    const Vector3G<T> &position,
+    const QuaternionG<T> &rotation,
+    const Vector3G<T> &scale)
+{
+    // Inverse scale times the transposed rotation, then the translation
+    const Matrix4G<T> r = Matrix4G<T>::RotateMatrix(rotation);
+    return MakeInverseFromRows(r.c0.xyz() / scale.x,
+                               r.c1.xyz() / scale.y,
+                               r.c2.xyz() / scale.z,
+                               position);
+}
+
+template <typename T>
+Vector3G<T> &Matrix3x4G<T>::operator[](std::size_t i)
+{
+    switch (i)
+    {
+        case 0: return c0;
+        case 1: return c1;
+        case 2: return c2;
+        case 3: return c3;
+    }
+    assert(!"Matrix3x4G<T> index >= 4");
+    return c3;
+}
+
+template <typename T>
+const Vector3G<T> &Matrix3x4G<T>::operator[](std::size_t i) const
+{
+    return const_cast<Matrix3x4G<T> *>(this)->operator[](i);
+}
+
+template <typename T>
+Matrix3x4G<T> operator*(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2)
+{
+    return Matrix3x4G<T>(m1.TransformedVector(m2.c0),
+                         m1.TransformedVector(m2.c1),
+                         m1.TransformedVector(m2.c2),
+                         m1.TransformedPoint(m2.c3));
+}
+
+template <typename T>
+void operator*=(Matrix3x4G<T> &m, const Matrix3x4G<T> &rhs)
+{
+    m = m * rhs;
+}
+
+template <typename T>
+bool operator==(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2)
+{
+    return m1.c0 == m2.c0 && m1.c1 == m2.c1 && m1.c2 == m2.c2 &&
+           m1.c3 == m2.c3;
+}
+
+template <typename T>
+bool operator!=(const Matrix3x4G<T> &m1, const Matrix3x4G<T> &m2)
+{
+    return !(m1 == m2);
+}
+}
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <cstddef>
+
 #include "BangMath/Defines.h"
 #include "BangMath/Vector4.h"
 
 namespace Bang
 {
 template <typename>
+class AABoxG;
+template <typename>
 class Matrix3G;
 template <typename>
+class Matrix3x4G;
+template <typename>
 class QuaternionG;
 template <typename>
 class Vector3G;
@@ -52,12 +58,46 @@ public:
     template <typename OtherT>
     explicit Matrix4G(const Matrix3G<OtherT> &m);
 
+    explicit Matrix4G(const Matrix3x4G<T> &m);
+
     template <typename OtherT>
     explicit Matrix4G(const OtherT &a);
 
     Vector3G<T> TransformedPoint(const Vector3G<T> &point) const;
     Vector3G<T> TransformedVector(const Vector3G<T> &vector) const;
 
+    // Batch versions of TransformedPoint/TransformedVector. The output can be
+    // the same buffer as the input. Strides are in bytes, so interleaved
+    // vertex buffers can be walked in place.
+    void TransformPoints(const Vector3G<T> *points,
+                         Vector3G<T> *pointsOut,
+                         std::size_t count) const;
+    void TransformPoints(const Vector3G<T> *points,
+                         std::size_t pointsStride,
+                         Vector3G<T> *pointsOut,
+                         std::size_t pointsOutStride,
+                         std::size_t count) const;
+    void TransformVectors(const Vector3G<T> *vectors,
+                          Vector3G<T> *vectorsOut,
+                          std::size_t count) const;
+    void TransformVectors(const Vector3G<T> *vectors,
+                          std::size_t vectorsStride,
+                          Vector3G<T> *vectorsOut,
+                          std::size_t vectorsOutStride,
+                          std::size_t count) const;
+
+    // Batch version of operator* with AABoxG: the bounds of the transformed
+    // boxes, for affine matrices. The output can be the same buffer as the
+    // input.
+    void TransformAABoxes(const AABoxG<T> *aaBoxes,
+                          AABoxG<T> *aaBoxesOut,
+                          std::size_t count) const;
+    // Same, transforming each box by its own matrix
+    static void TransformAABoxes(const Matrix4G<T> *matrices,
+                                 const AABoxG<T> *aaBoxes,
+                                 AABoxG<T> *aaBoxesOut,
+                                 std::size_t count);
+
     Matrix4G<T> Inversed(T invertiblePrecision = T(0.00000001),
                          bool *isInvertible = nullptr) const;
     Matrix4G<T> Transposed() const;
@@ -92,6 +132,17 @@ public:
     static Matrix4G<T> ScaleMatrix(const Vector3G<T> &v);
     static QuaternionG<T> ToQuaternion(const Matrix4G<T> &m);
 
+    // Batch versions of RotateMatrix and TransformMatrix, for matrix
+    // palettes. Four rotations are converted at a time with SIMD.
+    static void RotateMatrices(const QuaternionG<T> *rotations,
+                               Matrix4G<T> *matricesOut,
+                               std::size_t count);
+    static void TransformMatrices(const Vector3G<T> *positions,
+                                  const QuaternionG<T> *rotations,
+                                  const Vector3G<T> *scales,
+                                  Matrix4G<T> *matricesOut,
+                                  std::size_t count);
+
     Vector4G<T> &operator[](std::size_t i);
     const Vector4G<T> &operator[](std::size_t i) const;
 };
@@ -1,5 +1,9 @@
 #include "BangMath/Matrix4.h"
 
+#include "BangMath/Matrix3x4.h"
+#include "BangMath/Matrix4SIMD.h"
+#include "BangMath/QuaternionSIMD.h"
+
 namespace Bang
 {
 template <typename T>
@@ -63,6 +67,15 @@ Matrix4G<T>::Matrix4G(const Matrix3G<OtherT> &m)
     c3 = Vector4G<T>(0, 0, 0, 1);
 }
 
+template <typename T>
+Matrix4G<T>::Matrix4G(const Matrix3x4G<T> &m)
+{
+    c0 = Vector4G<T>(m.c0, 0);
+    c1 = Vector4G<T>(m.c1, 0);
+    c2 = Vector4G<T>(m.c2, 0);
+    c3 = Vector4G<T>(m.c3, 1);
+}
+
 template <typename T>
 template <typename OtherT>
 Matrix4G<T>::Matrix4G(const OtherT &a)
@@ -96,6 +109,83 @@ Vector3G<T> Matrix4G<T>::TransformedVector(const Vector3G<T> &vector) const
     return ((*this) * Vector4G<T>(vector, 0)).xyz();
 }
 
+template <typename T>
+void Matrix4G<T>::TransformPoints(const Vector3G<T> *points,
+                                  Vector3G<T> *pointsOut,
+                                  std::size_t count) const
+{
+    Matrix4SIMD::Transform(*this,
+                           points,
+                           sizeof(Vector3G<T>),
+                           pointsOut,
+                           sizeof(Vector3G<T>),
+                           count,
+                           static_cast<T>(1));
+}
+
+template <typename T>
+void Matrix4G<T>::TransformPoints(const Vector3G<T> *points,
+                                  std::size_t pointsStride,
+                                  Vector3G<T> *pointsOut,
+                                  std::size_t pointsOutStride,
+                                  std::size_t count) const
+{
+    Matrix4SIMD::Transform(*this,
+                           points,
+                           pointsStride,
+                           pointsOut,
+                           pointsOutStride,
+                           count,
+                           static_cast<T>(1));
+}
+
+template <typename T>
+void Matrix4G<T>::TransformVectors(const Vector3G<T> *vectors,
+                                   Vector3G<T> *vectorsOut,
+                                   std::size_t count) const
+{
+    Matrix4SIMD::Transform(*this,
+                           vectors,
+                           sizeof(Vector3G<T>),
+                           vectorsOut,
+                           sizeof(Vector3G<T>),
+                           count,
+                           static_cast<T>(0));
+}
+
+template <typename T>
+void Matrix4G<T>::TransformVectors(const Vector3G<T> *vectors,
+                                   std::size_t vectorsStride,
+                                   Vector3G<T> *vectorsOut,
+                                   std::size_t vectorsOutStride,
+                                   std::size_t count) const
+{
+    Matrix4SIMD::Transform(*this,
+                           vectors,
+                           vectorsStride,
+                           vectorsOut,
+                           vectorsOutStride,
+                           count,
+                           static_cast<T>(0));
+}
+
+template <typename T>
+void Matrix4G<T>::TransformAABoxes(const AABoxG<T> *aaBoxes,
+                                   AABoxG<T> *aaBoxesOut,
+                                   std::size_t count) const
+{
+    Matrix4SIMD::TransformAABoxes(*this, aaBoxes, aaBoxesOut, count);
+}
+
+template <typename T>
+void Matrix4G<T>::TransformAABoxes(const Matrix4G<T> *matrices,
+                                   const AABoxG<T> *aaBoxes,
+                                   AABoxG<T> *aaBoxesOut,
+                                   std::size_t count)
+{
+    Matrix4SIMD::TransformAABoxes(matrices, aaBoxes, aaBoxesOut, count);
+}
+
 template <typename T>
 Matrix4G<T> Matrix4G<T>::Inversed(T invertiblePrecision,
                                   bool *isInvertibleOut) const
@@ -167,8 +257,8 @@ Matrix4G<T> Matrix4G<T>::Inversed(T invertiblePrecision,
                m.c1.x * m.c0.y * m.c2.z + m.c1.x * m.c0.z * m.c2.y +
                m.c2.x * m.c0.y * m.c1.z - m.c2.x * m.c0.z * m.c1.y;
 
-    float det = m.c0.x * inv.c0.x + m.c0.y * inv.c1.x + m.c0.z * inv.c2.x +
-                m.c0.w * inv.c3.x;
+    T det = m.c0.x * inv.c0.x + m.c0.y * inv.c1.x + m.c0.z * inv.c2.x +
+            m.c0.w * inv.c3.x;
 
     bool isInvertible = (Math::Abs(det) > invertiblePrecision);
     if (isInvertibleOut)
@@ -333,19 +423,8 @@ Matrix4G<T> Matrix4G<T>::TransformMatrix(const Vector3G<T> &position,
                                          const QuaternionG<T> &rotation,
                                          const Vector3G<T> &scale)
 {
-    Matrix4G<T> transformMatrix;
-    if (rotation == QuaternionG<T>::Identity())
-    {
-        transformMatrix.SetTranslation(position);
-        transformMatrix.SetScale(scale);
-    }
-    else
-    {
-        transformMatrix.SetScale(scale);
-        transformMatrix = Matrix4G<T>::RotateMatrix(rotation) * transformMatrix;
-        transformMatrix.SetTranslation(position);
-    }
-    return transformMatrix;
+    return Matrix4G<T>(
+        Matrix3x4G<T>::TransformMatrix(position, rotation, scale));
 }
 
 template <typename T>
@@ -353,14 +432,8 @@ Matrix4G<T> Matrix4G<T>::TransformMatrixInverse(const Vector3G<T> &position,
                                                 const QuaternionG<T> &rotation,
                                                 const Vector3G<T> &scale)
 {
-    const Vector3G<T> inversePosition = -position;
-    const QuaternionG<T> inverseRotation = rotation.Inversed();
-    const Vector3G<T> inverseScale = (1.0f / scale);
-
-    Matrix4G<T> transformMatrix = Matrix4G<T>::ScaleMatrix(inverseScale) *
-                                  Matrix4G<T>::RotateMatrix(inverseRotation) *
-                                  Matrix4G<T>::TranslateMatrix(inversePosition);
-    return transformMatrix;
+    return Matrix4G<T>(
+        Matrix3x4G<T>::TransformMatrixInverse(position, rotation, scale));
 }
 
 template <typename T>
@@ -500,6 +573,30 @@ QuaternionG<T> Matrix4G<T>::ToQuaternion(const Matrix4G<T> &m)
     return res;
 }
 
+template <typename T>
+void Matrix4G<T>::RotateMatrices(const QuaternionG<T> *rotations,
+                                 Matrix4G<T> *matricesOut,
+                                 std::size_t count)
+{
+    QuaternionSIMD::TransformMatrices(
+        static_cast<const Vector3G<T> *>(nullptr),
+        rotations,
+        static_cast<const Vector3G<T> *>(nullptr),
+        matricesOut,
+        count);
+}
+
+template <typename T>
+void Matrix4G<T>::TransformMatrices(const Vector3G<T> *positions,
+                                    const QuaternionG<T> *rotations,
+                                    const Vector3G<T> *scales,
+                                    Matrix4G<T> *matricesOut,
+                                    std::size_t count)
+{
+    QuaternionSIMD::TransformMatrices(
+        positions, rotations, scales, matricesOut, count);
+}
+
 template <typename T>
 Vector4G<T> &Matrix4G<T>::operator[](std::size_t i)
 {
@@ -629,4 +726,74 @@ void operator-=(Matrix4G<T> &m, const Matrix4G<T> &rhs)
 {
     m = m - rhs;
 }
+
+#if defined(BANG_MATH_SIMD_FLOAT4)
+template <>
+inline Matrix4G<float> Matrix4G<float>::Inversed(float invertiblePrecision,
+                                                 bool *isInvertible) const
+{
+    return Matrix4SIMD::Inversed(*this, invertiblePrecision, isInvertible);
+}
+
+template <>
+inline Matrix4G<float> Matrix4G<float>::Transposed() const
+{
+    return Matrix4SIMD::Transposed(*this);
+}
+
+template <>
+inline float Matrix4G<float>::GetDeterminant() const
+{
+    return Matrix4SIMD::GetDeterminant(*this);
+}
+
+template <>
+inline Matrix4G<float> operator*(const Matrix4G<float> &m1,
+                                 const Matrix4G<float> &m2)
+{
+    return Matrix4SIMD::Multiply(m1, m2);
+}
+
+template <>
+inline Vector4G<float> operator*(const Matrix4G<float> &m,
+                                 const Vector4G<float> &v)
+{
+    return Matrix4SIMD::Multiply(m, v);
+}
+#endif
+
+#if defined(BANG_MATH_SIMD_DOUBLE4)
+template <>
+inline Matrix4G<double> Matrix4G<double>::Inversed(double invertiblePrecision,
+                                                   bool *isInvertible) const
+{
+    return Matrix4SIMD::Inversed(*this, invertiblePrecision, isInvertible);
+}
+
+template <>
+inline Matrix4G<double> Matrix4G<double>::Transposed() const
+{
+    return Matrix4SIMD::Transposed(*this);
+}
+
+template <>
+inline double Matrix4G<double>::GetDeterminant() const
+{
+    return Matrix4SIMD::GetDeterminant(*this);
+}
+
+template <>
+inline Matrix4G<double> operator*(const Matrix4G<double> &m1,
+                                  const Matrix4G<double> &m2)
+{
+    return Matrix4SIMD::Multiply(m1, m2);
+}
+
+template <>
+inline Vector4G<double> operator*(const Matrix4G<double> &m,
+                                  const Vector4G<double> &v)
+{
+    return Matrix4SIMD::Multiply(m, v);
+}
+#endif
 }  // namespace Bang
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+
+#include "BangMath/Defines.h"
+#include "BangMath/SIMD.h"
+
+namespace Bang
+{
+template <typename>
+class AABoxG;
+template <typename>
+class Matrix4G;
+template <typename>
+class Vector3G;
+template <typename>
+class Vector4G;
+
+// Matrix4 kernels written against SIMD4G. Matrix4G<float> and
+// Matrix4G<double> route their hot operations here when the backend is
+// accelerated. Columns are loaded straight from c0..c3, so the memory layout
+// is the same as the scalar path.
+class Matrix4SIMD
+{
+public:
+    template <typename T>
+    static Matrix4G<T> Multiply(const Matrix4G<T> &m1, const Matrix4G<T> &m2);
+
+    template <typename T>
+    static Vector4G<T> Multiply(const Matrix4G<T> &m, const Vector4G<T> &v);
+
+    template <typename T>
+    static Matrix4G<T> Inversed(const Matrix4G<T> &m,
+                                T invertiblePrecision,
+                                bool *isInvertible);
+
+    template <typename T>
+    static Matrix4G<T> Transposed(const Matrix4G<T> &m);
+
+    template <typename T>
+    static T GetDeterminant(const Matrix4G<T> &m);
+
+    // Transforms count (x, y, z, w) tuples, w being 1 for points and 0 for
+    // vectors. Works on four elements at a time, and packed arrays are
+    // deinterleaved in registers instead of gathered lane by lane.
+    template <typename T>
+    static void Transform(const Matrix4G<T> &m,
+                          const Vector3G<T> *in,
+                          std::size_t inStride,
+                          Vector3G<T> *out,
+                          std::size_t outStride,
+                          std::size_t count,
+                          T w);
+
+    // Four packed Vector3G, (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) in
+    // memory, to x, y, z lanes and back
+    template <typename T>
+    static void LoadPacked3(const T *src,
+                            SIMD4G<T> *x,
+                            SIMD4G<T> *y,
+                            SIMD4G<T> *z);
+    template <typename T>
+    static void StorePacked3(const SIMD4G<T> &x,
+                             const SIMD4G<T> &y,
+                             const SIMD4G<T> &z,
+                             T *dst);
+
+    // Arvo's method in center/extents form: the new center is the
+    // transformed center and each new extent is the dot product of a row of
+    // the absolute matrix with the extents. Four boxes at a time in x, y, z
+    // lanes for a single matrix, and one box per register with the columns
+    // loaded as is for a matrix per box.
+    template <typename T>
+    static void TransformAABoxes(const Matrix4G<T> &m,
+                                 const AABoxG<T> *in,
+                                 AABoxG<T> *out,
+                                 std::size_t count);
+    template <typename T>
+    static void TransformAABoxes(const Matrix4G<T> *matrices,
+                                 const AABoxG<T> *in,
+                                 AABoxG<T> *out,
+                                 std::size_t count);
+
+    Matrix4SIMD() = delete;
+
+private:
+    // Cross product of the xyz lanes. The w lane of the result is zero.
+    template <typename T>
+    static SIMD4G<T> Cross3(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+    template <typename T>
+    static SIMD4G<T> Abs(const SIMD4G<T> &v);
+
+    template <typename T>
+    static bool IsEmpty(const AABoxG<T> &aaBox);
+};
+}
+
+#include "BangMath/Matrix4SIMD.tcc"
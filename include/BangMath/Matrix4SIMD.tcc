@@ -0,0 +1,418 @@
+#include "BangMath/Matrix4SIMD.h"
+
+#include "BangMath/AABox.h"
+#include "BangMath/Math.h"
+
+namespace Bang
+{
+template <typename T>
+Matrix4G<T> Matrix4SIMD::Multiply(const Matrix4G<T> &m1, const Matrix4G<T> &m2)
+{
+    const SIMD4G<T> a0 = SIMD4G<T>::Load(&m1.c0.x);
+    const SIMD4G<T> a1 = SIMD4G<T>::Load(&m1.c1.x);
+    const SIMD4G<T> a2 = SIMD4G<T>::Load(&m1.c2.x);
+    const SIMD4G<T> a3 = SIMD4G<T>::Load(&m1.c3.x);
+
+    Matrix4G<T> m;
+    const Vector4G<T> *m2Cols[4] = {&m2.c0, &m2.c1, &m2.c2, &m2.c3};
+    Vector4G<T> *mCols[4] = {&m.c0, &m.c1, &m.c2, &m.c3};
+    for (int i = 0; i < 4; ++i)
+    {
+        const SIMD4G<T> b = SIMD4G<T>::Load(&m2Cols[i]->x);
+        const SIMD4G<T> col = (a0 * b.template Broadcast<0>()) +
+                              (a1 * b.template Broadcast<1>()) +
+                              (a2 * b.template Broadcast<2>()) +
+                              (a3 * b.template Broadcast<3>());
+        col.Store(&mCols[i]->x);
+    }
+    return m;
+}
+
+template <typename T>
+Vector4G<T> Matrix4SIMD::Multiply(const Matrix4G<T> &m, const Vector4G<T> &v)
+{
+    const SIMD4G<T> res = (SIMD4G<T>::Load(&m.c0.x) * SIMD4G<T>(v.x)) +
+                          (SIMD4G<T>::Load(&m.c1.x) * SIMD4G<T>(v.y)) +
+                          (SIMD4G<T>::Load(&m.c2.x) * SIMD4G<T>(v.z)) +
+                          (SIMD4G<T>::Load(&m.c3.x) * SIMD4G<T>(v.w));
+    Vector4G<T> result;
+    res.Store(&result.x);
+    return result;
+}
+
+// Lengyel, "Foundations of Game Engine Development, Vol. 1", section 1.7.5.
+// Columns are a, b, c, d and their w lanes are the bottom row.
+template <typename T>
+Matrix4G<T> Matrix4SIMD::Inversed(const Matrix4G<T> &m,
+                                  T invertiblePrecision,
+                                  bool *isInvertibleOut)
+{
+    const SIMD4G<T> a = SIMD4G<T>::Load(&m.c0.x);
+    const SIMD4G<T> b = SIMD4G<T>::Load(&m.c1.x);
+    const SIMD4G<T> c = SIMD4G<T>::Load(&m.c2.x);
+    const SIMD4G<T> d = SIMD4G<T>::Load(&m.c3.x);
+
+    const SIMD4G<T> s = Matrix4SIMD::Cross3(a, b);
+    const SIMD4G<T> t = Matrix4SIMD::Cross3(c, d);
+    const SIMD4G<T> x = a.template Broadcast<3>();
+    const SIMD4G<T> y = b.template Broadcast<3>();
+    const SIMD4G<T> z = c.template Broadcast<3>();
+    const SIMD4G<T> w = d.template Broadcast<3>();
+    const SIMD4G<T> u = (a * y) - (b * x);
+    const SIMD4G<T> v = (c * w) - (d * z);
+
+    // s, t, u and v have a zero w lane, so the 4-lane sum is the 3D dot
+    const T det = SIMD4G<T>::HorizontalSum((s * v) + (t * u));
+
+    const bool isInvertible = (Math::Abs(det) > invertiblePrecision);
+    if (isInvertibleOut)
+    {
+        *isInvertibleOut = isInvertible;
+    }
+    if (!isInvertible)
+    {
+        return m;
+    }
+
+    // Rows of the inverse, without their w lane
+    SIMD4G<T> r0 = Matrix4SIMD::Cross3(b, v) + (t * y);
+    SIMD4G<T> r1 = Matrix4SIMD::Cross3(v, a) - (t * x);
+    SIMD4G<T> r2 = Matrix4SIMD::Cross3(d, u) + (s * w);
+    SIMD4G<T> r3 = Matrix4SIMD::Cross3(u, c) - (s * z);
+    SIMD4G<T>::Transpose(r0, r1, r2, r3);
+
+    // The w lanes of the rows form the last column: -b.t, a.t, -d.s, c.s
+    SIMD4G<T> p0 = b * t;
+    SIMD4G<T> p1 = a * t;
+    SIMD4G<T> p2 = d * s;
+    SIMD4G<T> p3 = c * s;
+    SIMD4G<T>::Transpose(p0, p1, p2, p3);
+    const SIMD4G<T> signs(T(-1), T(1), T(-1), T(1));
+    r3 = (p0 + p1 + p2) * signs;
+
+    const SIMD4G<T> invDet(T(1) / det);
+    Matrix4G<T> inv;
+    (r0 * invDet).Store(&inv.c0.x);
+    (r1 * invDet).Store(&inv.c1.x);
+    (r2 * invDet).Store(&inv.c2.x);
+    (r3 * invDet).Store(&inv.c3.x);
+    return inv;
+}
+
+template <typename T>
+Matrix4G<T> Matrix4SIMD::Transposed(const Matrix4G<T> &m)
+{
+    SIMD4G<T> c0 = SIMD4G<T>::Load(&m.c0.x);
+    SIMD4G<T> c1 = SIMD4G<T>::Load(&m.c1.x);
+    SIMD4G<T> c2 = SIMD4G<T>::Load(&m.c2.x);
+    SIMD4G<T> c3 = SIMD4G<T>::Load(&m.c3.x);
+    SIMD4G<T>::Transpose(c0, c1, c2, c3);
+
+    Matrix4G<T> trans;
+    c0.Store(&trans.c0.x);
+    c1.Store(&trans.c1.x);
+    c2.Store(&trans.c2.x);
+    c3.Store(&trans.c3.x);
+    return trans;
+}
+
+template <typename T>
+T Matrix4SIMD::GetDeterminant(const Matrix4G<T> &m)
+{
+    const SIMD4G<T> a = SIMD4G<T>::Load(&m.c0.x);
+    const SIMD4G<T> b = SIMD4G<T>::Load(&m.c1.x);
+    const SIMD4G<T> c = SIMD4G<T>::Load(&m.c2.x);
+    const SIMD4G<T> d = SIMD4G<T>::Load(&m.c3.x);
+
+    const SIMD4G<T> s = Matrix4SIMD::Cross3(a, b);
+    const SIMD4G<T> t = Matrix4SIMD::Cross3(c, d);
+    const SIMD4G<T> u = (a * b.template Broadcast<3>()) -
+                        (b * a.template Broadcast<3>());
+    const SIMD4G<T> v = (c * d.template Broadcast<3>()) -
+                        (d * c.template Broadcast<3>());
+    return SIMD4G<T>::HorizontalSum((s * v) + (t * u));
+}
+
+template <typename T>
+void Matrix4SIMD::Transform(const Matrix4G<T> &m,
+                            const Vector3G<T> *in,
+                            std::size_t inStride,
+                            Vector3G<T> *out,
+                            std::size_t outStride,
+                            std::size_t count,
+                            T w)
+{
+    const unsigned char *inBytes = reinterpret_cast<const unsigned char *>(in);
+    unsigned char *outBytes = reinterpret_cast<unsigned char *>(out);
+
+    std::size_t i = 0;
+    if (SIMD4G<T>::IsAccelerated)
+    {
+        // Matrix rows splatted once, so each block of four is just 9 mul/adds
+        const SIMD4G<T> m00(m.c0.x), m01(m.c1.x), m02(m.c2.x), m03(m.c3.x * w);
+        const SIMD4G<T> m10(m.c0.y), m11(m.c1.y), m12(m.c2.y), m13(m.c3.y * w);
+        const SIMD4G<T> m20(m.c0.z), m21(m.c1.z), m22(m.c2.z), m23(m.c3.z * w);
+
+        const bool packed = (inStride == sizeof(Vector3G<T>) &&
+                             outStride == sizeof(Vector3G<T>));
+        if (packed)
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                SIMD4G<T> x, y, z;
+                LoadPacked3(&in[i].x, &x, &y, &z);
+                const SIMD4G<T> rx = (m00 * x) + (m01 * y) + (m02 * z) + m03;
+                const SIMD4G<T> ry = (m10 * x) + (m11 * y) + (m12 * z) + m13;
+                const SIMD4G<T> rz = (m20 * x) + (m21 * y) + (m22 * z) + m23;
+                StorePacked3(rx, ry, rz, &out[i].x);
+            }
+        }
+        else
+        {
+            for (; i + 4 <= count; i += 4)
+            {
+                const Vector3G<T> *p[4];
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    p[k] = reinterpret_cast<const Vector3G<T> *>(
+                        inBytes + (i + k) * inStride);
+                }
+                const SIMD4G<T> x(p[0]->x, p[1]->x, p[2]->x, p[3]->x);
+                const SIMD4G<T> y(p[0]->y, p[1]->y, p[2]->y, p[3]->y);
+                const SIMD4G<T> z(p[0]->z, p[1]->z, p[2]->z, p[3]->z);
+
+                T rx[4], ry[4], rz[4];
+                ((m00 * x) + (m01 * y) + (m02 * z) + m03).Store(rx);
+                ((m10 * x) + (m11 * y) + (m12 * z) + m13).Store(ry);
+                ((m20 * x) + (m21 * y) + (m22 * z) + m23).Store(rz);
+                for (std::size_t k = 0; k < 4; ++k)
+                {
+                    Vector3G<T> &r = *reinterpret_cast<Vector3G<T> *>(
+                        outBytes + (i + k) * outStride);
+                    r.x = rx[k];
+                    r.y = ry[k];
+                    r.z = rz[k];
+                }
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        const Vector3G<T> p =
+            *reinterpret_cast<const Vector3G<T> *>(inBytes + i * inStride);
+        Vector3G<T> &r =
+            *reinterpret_cast<Vector3G<T> *>(outBytes + i * outStride);
+        r.x = (m.c0.x * p.x) + (m.c1.x * p.y) + (m.c2.x * p.z) + (m.c3.x * w);
+        r.y = (m.c0.y * p.x) + (m.c1.y * p.y) + (m.c2.y * p.z) + (m.c3.y * w);
+        r.z = (m.c0.z * p.x) + (m.c1.z * p.y) + (m.c2.z * p.z) + (m.c3.z * w);
+    }
+}
+
+template <typename T>
+void Matrix4SIMD::LoadPacked3(const T *src,
+                              SIMD4G<T> *x,
+                              SIMD4G<T> *y,
+                              SIMD4G<T> *z)
+{
+    // (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3) to x, y, z lanes
+    const SIMD4G<T> v0 = SIMD4G<T>::Load(src);
+    const SIMD4G<T> v1 = SIMD4G<T>::Load(src + 4);
+    const SIMD4G<T> v2 = SIMD4G<T>::Load(src + 8);
+    *x = SIMD4G<T>::template Shuffle<0, 3, 0, 2>(
+        v0, SIMD4G<T>::template Shuffle<2, 2, 1, 1>(v1, v2));
+    *y = SIMD4G<T>::template Shuffle<0, 2, 0, 2>(
+        SIMD4G<T>::template Shuffle<1, 1, 0, 0>(v0, v1),
+        SIMD4G<T>::template Shuffle<3, 3, 2, 2>(v1, v2));
+    *z = SIMD4G<T>::template Shuffle<0, 2, 0, 3>(
+        SIMD4G<T>::template Shuffle<2, 2, 1, 1>(v0, v1), v2);
+}
+
+template <typename T>
+void Matrix4SIMD::StorePacked3(const SIMD4G<T> &x,
+                               const SIMD4G<T> &y,
+                               const SIMD4G<T> &z,
+                               T *dst)
+{
+    // And back to (x0 y0 z0 x1) (y1 z1 x2 y2) (z2 x3 y3 z3)
+    SIMD4G<T>::template Shuffle<0, 2, 0, 2>(
+        SIMD4G<T>::template Shuffle<0, 0, 0, 0>(x, y),
+        SIMD4G<T>::template Shuffle<0, 0, 1, 1>(z, x))
+        .Store(dst);
+    SIMD4G<T>::template Shuffle<0, 2, 0, 2>(
+        SIMD4G<T>::template Shuffle<1, 1, 1, 1>(y, z),
+        SIMD4G<T>::template Shuffle<2, 2, 2, 2>(x, y))
+        .Store(dst + 4);
+    SIMD4G<T>::template Shuffle<0, 2, 0, 2>(
+        SIMD4G<T>::template Shuffle<2, 2, 3, 3>(z, x),
+        SIMD4G<T>::template Shuffle<3, 3, 3, 3>(y, z))
+        .Store(dst + 8);
+}
+
+template <typename T>
+void Matrix4SIMD::TransformAABoxes(const Matrix4G<T> &m,
+                                   const AABoxG<T> *in,
+                                   AABoxG<T> *out,
+                                   std::size_t count)
+{
+    std::size_t i = 0;
+    if (SIMD4G<T>::IsAccelerated)
+    {
+        const SIMD4G<T> m00(m.c0.x), m01(m.c1.x), m02(m.c2.x), m03(m.c3.x);
+        const SIMD4G<T> m10(m.c0.y), m11(m.c1.y), m12(m.c2.y), m13(m.c3.y);
+        const SIMD4G<T> m20(m.c0.z), m21(m.c1.z), m22(m.c2.z), m23(m.c3.z);
+        const SIMD4G<T> a00(Math::Abs(m.c0.x)), a01(Math::Abs(m.c1.x)),
+            a02(Math::Abs(m.c2.x));
+        const SIMD4G<T> a10(Math::Abs(m.c0.y)), a11(Math::Abs(m.c1.y)),
+            a12(Math::Abs(m.c2.y));
+        const SIMD4G<T> a20(Math::Abs(m.c0.z)), a21(Math::Abs(m.c1.z)),
+            a22(Math::Abs(m.c2.z));
+        const SIMD4G<T> half(static_cast<T>(0.5));
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const AABoxG<T> *b = &in[i];
+            const SIMD4G<T> minX(b[0].GetMin().x,
+                                 b[1].GetMin().x,
+                                 b[2].GetMin().x,
+                                 b[3].GetMin().x);
+            const SIMD4G<T> minY(b[0].GetMin().y,
+                                 b[1].GetMin().y,
+                                 b[2].GetMin().y,
+                                 b[3].GetMin().y);
+            const SIMD4G<T> minZ(b[0].GetMin().z,
+                                 b[1].GetMin().z,
+                                 b[2].GetMin().z,
+                                 b[3].GetMin().z);
+            const SIMD4G<T> maxX(b[0].GetMax().x,
+                                 b[1].GetMax().x,
+                                 b[2].GetMax().x,
+                                 b[3].GetMax().x);
+            const SIMD4G<T> maxY(b[0].GetMax().y,
+                                 b[1].GetMax().y,
+                                 b[2].GetMax().y,
+                                 b[3].GetMax().y);
+            const SIMD4G<T> maxZ(b[0].GetMax().z,
+                                 b[1].GetMax().z,
+                                 b[2].GetMax().z,
+                                 b[3].GetMax().z);
+            const bool isEmpty[4] = {
+                IsEmpty(b[0]), IsEmpty(b[1]), IsEmpty(b[2]), IsEmpty(b[3])};
+
+            const SIMD4G<T> cx = (minX + maxX) * half;
+            const SIMD4G<T> cy = (minY + maxY) * half;
+            const SIMD4G<T> cz = (minZ + maxZ) * half;
+            const SIMD4G<T> ex = (maxX - minX) * half;
+            const SIMD4G<T> ey = (maxY - minY) * half;
+            const SIMD4G<T> ez = (maxZ - minZ) * half;
+
+            const SIMD4G<T> rcx = (m00 * cx) + (m01 * cy) + (m02 * cz) + m03;
+            const SIMD4G<T> rcy = (m10 * cx) + (m11 * cy) + (m12 * cz) + m13;
+            const SIMD4G<T> rcz = (m20 * cx) + (m21 * cy) + (m22 * cz) + m23;
+            const SIMD4G<T> rex = (a00 * ex) + (a01 * ey) + (a02 * ez);
+            const SIMD4G<T> rey = (a10 * ex) + (a11 * ey) + (a12 * ez);
+            const SIMD4G<T> rez = (a20 * ex) + (a21 * ey) + (a22 * ez);
+
+            T rMinX[4], rMinY[4], rMinZ[4], rMaxX[4], rMaxY[4], rMaxZ[4];
+            (rcx - rex).Store(rMinX);
+            (rcy - rey).Store(rMinY);
+            (rcz - rez).Store(rMinZ);
+            (rcx + rex).Store(rMaxX);
+            (rcy + rey).Store(rMaxY);
+            (rcz + rez).Store(rMaxZ);
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                if (isEmpty[k])
+                {
+                    out[i + k] = AABoxG<T>();
+                    continue;
+                }
+                out[i + k].SetMin(Vector3G<T>(rMinX[k], rMinY[k], rMinZ[k]));
+                out[i + k].SetMax(Vector3G<T>(rMaxX[k], rMaxY[k], rMaxZ[k]));
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        out[i] = m * in[i];
+    }
+}
+
+template <typename T>
+void Matrix4SIMD::TransformAABoxes(const Matrix4G<T> *matrices,
+                                   const AABoxG<T> *in,
+                                   AABoxG<T> *out,
+                                   std::size_t count)
+{
+    if (!SIMD4G<T>::IsAccelerated)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            out[i] = matrices[i] * in[i];
+        }
+        return;
+    }
+
+    const SIMD4G<T> half(static_cast<T>(0.5));
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (IsEmpty(in[i]))
+        {
+            out[i] = AABoxG<T>();
+            continue;
+        }
+
+        const Matrix4G<T> &m = matrices[i];
+        const SIMD4G<T> c0 = SIMD4G<T>::Load(&m.c0.x);
+        const SIMD4G<T> c1 = SIMD4G<T>::Load(&m.c1.x);
+        const SIMD4G<T> c2 = SIMD4G<T>::Load(&m.c2.x);
+        const SIMD4G<T> c3 = SIMD4G<T>::Load(&m.c3.x);
+
+        const Vector3G<T> &bMin = in[i].GetMin();
+        const Vector3G<T> &bMax = in[i].GetMax();
+        const SIMD4G<T> bMinV(bMin.x, bMin.y, bMin.z, T(0));
+        const SIMD4G<T> bMaxV(bMax.x, bMax.y, bMax.z, T(0));
+        const SIMD4G<T> center = (bMinV + bMaxV) * half;
+        const SIMD4G<T> extents = (bMaxV - bMinV) * half;
+
+        const SIMD4G<T> rCenter = (c0 * center.template Broadcast<0>()) +
+                                  (c1 * center.template Broadcast<1>()) +
+                                  (c2 * center.template Broadcast<2>()) + c3;
+        const SIMD4G<T> rExtents =
+            (Abs(c0) * extents.template Broadcast<0>()) +
+            (Abs(c1) * extents.template Broadcast<1>()) +
+            (Abs(c2) * extents.template Broadcast<2>());
+
+        T rMin[4], rMax[4];
+        (rCenter - rExtents).Store(rMin);
+        (rCenter + rExtents).Store(rMax);
+        out[i].SetMin(Vector3G<T>(rMin[0], rMin[1], rMin[2]));
+        out[i].SetMax(Vector3G<T>(rMax[0], rMax[1], rMax[2]));
+    }
+}
+
+template <typename T>
+SIMD4G<T> Matrix4SIMD::Cross3(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    const SIMD4G<T> aYZX = SIMD4G<T>::template Shuffle<1, 2, 0, 3>(a, a);
+    const SIMD4G<T> aZXY = SIMD4G<T>::template Shuffle<2, 0, 1, 3>(a, a);
+    const SIMD4G<T> bYZX = SIMD4G<T>::template Shuffle<1, 2, 0, 3>(b, b);
+    const SIMD4G<T> bZXY = SIMD4G<T>::template Shuffle<2, 0, 1, 3>(b, b);
+    return (aYZX * bZXY) - (aZXY * bYZX);
+}
+
+template <typename T>
+SIMD4G<T> Matrix4SIMD::Abs(const SIMD4G<T> &v)
+{
+    return SIMD4G<T>::Max(v, -v);
+}
+
+template <typename T>
+bool Matrix4SIMD::IsEmpty(const AABoxG<T> &aaBox)
+{
+    const Vector3G<T> &bMin = aaBox.GetMin();
+    const Vector3G<T> &bMax = aaBox.GetMax();
+    return (bMin.x > bMax.x || bMin.y > bMax.y || bMin.z > bMax.z);
+}
+}
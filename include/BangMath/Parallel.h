@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Bang
+{
+// Work splitting shared by the multithreaded batch functions
+class Parallel
+{
+public:
+    // Threads to use for numTiles tiles: numThreads, or as many as the
+    // hardware supports if it is 0, at most one per tile and at least one
+    static std::size_t GetThreadCount(std::size_t numThreads,
+                                      std::size_t numTiles);
+
+    // Splits [0, count) in tiles of tileSize that numThreads threads (see
+    // GetThreadCount) pick in order, and calls function(begin, end, thread)
+    // for every tile. The calling thread is thread 0, and the only one if
+    // there is a single tile.
+    template <class Function>
+    static void ForTiles(std::size_t count,
+                         std::size_t tileSize,
+                         std::size_t numThreads,
+                         Function function);
+
+    Parallel() = delete;
+};
+}
+
+#include "BangMath/Parallel.tcc"
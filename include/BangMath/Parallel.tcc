@@ -0,0 +1,51 @@
+#include "BangMath/Parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Bang
+{
+inline std::size_t Parallel::GetThreadCount(std::size_t numThreads,
+                                            std::size_t numTiles)
+{
+    if (numThreads == 0)
+    {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    return std::max(std::min(numThreads, numTiles), std::size_t(1));
+}
+
+template <class Function>
+void Parallel::ForTiles(std::size_t count,
+                        std::size_t tileSize,
+                        std::size_t numThreads,
+                        Function function)
+{
+    const std::size_t numTiles = (count + tileSize - 1) / tileSize;
+    numThreads = GetThreadCount(numThreads, numTiles);
+
+    std::atomic<std::size_t> nextTile(0);
+    auto worker = [&](std::size_t thread) {
+        for (std::size_t tile = nextTile++; tile < numTiles;
+             tile = nextTile++)
+        {
+            const std::size_t begin = tile * tileSize;
+            function(begin, std::min(begin + tileSize, count), thread);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (std::size_t thread = 1; thread < numThreads; ++thread)
+    {
+        threads.emplace_back(worker, thread);
+    }
+    worker(std::size_t(0));
+    for (std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+}
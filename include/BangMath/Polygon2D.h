@@ -21,6 +21,10 @@ public:
 
     void AddPoint(const Vector2G<T> &p);
     void SetPoint(int i, const Vector2G<T> &p);
+
+    // Points on the boundary are inside on its bottom and right sides, and
+    // outside on its top and left ones, as in PreparedPolygon2DG. Polygons
+    // that share edges do not both contain the points on them.
     bool Contains(const Vector2G<T> &p) const;
 
     const Vector2G<T> &GetPoint(int i) const;
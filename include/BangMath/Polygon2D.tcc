@@ -1,8 +1,9 @@
 #include "BangMath/Polygon2D.h"
 
 #include <cassert>
+#include <cstddef>
 
-#include "BangMath/Geometry.h"
+#include "BangMath/Vector2.h"
 
 namespace Bang
 {
@@ -19,35 +20,32 @@ void Polygon2DG<T>::SetPoint(int i, const Vector2G<T> &p)
     m_points[i] = p;
 }
 
+// Crossing number test with a ray towards -x. Edges are half open in y, so a
+// ray through a vertex counts exactly one of its two edges, and only the
+// edges strictly left of the point count, like in PreparedPolygon2DG. For
+// repeated queries on the same polygon use PreparedPolygon2DG.
 template <typename T>
 bool Polygon2DG<T>::Contains(const Vector2G<T> &p) const
 {
     assert(GetPoints().size() >= 3u);
 
-    auto minPoint = GetPoint(0);
-    auto maxPoint = GetPoint(0);
-    for (const Vector2G<T> &point : GetPoints())
+    bool inside = false;
+    const std::size_t numPoints = GetPoints().size();
+    for (std::size_t i = 0, j = numPoints - 1; i < numPoints; j = i++)
     {
-        minPoint = Vector2G<T>::Min(minPoint, point);
-        maxPoint = Vector2G<T>::Max(maxPoint, point);
+        const bool goesUp = (m_points[j].y < m_points[i].y);
+        const Vector2G<T> &from = m_points[goesUp ? j : i];
+        const Vector2G<T> &to = m_points[goesUp ? i : j];
+        // The edge is left of the point when the point is clockwise from it
+        // going upwards. Measured from the lower end as in PreparedPolygon2DG,
+        // so both round the same way.
+        if (from.y <= p.y && p.y < to.y &&
+            Vector2G<T>::Cross(to - from, p - from) < 0)
+        {
+            inside = !inside;
+        }
     }
-
-    const auto VeryFar = Vector2G<T>::Distance(minPoint, maxPoint) * 10;
-
-    auto intersectionCount = 0;
-    const auto testRay = Ray2DG<T>(p, p + Vector2G<T>(VeryFar));
-    for (uint i = 0; i < GetPoints().size(); ++i)
-    {
-        const auto segment =
-            Segment2DG<T>(GetPoint(i), GetPoint((i + 1) % GetPoints().size()));
-
-        bool intersected;
-        Vector2G<T> intersPoint;
-        Geometry::IntersectRay2DSegment2D(
-            testRay, segment, &intersected, &intersPoint);
-        intersectionCount += (intersected ? 1 : 0);
-    }
-    return (intersectionCount % 2) == 1;
+    return inside;
 }
 
 template <typename T>
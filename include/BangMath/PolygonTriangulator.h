@@ -0,0 +1,207 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector2.h"
+#include "BangMath/Vector3.h"
+
+/**
+ * Triangulation adapted from earcut, https://github.com/mapbox/earcut
+ *
+ * ISC License
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE
+ * OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+namespace Bang
+{
+template <typename>
+class PolygonG;
+template <typename>
+class Polygon2DG;
+template <typename>
+class TriangleG;
+template <typename>
+class Triangle2DG;
+
+// Triangulates simple polygons with holes, and decomposes them in convex
+// pieces. Keep one around and reuse it: its working buffers and the output
+// vectors passed to it keep their memory between calls.
+//
+// Triangulation is ear clipping on a linked ring. Holes are first joined to
+// the outer ring through bridges to visible vertices, leftmost hole first.
+// For large rings the vertices are also linked in z-order (Morton) order, so
+// checking that no reflex vertex lies inside an ear candidate only looks at
+// the vertices whose code is within the ear's bounding box. When no ear is
+// left (self touching or degenerate input) it filters collinear points,
+// cuts local self intersections and finally splits the ring by a valid
+// diagonal, so it always terminates with a best effort result.
+//
+// Convex decomposition merges the triangles across their shared edges while
+// both ends of the edge stay convex (Hertel-Mehlhorn), which gives at most
+// four times the minimum number of convex pieces.
+//
+// 2D results are counterclockwise. 3D polygons are triangulated on the axis
+// plane their normal is closest to, and results keep the polygon's winding.
+template <typename T>
+class PolygonTriangulatorG
+{
+public:
+    PolygonTriangulatorG() = default;
+
+    // points holds the outer ring followed by the holes, hole i starting at
+    // holeStarts[i]. Writes three indices into points per triangle.
+    void Triangulate(const Vector2G<T> *points,
+                     std::size_t count,
+                     const std::size_t *holeStarts,
+                     std::size_t numHoles,
+                     std::vector<std::uint32_t> *indicesOut);
+
+    // Indices refer to the polygon's points followed by the holes' points
+    void Triangulate(const Polygon2DG<T> &polygon,
+                     const std::vector<Polygon2DG<T>> &holes,
+                     std::vector<std::uint32_t> *indicesOut);
+    void Triangulate(const Polygon2DG<T> &polygon,
+                     const std::vector<Polygon2DG<T>> &holes,
+                     std::vector<Triangle2DG<T>> *trianglesOut);
+    void Triangulate(const PolygonG<T> &polygon,
+                     const std::vector<PolygonG<T>> &holes,
+                     std::vector<std::uint32_t> *indicesOut);
+    void Triangulate(const PolygonG<T> &polygon,
+                     const std::vector<PolygonG<T>> &holes,
+                     std::vector<TriangleG<T>> *trianglesOut);
+
+    // Merges counterclockwise triangles into convex polygons. Writes the
+    // indices of each polygon in order into polygonIndicesOut, polygon i
+    // going from (*polygonStartsOut)[i] to (*polygonStartsOut)[i + 1].
+    void ConvexDecompose(const Vector2G<T> *points,
+                         const std::vector<std::uint32_t> &triangleIndices,
+                         std::vector<std::uint32_t> *polygonIndicesOut,
+                         std::vector<std::uint32_t> *polygonStartsOut);
+
+    void ConvexDecompose(const Polygon2DG<T> &polygon,
+                         const std::vector<Polygon2DG<T>> &holes,
+                         std::vector<Polygon2DG<T>> *polygonsOut);
+    void ConvexDecompose(const PolygonG<T> &polygon,
+                         const std::vector<PolygonG<T>> &holes,
+                         std::vector<PolygonG<T>> *polygonsOut);
+
+private:
+    // Vertex of the rings being clipped, linked by index (-1 for none)
+    struct Node
+    {
+        Vector2G<T> point;
+        std::uint32_t index;
+        std::uint32_t z;
+        int prev;
+        int next;
+        int prevZ;
+        int nextZ;
+        bool steiner;
+    };
+
+    // Triangle corner for the convex decomposition: the edge from its
+    // vertex to the next corner's vertex, linked around its piece
+    struct HalfEdge
+    {
+        std::uint32_t vertex;
+        std::uint32_t prev;
+        std::uint32_t next;
+        std::uint32_t twin;
+        bool removed;
+    };
+
+    static constexpr std::uint32_t NullHalfEdge = 0xFFFFFFFFu;
+    // Rings with fewer points than this are clipped without z-order index
+    static constexpr std::size_t MinHashedPoints = 80;
+
+    std::vector<Node> m_nodes;
+    std::vector<int> m_holeQueue;
+    std::vector<int> m_sortedNodes;
+    std::vector<std::uint32_t> *m_indicesOut = nullptr;
+    Vector2G<T> m_min;
+    T m_invSize = T(0);
+
+    std::vector<HalfEdge> m_halfEdges;
+    std::vector<std::pair<std::uint64_t, std::uint32_t>> m_edgeKeys;
+
+    // Flattened input: 2D points (projected for 3D polygons), the 3D points
+    // for 3D polygons, and the start of every hole
+    std::vector<Vector2G<T>> m_points;
+    std::vector<Vector3G<T>> m_points3D;
+    std::vector<std::size_t> m_holeStarts;
+    std::vector<std::uint32_t> m_indices;
+    std::vector<std::uint32_t> m_polygonIndices;
+    std::vector<std::uint32_t> m_polygonStarts;
+
+    void Flatten(const Polygon2DG<T> &polygon,
+                 const std::vector<Polygon2DG<T>> &holes);
+    void Flatten(const PolygonG<T> &polygon,
+                 const std::vector<PolygonG<T>> &holes);
+
+    int CreateRing(const Vector2G<T> *points,
+                   std::size_t begin,
+                   std::size_t end,
+                   bool counterClockwise);
+    int InsertNode(std::uint32_t index, const Vector2G<T> &point, int last);
+    void RemoveNode(int node);
+    int SplitPolygon(int a, int b);
+    int FilterPoints(int start, int end = -1);
+
+    int EliminateHole(int hole, int outerNode);
+    int FindHoleBridge(int hole, int outerNode) const;
+    int GetLeftmost(int start) const;
+
+    void ClipEars(int ear, int pass);
+    bool IsEar(int ear) const;
+    bool IsEarHashed(int ear) const;
+    bool IsVertexInEar(int node, int a, int b, int c) const;
+    int CureLocalIntersections(int start);
+    void SplitEarClipping(int start);
+    void AddTriangle(int a, int b, int c);
+
+    void IndexCurve(int start);
+    std::uint32_t GetZOrder(const Vector2G<T> &point) const;
+
+    bool IsValidDiagonal(int a, int b) const;
+    bool IntersectsPolygon(int a, int b) const;
+    bool IsLocallyInside(int a, int b) const;
+    bool IsMiddleInside(int a, int b) const;
+    bool SectorContainsSector(int m, int p) const;
+    bool Equals(int a, int b) const;
+    T GetArea(int p, int q, int r) const;
+    bool Intersects(int p1, int q1, int p2, int q2) const;
+
+    static T GetSignedArea(const Vector2G<T> *points,
+                           std::size_t begin,
+                           std::size_t end);
+    static bool IsPointInTriangle(const Vector2G<T> &a,
+                                  const Vector2G<T> &b,
+                                  const Vector2G<T> &c,
+                                  const Vector2G<T> &p);
+    static bool IsOnSegment(const Vector2G<T> &p,
+                            const Vector2G<T> &q,
+                            const Vector2G<T> &r);
+    static int GetSign(T value);
+};
+
+BANG_MATH_DEFINE_USINGS(PolygonTriangulator)
+}
+
+#include "BangMath/PolygonTriangulator.tcc"
@@ -0,0 +1,1028 @@
+#include "BangMath/PolygonTriangulator.h"
+
+/**
+ * Triangulation adapted from earcut, https://github.com/mapbox/earcut
+ *
+ * ISC License
+ *
+ * Copyright (c) 2016, Mapbox
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH
+ * REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY
+ * AND FITNESS. IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT,
+ * INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM
+ * LOSS OF USE, DATA OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE
+ * OR OTHER TORTIOUS ACTION, ARISING OUT OF OR IN CONNECTION WITH THE USE OR
+ * PERFORMANCE OF THIS SOFTWARE.
+ */
+
+#include <algorithm>
+#include <limits>
+
+#include "BangMath/Axis.h"
+#include "BangMath/Math.h"
+#include "BangMath/Polygon.h"
+#include "BangMath/Polygon2D.h"
+#include "BangMath/Triangle.h"
+#include "BangMath/Triangle2D.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr std::uint32_t PolygonTriangulatorG<T>::NullHalfEdge;
+
+template <typename T>
+constexpr std::size_t PolygonTriangulatorG<T>::MinHashedPoints;
+
+template <typename T>
+void PolygonTriangulatorG<T>::Triangulate(
+    const Vector2G<T> *points,
+    std::size_t count,
+    const std::size_t *holeStarts,
+    std::size_t numHoles,
+    std::vector<std::uint32_t> *indicesOut)
+{
+    indicesOut->clear();
+    m_indicesOut = indicesOut;
+    m_nodes.clear();
+    m_invSize = T(0);
+
+    const std::size_t outerEnd = (numHoles > 0 ? holeStarts[0] : count);
+    int outerNode = CreateRing(points, 0, outerEnd, true);
+    if (outerNode < 0 || m_nodes[outerNode].next == m_nodes[outerNode].prev)
+    {
+        return;
+    }
+
+    if (numHoles > 0)
+    {
+        m_holeQueue.clear();
+        for (std::size_t i = 0; i < numHoles; ++i)
+        {
+            const std::size_t end =
+                (i + 1 < numHoles ? holeStarts[i + 1] : count);
+            const int hole = CreateRing(points, holeStarts[i], end, false);
+            if (hole >= 0)
+            {
+                if (hole == m_nodes[hole].next)
+                {
+                    m_nodes[hole].steiner = true;
+                }
+                m_holeQueue.push_back(GetLeftmost(hole));
+            }
+        }
+
+        // Leftmost holes first, so that the bridges of the next ones can go
+        // through them
+        std::sort(m_holeQueue.begin(), m_holeQueue.end(), [this](int a, int b) {
+            const Vector2G<T> &pa = m_nodes[a].point;
+            const Vector2G<T> &pb = m_nodes[b].point;
+            return (pa.x < pb.x) || (pa.x == pb.x && pa.y < pb.y);
+        });
+        for (int hole : m_holeQueue)
+        {
+            outerNode = EliminateHole(hole, outerNode);
+        }
+    }
+
+    if (count > MinHashedPoints)
+    {
+        m_min = points[0];
+        Vector2G<T> max = points[0];
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            m_min = Vector2G<T>::Min(m_min, points[i]);
+            max = Vector2G<T>::Max(max, points[i]);
+        }
+        const T size = Math::Max(max.x - m_min.x, max.y - m_min.y);
+        m_invSize = (size != 0 ? T(32767) / size : T(0));
+    }
+
+    ClipEars(outerNode, 0);
+    m_indicesOut = nullptr;
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::Triangulate(
+    const Polygon2DG<T> &polygon,
+    const std::vector<Polygon2DG<T>> &holes,
+    std::vector<std::uint32_t> *indicesOut)
+{
+    Flatten(polygon, holes);
+    Triangulate(m_points.data(),
+                m_points.size(),
+                m_holeStarts.data(),
+                m_holeStarts.size(),
+                indicesOut);
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::Triangulate(
+    const Polygon2DG<T> &polygon,
+    const std::vector<Polygon2DG<T>> &holes,
+    std::vector<Triangle2DG<T>> *trianglesOut)
+{
+    Triangulate(polygon, holes, &m_indices);
+    trianglesOut->clear();
+    for (std::size_t i = 0; i < m_indices.size(); i += 3)
+    {
+        trianglesOut->emplace_back(m_points[m_indices[i]],
+                                   m_points[m_indices[i + 1]],
+                                   m_points[m_indices[i + 2]]);
+    }
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::Triangulate(
+    const PolygonG<T> &polygon,
+    const std::vector<PolygonG<T>> &holes,
+    std::vector<std::uint32_t> *indicesOut)
+{
+    Flatten(polygon, holes);
+    Triangulate(m_points.data(),
+                m_points.size(),
+                m_holeStarts.data(),
+                m_holeStarts.size(),
+                indicesOut);
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::Triangulate(
+    const PolygonG<T> &polygon,
+    const std::vector<PolygonG<T>> &holes,
+    std::vector<TriangleG<T>> *trianglesOut)
+{
+    Triangulate(polygon, holes, &m_indices);
+    trianglesOut->clear();
+    for (std::size_t i = 0; i < m_indices.size(); i += 3)
+    {
+        trianglesOut->emplace_back(m_points3D[m_indices[i]],
+                                   m_points3D[m_indices[i + 1]],
+                                   m_points3D[m_indices[i + 2]]);
+    }
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::ConvexDecompose(
+    const Vector2G<T> *points,
+    const std::vector<std::uint32_t> &triangleIndices,
+    std::vector<std::uint32_t> *polygonIndicesOut,
+    std::vector<std::uint32_t> *polygonStartsOut)
+{
+    const std::size_t numHalfEdges = triangleIndices.size() / 3 * 3;
+    m_halfEdges.resize(numHalfEdges);
+    m_edgeKeys.clear();
+    for (std::size_t h = 0; h < numHalfEdges; ++h)
+    {
+        const std::size_t triangle = h - (h % 3);
+        HalfEdge &halfEdge = m_halfEdges[h];
+        halfEdge.vertex = triangleIndices[h];
+        halfEdge.next = static_cast<std::uint32_t>(triangle + (h + 1) % 3);
+        halfEdge.prev = static_cast<std::uint32_t>(triangle + (h + 2) % 3);
+        halfEdge.twin = NullHalfEdge;
+        halfEdge.removed = false;
+
+        const std::uint64_t from = triangleIndices[h];
+        const std::uint64_t to = triangleIndices[halfEdge.next];
+        const std::uint64_t key = (Math::Min(from, to) << 32) |
+                                  Math::Max(from, to);
+        m_edgeKeys.emplace_back(key, static_cast<std::uint32_t>(h));
+    }
+
+    // Shared edges are the keys found exactly twice, in opposite directions
+    std::sort(m_edgeKeys.begin(), m_edgeKeys.end());
+    for (std::size_t i = 0; i < m_edgeKeys.size();)
+    {
+        std::size_t end = i + 1;
+        while (end < m_edgeKeys.size() &&
+               m_edgeKeys[end].first == m_edgeKeys[i].first)
+        {
+            ++end;
+        }
+
+        if (end == i + 2)
+        {
+            const std::uint32_t h0 = m_edgeKeys[i].second;
+            const std::uint32_t h1 = m_edgeKeys[i + 1].second;
+            if (m_halfEdges[h0].vertex != m_halfEdges[h1].vertex)
+            {
+                m_halfEdges[h0].twin = h1;
+                m_halfEdges[h1].twin = h0;
+            }
+        }
+        i = end;
+    }
+
+    // Remove the shared edges whose two ends stay convex without them,
+    // joining the loops of half edges of their two sides
+    for (std::uint32_t h = 0; h < numHalfEdges; ++h)
+    {
+        const std::uint32_t twin = m_halfEdges[h].twin;
+        if (twin == NullHalfEdge || twin < h)
+        {
+            continue;
+        }
+
+        const HalfEdge &edge = m_halfEdges[h];
+        const HalfEdge &twinEdge = m_halfEdges[twin];
+        const Vector2G<T> &a = points[edge.vertex];
+        const Vector2G<T> &b = points[twinEdge.vertex];
+        const Vector2G<T> &beforeA = points[m_halfEdges[edge.prev].vertex];
+        const Vector2G<T> &afterA =
+            points[m_halfEdges[m_halfEdges[twinEdge.next].next].vertex];
+        const Vector2G<T> &beforeB = points[m_halfEdges[twinEdge.prev].vertex];
+        const Vector2G<T> &afterB =
+            points[m_halfEdges[m_halfEdges[edge.next].next].vertex];
+        if (Vector2G<T>::Cross(a - beforeA, afterA - a) < 0 ||
+            Vector2G<T>::Cross(b - beforeB, afterB - b) < 0)
+        {
+            continue;
+        }
+
+        const std::uint32_t edgePrev = edge.prev;
+        const std::uint32_t edgeNext = edge.next;
+        const std::uint32_t twinPrev = twinEdge.prev;
+        const std::uint32_t twinNext = twinEdge.next;
+        m_halfEdges[edgePrev].next = twinNext;
+        m_halfEdges[twinNext].prev = edgePrev;
+        m_halfEdges[twinPrev].next = edgeNext;
+        m_halfEdges[edgeNext].prev = twinPrev;
+        m_halfEdges[h].removed = true;
+        m_halfEdges[twin].removed = true;
+    }
+
+    polygonIndicesOut->clear();
+    polygonStartsOut->clear();
+    for (std::uint32_t h = 0; h < numHalfEdges; ++h)
+    {
+        if (m_halfEdges[h].removed)
+        {
+            continue;
+        }
+
+        polygonStartsOut->push_back(
+            static_cast<std::uint32_t>(polygonIndicesOut->size()));
+        std::uint32_t halfEdge = h;
+        do
+        {
+            polygonIndicesOut->push_back(m_halfEdges[halfEdge].vertex);
+            m_halfEdges[halfEdge].removed = true;
+            halfEdge = m_halfEdges[halfEdge].next;
+        } while (halfEdge != h);
+    }
+    polygonStartsOut->push_back(
+        static_cast<std::uint32_t>(polygonIndicesOut->size()));
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::ConvexDecompose(
+    const Polygon2DG<T> &polygon,
+    const std::vector<Polygon2DG<T>> &holes,
+    std::vector<Polygon2DG<T>> *polygonsOut)
+{
+    Triangulate(polygon, holes, &m_indices);
+    ConvexDecompose(
+        m_points.data(), m_indices, &m_polygonIndices, &m_polygonStarts);
+
+    polygonsOut->clear();
+    for (std::size_t i = 0; i + 1 < m_polygonStarts.size(); ++i)
+    {
+        polygonsOut->emplace_back();
+        for (std::uint32_t j = m_polygonStarts[i]; j < m_polygonStarts[i + 1];
+             ++j)
+        {
+            polygonsOut->back().AddPoint(m_points[m_polygonIndices[j]]);
+        }
+    }
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::ConvexDecompose(
+    const PolygonG<T> &polygon,
+    const std::vector<PolygonG<T>> &holes,
+    std::vector<PolygonG<T>> *polygonsOut)
+{
+    Triangulate(polygon, holes, &m_indices);
+    ConvexDecompose(
+        m_points.data(), m_indices, &m_polygonIndices, &m_polygonStarts);
+
+    polygonsOut->clear();
+    for (std::size_t i = 0; i + 1 < m_polygonStarts.size(); ++i)
+    {
+        polygonsOut->emplace_back();
+        for (std::uint32_t j = m_polygonStarts[i]; j < m_polygonStarts[i + 1];
+             ++j)
+        {
+            polygonsOut->back().AddPoint(m_points3D[m_polygonIndices[j]]);
+        }
+    }
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::Flatten(const Polygon2DG<T> &polygon,
+                                      const std::vector<Polygon2DG<T>> &holes)
+{
+    m_points = polygon.GetPoints();
+    m_holeStarts.clear();
+    for (const Polygon2DG<T> &hole : holes)
+    {
+        m_holeStarts.push_back(m_points.size());
+        m_points.insert(
+            m_points.end(), hole.GetPoints().begin(), hole.GetPoints().end());
+    }
+}
+
+// Projects on the axis plane closest to the polygon's plane, mirrored if
+// needed so that the outer ring is counterclockwise. The triangles found
+// are then counterclockwise when seen from the side the polygon faces.
+template <typename T>
+void PolygonTriangulatorG<T>::Flatten(const PolygonG<T> &polygon,
+                                      const std::vector<PolygonG<T>> &holes)
+{
+    m_points3D = polygon.GetPoints();
+    m_holeStarts.clear();
+    for (const PolygonG<T> &hole : holes)
+    {
+        m_holeStarts.push_back(m_points3D.size());
+        m_points3D.insert(m_points3D.end(),
+                          hole.GetPoints().begin(),
+                          hole.GetPoints().end());
+    }
+
+    // Newell's normal, robust to collinear and slightly non planar points
+    const std::size_t outerEnd = polygon.GetPoints().size();
+    Vector3G<T> normal = Vector3G<T>::Zero();
+    for (std::size_t i = 0, j = outerEnd - 1; i < outerEnd; j = i++)
+    {
+        const Vector3G<T> &pi = m_points3D[i];
+        const Vector3G<T> &pj = m_points3D[j];
+        normal.x += (pj.y - pi.y) * (pj.z + pi.z);
+        normal.y += (pj.z - pi.z) * (pj.x + pi.x);
+        normal.z += (pj.x - pi.x) * (pj.y + pi.y);
+    }
+    const Vector3G<T> absNormal = normal.Abs();
+    Axis3D axis = Axis3D::Z;
+    if (absNormal.x >= absNormal.y && absNormal.x >= absNormal.z)
+    {
+        axis = Axis3D::X;
+    }
+    else if (absNormal.y >= absNormal.z)
+    {
+        axis = Axis3D::Y;
+    }
+
+    m_points.clear();
+    for (const Vector3G<T> &point : m_points3D)
+    {
+        m_points.push_back(point.ProjectedOnAxis(axis));
+    }
+    if (outerEnd > 0 && GetSignedArea(m_points.data(), 0, outerEnd) < 0)
+    {
+        for (Vector2G<T> &point : m_points)
+        {
+            point.x = -point.x;
+        }
+    }
+}
+
+template <typename T>
+int PolygonTriangulatorG<T>::CreateRing(const Vector2G<T> *points,
+                                        std::size_t begin,
+                                        std::size_t end,
+                                        bool counterClockwise)
+{
+    int last = -1;
+    if (counterClockwise == (GetSignedArea(points, begin, end) > 0))
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            last = InsertNode(static_cast<std::uint32_t>(i), points[i], last);
+        }
+    }
+    else
+    {
+        for (std::size_t i = end; i-- > begin;)
+        {
+            last = InsertNode(static_cast<std::uint32_t>(i), points[i], last);
+        }
+    }
+
+    if (last >= 0 && Equals(last, m_nodes[last].next))
+    {
+        RemoveNode(last);
+        last = m_nodes[last].next;
+    }
+    return last;
+}
+
+template <typename T>
+int PolygonTriangulatorG<T>::InsertNode(std::uint32_t index,
+                                        const Vector2G<T> &point,
+                                        int last)
+{
+    const int node = static_cast<int>(m_nodes.size());
+    m_nodes.push_back({point, index, 0, node, node, -1, -1, false});
+    if (last >= 0)
+    {
+        const int next = m_nodes[last].next;
+        m_nodes[node].next = next;
+        m_nodes[node].prev = last;
+        m_nodes[next].prev = node;
+        m_nodes[last].next = node;
+    }
+    return node;
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::RemoveNode(int node)
+{
+    const Node &n = m_nodes[node];
+    m_nodes[n.next].prev = n.prev;
+    m_nodes[n.prev].next = n.next;
+    if (n.prevZ >= 0)
+    {
+        m_nodes[n.prevZ].nextZ = n.nextZ;
+    }
+    if (n.nextZ >= 0)
+    {
+        m_nodes[n.nextZ].prevZ = n.prevZ;
+    }
+}
+
+// Links a and b with a diagonal, splitting their ring in two. The first ring
+// keeps a and b, the second gets copies of them, which is returned.
+template <typename T>
+int PolygonTriangulatorG<T>::SplitPolygon(int a, int b)
+{
+    const int a2 = static_cast<int>(m_nodes.size());
+    const int b2 = a2 + 1;
+    const Node nodeA = m_nodes[a];
+    const Node nodeB = m_nodes[b];
+    m_nodes.push_back({nodeA.point, nodeA.index, 0, -1, -1, -1, -1, false});
+    m_nodes.push_back({nodeB.point, nodeB.index, 0, -1, -1, -1, -1, false});
+
+    const int an = nodeA.next;
+    const int bp = nodeB.prev;
+    m_nodes[a].next = b;
+    m_nodes[b].prev = a;
+    m_nodes[a2].next = an;
+    m_nodes[an].prev = a2;
+    m_nodes[b2].next = a2;
+    m_nodes[a2].prev = b2;
+    m_nodes[bp].next = b2;
+    m_nodes[b2].prev = bp;
+    return b2;
+}
+
+// Removes duplicated and collinear points from start up to end
+template <typename T>
+int PolygonTriangulatorG<T>::FilterPoints(int start, int end)
+{
+    if (start < 0)
+    {
+        return start;
+    }
+    if (end < 0)
+    {
+        end = start;
+    }
+
+    int p = start;
+    bool again;
+    do
+    {
+        again = false;
+        const Node &node = m_nodes[p];
+        if (!node.steiner &&
+            (Equals(p, node.next) || GetArea(node.prev, p, node.next) == 0))
+        {
+            RemoveNode(p);
+            p = end = m_nodes[p].prev;
+            if (p == m_nodes[p].next)
+            {
+                break;
+            }
+            again = true;
+        }
+        else
+        {
+            p = node.next;
+        }
+    } while (again || p != end);
+    return end;
+}
+
+template <typename T>
+int PolygonTriangulatorG<T>::EliminateHole(int hole, int outerNode)
+{
+    const int bridge = FindHoleBridge(hole, outerNode);
+    if (bridge < 0)
+    {
+        return outerNode;
+    }
+
+    const int bridgeReverse = SplitPolygon(bridge, hole);
+    FilterPoints(bridgeReverse, m_nodes[bridgeReverse].next);
+    return FilterPoints(bridge, m_nodes[bridge].next);
+}
+
+// Finds a vertex of the outer ring visible from the hole's leftmost vertex:
+// the closest end of the first edge hit by a ray towards -x, or a reflex
+// vertex inside the triangle it forms with the hit point if there is one
+template <typename T>
+int PolygonTriangulatorG<T>::FindHoleBridge(int hole, int outerNode) const
+{
+    const Vector2G<T> &h = m_nodes[hole].point;
+    T qx = -std::numeric_limits<T>::infinity();
+    int m = -1;
+
+    int p = outerNode;
+    do
+    {
+        const Vector2G<T> &pp = m_nodes[p].point;
+        const Vector2G<T> &pn = m_nodes[m_nodes[p].next].point;
+        if (h.y <= pp.y && h.y >= pn.y && pn.y != pp.y)
+        {
+            const T x = pp.x + (h.y - pp.y) * (pn.x - pp.x) / (pn.y - pp.y);
+            if (x <= h.x && x > qx)
+            {
+                qx = x;
+                m = (pp.x < pn.x ? p : m_nodes[p].next);
+                if (x == h.x)
+                {
+                    // The hole touches the outer ring at this vertex
+                    return m;
+                }
+            }
+        }
+        p = m_nodes[p].next;
+    } while (p != outerNode);
+
+    if (m < 0)
+    {
+        return -1;
+    }
+
+    const int stop = m;
+    const Vector2G<T> mp = m_nodes[m].point;
+    T tanMin = std::numeric_limits<T>::infinity();
+    p = m;
+    do
+    {
+        const Vector2G<T> &pp = m_nodes[p].point;
+        if (h.x >= pp.x && pp.x >= mp.x && h.x != pp.x &&
+            IsPointInTriangle(Vector2G<T>(h.y < mp.y ? h.x : qx, h.y),
+                              mp,
+                              Vector2G<T>(h.y < mp.y ? qx : h.x, h.y),
+                              pp))
+        {
+            const T tan = Math::Abs(h.y - pp.y) / (h.x - pp.x);
+            const Vector2G<T> &bestPoint = m_nodes[m].point;
+            if (IsLocallyInside(p, hole) &&
+                (tan < tanMin ||
+                 (tan == tanMin &&
+                  (pp.x > bestPoint.x ||
+                   (pp.x == bestPoint.x && SectorContainsSector(m, p))))))
+            {
+                m = p;
+                tanMin = tan;
+            }
+        }
+        p = m_nodes[p].next;
+    } while (p != stop);
+    return m;
+}
+
+template <typename T>
+int PolygonTriangulatorG<T>::GetLeftmost(int start) const
+{
+    int p = start;
+    int leftmost = start;
+    do
+    {
+        const Vector2G<T> &pp = m_nodes[p].point;
+        const Vector2G<T> &pl = m_nodes[leftmost].point;
+        if (pp.x < pl.x || (pp.x == pl.x && pp.y < pl.y))
+        {
+            leftmost = p;
+        }
+        p = m_nodes[p].next;
+    } while (p != start);
+    return leftmost;
+}
+
+// Clips ears around the ring until a full turn finds none. Then pass 0
+// retries without collinear points, pass 1 also cuts local self
+// intersections, and pass 2 splits the ring in two by a valid diagonal.
+template <typename T>
+void PolygonTriangulatorG<T>::ClipEars(int ear, int pass)
+{
+    if (ear < 0)
+    {
+        return;
+    }
+    if (pass == 0 && m_invSize != 0)
+    {
+        IndexCurve(ear);
+    }
+
+    int stop = ear;
+    while (m_nodes[ear].prev != m_nodes[ear].next)
+    {
+        const int prev = m_nodes[ear].prev;
+        const int next = m_nodes[ear].next;
+        if (m_invSize != 0 ? IsEarHashed(ear) : IsEar(ear))
+        {
+            AddTriangle(prev, ear, next);
+            RemoveNode(ear);
+            ear = m_nodes[next].next;
+            stop = ear;
+            continue;
+        }
+
+        ear = next;
+        if (ear == stop)
+        {
+            if (pass == 0)
+            {
+                ClipEars(FilterPoints(ear), 1);
+            }
+            else if (pass == 1)
+            {
+                ClipEars(CureLocalIntersections(FilterPoints(ear)), 2);
+            }
+            else
+            {
+                SplitEarClipping(ear);
+            }
+            break;
+        }
+    }
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::IsEar(int ear) const
+{
+    const int a = m_nodes[ear].prev;
+    const int c = m_nodes[ear].next;
+    if (GetArea(a, ear, c) >= 0)
+    {
+        // Reflex
+        return false;
+    }
+
+    for (int p = m_nodes[c].next; p != a; p = m_nodes[p].next)
+    {
+        if (IsVertexInEar(p, a, ear, c))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Same as IsEar, but only looks at the vertices whose z-order is within the
+// one of the ear's bounding box, walking from the ear in both directions
+template <typename T>
+bool PolygonTriangulatorG<T>::IsEarHashed(int ear) const
+{
+    const int a = m_nodes[ear].prev;
+    const int c = m_nodes[ear].next;
+    if (GetArea(a, ear, c) >= 0)
+    {
+        return false;
+    }
+
+    const Vector2G<T> &pa = m_nodes[a].point;
+    const Vector2G<T> &pb = m_nodes[ear].point;
+    const Vector2G<T> &pc = m_nodes[c].point;
+    const std::uint32_t minZ =
+        GetZOrder(Vector2G<T>::Min(Vector2G<T>::Min(pa, pb), pc));
+    const std::uint32_t maxZ =
+        GetZOrder(Vector2G<T>::Max(Vector2G<T>::Max(pa, pb), pc));
+
+    int p = m_nodes[ear].prevZ;
+    int n = m_nodes[ear].nextZ;
+    while (p >= 0 && m_nodes[p].z >= minZ && n >= 0 && m_nodes[n].z <= maxZ)
+    {
+        if (IsVertexInEar(p, a, ear, c) || IsVertexInEar(n, a, ear, c))
+        {
+            return false;
+        }
+        p = m_nodes[p].prevZ;
+        n = m_nodes[n].nextZ;
+    }
+    for (; p >= 0 && m_nodes[p].z >= minZ; p = m_nodes[p].prevZ)
+    {
+        if (IsVertexInEar(p, a, ear, c))
+        {
+            return false;
+        }
+    }
+    for (; n >= 0 && m_nodes[n].z <= maxZ; n = m_nodes[n].nextZ)
+    {
+        if (IsVertexInEar(n, a, ear, c))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Whether node is a reflex vertex, other than a and c, in the triangle abc
+template <typename T>
+bool PolygonTriangulatorG<T>::IsVertexInEar(int node,
+                                            int a,
+                                            int b,
+                                            int c) const
+{
+    if (node == a || node == c)
+    {
+        return false;
+    }
+
+    const Vector2G<T> &p = m_nodes[node].point;
+    const Vector2G<T> &pa = m_nodes[a].point;
+    const Vector2G<T> &pb = m_nodes[b].point;
+    const Vector2G<T> &pc = m_nodes[c].point;
+    return p.x >= Math::Min(pa.x, Math::Min(pb.x, pc.x)) &&
+           p.x <= Math::Max(pa.x, Math::Max(pb.x, pc.x)) &&
+           p.y >= Math::Min(pa.y, Math::Min(pb.y, pc.y)) &&
+           p.y <= Math::Max(pa.y, Math::Max(pb.y, pc.y)) &&
+           IsPointInTriangle(pa, pb, pc, p) &&
+           GetArea(m_nodes[node].prev, node, m_nodes[node].next) >= 0;
+}
+
+// Clips the vertices whose two edges cross each other's neighbours
+template <typename T>
+int PolygonTriangulatorG<T>::CureLocalIntersections(int start)
+{
+    int p = start;
+    do
+    {
+        const int a = m_nodes[p].prev;
+        const int next = m_nodes[p].next;
+        const int b = m_nodes[next].next;
+        if (!Equals(a, b) && Intersects(a, p, next, b) &&
+            IsLocallyInside(a, b) && IsLocallyInside(b, a))
+        {
+            AddTriangle(a, p, b);
+            RemoveNode(p);
+            RemoveNode(next);
+            p = start = b;
+        }
+        p = m_nodes[p].next;
+    } while (p != start);
+    return FilterPoints(p);
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::SplitEarClipping(int start)
+{
+    int a = start;
+    do
+    {
+        for (int b = m_nodes[m_nodes[a].next].next; b != m_nodes[a].prev;
+             b = m_nodes[b].next)
+        {
+            if (m_nodes[a].index != m_nodes[b].index && IsValidDiagonal(a, b))
+            {
+                int c = SplitPolygon(a, b);
+                a = FilterPoints(a, m_nodes[a].next);
+                c = FilterPoints(c, m_nodes[c].next);
+                ClipEars(a, 0);
+                ClipEars(c, 0);
+                return;
+            }
+        }
+        a = m_nodes[a].next;
+    } while (a != start);
+}
+
+template <typename T>
+void PolygonTriangulatorG<T>::AddTriangle(int a, int b, int c)
+{
+    m_indicesOut->push_back(m_nodes[a].index);
+    m_indicesOut->push_back(m_nodes[b].index);
+    m_indicesOut->push_back(m_nodes[c].index);
+}
+
+// Links the ring's nodes sorted by z-order through prevZ and nextZ
+template <typename T>
+void PolygonTriangulatorG<T>::IndexCurve(int start)
+{
+    m_sortedNodes.clear();
+    int p = start;
+    do
+    {
+        Node &node = m_nodes[p];
+        if (node.z == 0)
+        {
+            node.z = GetZOrder(node.point);
+        }
+        m_sortedNodes.push_back(p);
+        p = node.next;
+    } while (p != start);
+
+    std::sort(m_sortedNodes.begin(), m_sortedNodes.end(), [this](int a, int b) {
+        return m_nodes[a].z < m_nodes[b].z;
+    });
+    for (std::size_t i = 0; i < m_sortedNodes.size(); ++i)
+    {
+        Node &node = m_nodes[m_sortedNodes[i]];
+        node.prevZ = (i > 0 ? m_sortedNodes[i - 1] : -1);
+        node.nextZ = (i + 1 < m_sortedNodes.size() ? m_sortedNodes[i + 1] : -1);
+    }
+}
+
+// Interleaves the bits of the point's 15 bit coordinates in the bounds
+template <typename T>
+std::uint32_t PolygonTriangulatorG<T>::GetZOrder(const Vector2G<T> &point) const
+{
+    auto x = static_cast<std::uint32_t>((point.x - m_min.x) * m_invSize);
+    auto y = static_cast<std::uint32_t>((point.y - m_min.y) * m_invSize);
+
+    x = (x | (x << 8)) & 0x00FF00FFu;
+    x = (x | (x << 4)) & 0x0F0F0F0Fu;
+    x = (x | (x << 2)) & 0x33333333u;
+    x = (x | (x << 1)) & 0x55555555u;
+
+    y = (y | (y << 8)) & 0x00FF00FFu;
+    y = (y | (y << 4)) & 0x0F0F0F0Fu;
+    y = (y | (y << 2)) & 0x33333333u;
+    y = (y | (y << 1)) & 0x55555555u;
+
+    return x | (y << 1);
+}
+
+// Whether the diagonal ab is inside the ring and crosses none of its edges
+template <typename T>
+bool PolygonTriangulatorG<T>::IsValidDiagonal(int a, int b) const
+{
+    const Node &na = m_nodes[a];
+    const Node &nb = m_nodes[b];
+    if (m_nodes[na.next].index == nb.index ||
+        m_nodes[na.prev].index == nb.index || IntersectsPolygon(a, b))
+    {
+        return false;
+    }
+
+    if (IsLocallyInside(a, b) && IsLocallyInside(b, a) && IsMiddleInside(a, b))
+    {
+        // Not collinear with the edges around b
+        return GetArea(na.prev, a, nb.prev) != 0 ||
+               GetArea(a, nb.prev, b) != 0;
+    }
+
+    // Zero length diagonal between two convex copies of a point
+    return Equals(a, b) && GetArea(na.prev, a, na.next) > 0 &&
+           GetArea(nb.prev, b, nb.next) > 0;
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::IntersectsPolygon(int a, int b) const
+{
+    const std::uint32_t ia = m_nodes[a].index;
+    const std::uint32_t ib = m_nodes[b].index;
+    int p = a;
+    do
+    {
+        const int next = m_nodes[p].next;
+        const std::uint32_t ip = m_nodes[p].index;
+        const std::uint32_t in = m_nodes[next].index;
+        if (ip != ia && in != ia && ip != ib && in != ib &&
+            Intersects(p, next, a, b))
+        {
+            return true;
+        }
+        p = next;
+    } while (p != a);
+    return false;
+}
+
+// Whether the diagonal from a towards b starts inside the ring
+template <typename T>
+bool PolygonTriangulatorG<T>::IsLocallyInside(int a, int b) const
+{
+    const Node &na = m_nodes[a];
+    if (GetArea(na.prev, a, na.next) < 0)
+    {
+        return GetArea(a, b, na.next) >= 0 && GetArea(a, na.prev, b) >= 0;
+    }
+    return GetArea(a, b, na.prev) < 0 || GetArea(a, na.next, b) < 0;
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::IsMiddleInside(int a, int b) const
+{
+    const Vector2G<T> middle =
+        (m_nodes[a].point + m_nodes[b].point) / static_cast<T>(2);
+    bool inside = false;
+    int p = a;
+    do
+    {
+        const Vector2G<T> &pp = m_nodes[p].point;
+        const Vector2G<T> &pn = m_nodes[m_nodes[p].next].point;
+        if ((pp.y > middle.y) != (pn.y > middle.y) && pn.y != pp.y &&
+            middle.x < (pn.x - pp.x) * (middle.y - pp.y) / (pn.y - pp.y) + pp.x)
+        {
+            inside = !inside;
+        }
+        p = m_nodes[p].next;
+    } while (p != a);
+    return inside;
+}
+
+// Whether the sector of the ring at m contains the one at p, for bridges
+// to a point shared by several sectors
+template <typename T>
+bool PolygonTriangulatorG<T>::SectorContainsSector(int m, int p) const
+{
+    return GetArea(m_nodes[m].prev, m, m_nodes[p].prev) < 0 &&
+           GetArea(m_nodes[p].next, m, m_nodes[m].next) < 0;
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::Equals(int a, int b) const
+{
+    return m_nodes[a].point == m_nodes[b].point;
+}
+
+// Twice the signed area of pqr, negative when counterclockwise
+template <typename T>
+T PolygonTriangulatorG<T>::GetArea(int p, int q, int r) const
+{
+    const Vector2G<T> &pp = m_nodes[p].point;
+    const Vector2G<T> &pq = m_nodes[q].point;
+    const Vector2G<T> &pr = m_nodes[r].point;
+    return (pq.y - pp.y) * (pr.x - pq.x) - (pq.x - pp.x) * (pr.y - pq.y);
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::Intersects(int p1, int q1, int p2, int q2) const
+{
+    const int o1 = GetSign(GetArea(p1, q1, p2));
+    const int o2 = GetSign(GetArea(p1, q1, q2));
+    const int o3 = GetSign(GetArea(p2, q2, p1));
+    const int o4 = GetSign(GetArea(p2, q2, q1));
+    if (o1 != o2 && o3 != o4)
+    {
+        return true;
+    }
+
+    // Collinear cases
+    const Vector2G<T> &a1 = m_nodes[p1].point;
+    const Vector2G<T> &b1 = m_nodes[q1].point;
+    const Vector2G<T> &a2 = m_nodes[p2].point;
+    const Vector2G<T> &b2 = m_nodes[q2].point;
+    return (o1 == 0 && IsOnSegment(a1, a2, b1)) ||
+           (o2 == 0 && IsOnSegment(a1, b2, b1)) ||
+           (o3 == 0 && IsOnSegment(a2, a1, b2)) ||
+           (o4 == 0 && IsOnSegment(a2, b1, b2));
+}
+
+// Twice the signed area of the ring, positive when counterclockwise
+template <typename T>
+T PolygonTriangulatorG<T>::GetSignedArea(const Vector2G<T> *points,
+                                         std::size_t begin,
+                                         std::size_t end)
+{
+    T sum = T(0);
+    for (std::size_t i = begin, j = end - 1; i < end; j = i++)
+    {
+        sum += (points[j].x - points[i].x) * (points[i].y + points[j].y);
+    }
+    return sum;
+}
+
+template <typename T>
+bool PolygonTriangulatorG<T>::IsPointInTriangle(const Vector2G<T> &a,
+                                                const Vector2G<T> &b,
+                                                const Vector2G<T> &c,
+                                                const Vector2G<T> &p)
+{
+    return (c.x - p.x) * (a.y - p.y) >= (a.x - p.x) * (c.y - p.y) &&
+           (a.x - p.x) * (b.y - p.y) >= (b.x - p.x) * (a.y - p.y) &&
+           (b.x - p.x) * (c.y - p.y) >= (c.x - p.x) * (b.y - p.y);
+}
+
+// Whether q, collinear with p and r, is between them
+template <typename T>
+bool PolygonTriangulatorG<T>::IsOnSegment(const Vector2G<T> &p,
+                                          const Vector2G<T> &q,
+                                          const Vector2G<T> &r)
+{
+    return q.x <= Math::Max(p.x, r.x) && q.x >= Math::Min(p.x, r.x) &&
+           q.y <= Math::Max(p.y, r.y) && q.y >= Math::Min(p.y, r.y);
+}
+
+template <typename T>
+int PolygonTriangulatorG<T>::GetSign(T value)
+{
+    return (value > 0 ? 1 : (value < 0 ? -1 : 0));
+}
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Vector2.h"
+
+namespace Bang
+{
+template <typename>
+class AARectG;
+template <typename>
+class Polygon2DG;
+
+// Point in polygon index for polygons queried many times. Build() splits the
+// plane in horizontal slabs at the vertices' y, and stores for every slab the
+// edges crossing it sorted from left to right. Contains() finds the slab and
+// counts the edges left of the point with two binary searches, so it takes
+// O(log N) instead of testing all the edges.
+//
+// Several rings can be given (outer boundaries and holes), combined with the
+// even-odd rule. Rings must not cross each other nor themselves, so that the
+// edges of a slab keep their order along it. Slabs are half open in y and
+// only the edges strictly left of the point are counted, so points on the
+// boundary are inside on its bottom and right sides, and outside on its top
+// and left ones. Polygon2DG::Contains follows the same convention, with the
+// same results.
+//
+// Memory is the sum of the edges crossing each slab, O(N) to O(N^2) for
+// very jagged polygons.
+template <typename T>
+class PreparedPolygon2DG
+{
+public:
+    PreparedPolygon2DG() = default;
+    explicit PreparedPolygon2DG(const Polygon2DG<T> &polygon);
+
+    void Build(const Polygon2DG<T> &polygon);
+    void Build(const std::vector<Polygon2DG<T>> &rings);
+    void Build(const Vector2G<T> *points, std::size_t count);
+    void Clear();
+
+    bool Contains(const Vector2G<T> &point) const;
+
+    // Writes in containedOut[i] whether points[i] is inside. The points are
+    // split in tiles that numThreads threads pick in order, 0 using as many
+    // as the hardware supports.
+    void Contains(const Vector2G<T> *points,
+                  std::size_t count,
+                  bool *containedOut,
+                  std::size_t numThreads = 1) const;
+
+    bool IsEmpty() const;
+    AARectG<T> GetBoundingRect() const;
+    std::size_t GetEdgeCount() const;
+    std::size_t GetSlabCount() const;
+
+private:
+    // Edge with from.y < to.y
+    struct Edge
+    {
+        Vector2G<T> from;
+        Vector2G<T> to;
+    };
+
+    Vector2G<T> m_min = Vector2G<T>::Infinity();
+    Vector2G<T> m_max = Vector2G<T>::NInfinity();
+    std::vector<Edge> m_edges;
+
+    // Slab s goes from m_slabYs[s] to m_slabYs[s + 1], and its edges are
+    // m_slabEdges[m_slabStarts[s]] to m_slabEdges[m_slabStarts[s + 1]]
+    std::vector<T> m_slabYs;
+    std::vector<std::uint32_t> m_slabStarts;
+    std::vector<std::uint32_t> m_slabEdges;
+
+    // Points handed to a thread at a time in the batch version
+    static constexpr std::size_t PointsPerTile = 1024;
+
+    void AddRing(const Vector2G<T> *points, std::size_t count);
+    void BuildSlabs();
+};
+
+BANG_MATH_DEFINE_USINGS(PreparedPolygon2D)
+}
+
+#include "BangMath/PreparedPolygon2D.tcc"
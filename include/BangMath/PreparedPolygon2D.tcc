@@ -0,0 +1,229 @@
+#include "BangMath/PreparedPolygon2D.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "BangMath/AARect.h"
+#include "BangMath/Parallel.h"
+#include "BangMath/Polygon2D.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr std::size_t PreparedPolygon2DG<T>::PointsPerTile;
+
+template <typename T>
+PreparedPolygon2DG<T>::PreparedPolygon2DG(const Polygon2DG<T> &polygon)
+{
+    Build(polygon);
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::Build(const Polygon2DG<T> &polygon)
+{
+    const std::vector<Vector2G<T>> &points = polygon.GetPoints();
+    Build(points.data(), points.size());
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::Build(const std::vector<Polygon2DG<T>> &rings)
+{
+    Clear();
+    for (const Polygon2DG<T> &ring : rings)
+    {
+        AddRing(ring.GetPoints().data(), ring.GetPoints().size());
+    }
+    BuildSlabs();
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::Build(const Vector2G<T> *points,
+                                  std::size_t count)
+{
+    Clear();
+    AddRing(points, count);
+    BuildSlabs();
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::Clear()
+{
+    m_min = Vector2G<T>::Infinity();
+    m_max = Vector2G<T>::NInfinity();
+    m_edges.clear();
+    m_slabYs.clear();
+    m_slabStarts.clear();
+    m_slabEdges.clear();
+}
+
+template <typename T>
+bool PreparedPolygon2DG<T>::Contains(const Vector2G<T> &point) const
+{
+    if (IsEmpty() || point.x < m_min.x || point.x > m_max.x ||
+        point.y < m_slabYs.front() || point.y >= m_slabYs.back())
+    {
+        return false;
+    }
+
+    const std::size_t slab =
+        std::upper_bound(m_slabYs.begin(), m_slabYs.end(), point.y) -
+        m_slabYs.begin() - 1;
+    const std::uint32_t *begin = m_slabEdges.data() + m_slabStarts[slab];
+    const std::uint32_t *end = m_slabEdges.data() + m_slabStarts[slab + 1];
+
+    // The edges of the slab go upwards, so the ones left of the point are
+    // those the point is clockwise from
+    const std::uint32_t *firstRight =
+        std::partition_point(begin, end, [&](std::uint32_t edgeIndex) {
+            const Edge &edge = m_edges[edgeIndex];
+            return Vector2G<T>::Cross(edge.to - edge.from,
+                                      point - edge.from) < 0;
+        });
+    return ((firstRight - begin) % 2) == 1;
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::Contains(const Vector2G<T> *points,
+                                     std::size_t count,
+                                     bool *containedOut,
+                                     std::size_t numThreads) const
+{
+    Parallel::ForTiles(
+        count,
+        PointsPerTile,
+        numThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                containedOut[i] = Contains(points[i]);
+            }
+        });
+}
+
+template <typename T>
+bool PreparedPolygon2DG<T>::IsEmpty() const
+{
+    return m_slabYs.size() < 2;
+}
+
+template <typename T>
+AARectG<T> PreparedPolygon2DG<T>::GetBoundingRect() const
+{
+    AARectG<T> rect;
+    rect.SetMin(m_min);
+    rect.SetMax(m_max);
+    return rect;
+}
+
+template <typename T>
+std::size_t PreparedPolygon2DG<T>::GetEdgeCount() const
+{
+    return m_edges.size();
+}
+
+template <typename T>
+std::size_t PreparedPolygon2DG<T>::GetSlabCount() const
+{
+    return (IsEmpty() ? 0 : m_slabYs.size() - 1);
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::AddRing(const Vector2G<T> *points,
+                                    std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Vector2G<T> &from = points[i];
+        const Vector2G<T> &to = points[(i + 1) % count];
+        m_min = Vector2G<T>::Min(m_min, from);
+        m_max = Vector2G<T>::Max(m_max, from);
+
+        // Horizontal edges never cross a slab
+        if (from.y != to.y)
+        {
+            const bool goesUp = (from.y < to.y);
+            m_edges.push_back({goesUp ? from : to, goesUp ? to : from});
+        }
+    }
+}
+
+template <typename T>
+void PreparedPolygon2DG<T>::BuildSlabs()
+{
+    for (const Edge &edge : m_edges)
+    {
+        m_slabYs.push_back(edge.from.y);
+        m_slabYs.push_back(edge.to.y);
+    }
+    std::sort(m_slabYs.begin(), m_slabYs.end());
+    m_slabYs.erase(std::unique(m_slabYs.begin(), m_slabYs.end()),
+                   m_slabYs.end());
+    if (IsEmpty())
+    {
+        m_slabYs.clear();
+        return;
+    }
+
+    // Every edge crosses the slabs from the one starting at its lower y to
+    // the one ending at its upper y. Count them per slab, then fill.
+    const std::size_t numSlabs = m_slabYs.size() - 1;
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> edgeSlabs;
+    edgeSlabs.reserve(m_edges.size());
+    m_slabStarts.assign(numSlabs + 1, 0);
+    for (const Edge &edge : m_edges)
+    {
+        const auto firstSlab = static_cast<std::uint32_t>(
+            std::lower_bound(m_slabYs.begin(), m_slabYs.end(), edge.from.y) -
+            m_slabYs.begin());
+        const auto endSlab = static_cast<std::uint32_t>(
+            std::lower_bound(m_slabYs.begin() + firstSlab,
+                             m_slabYs.end(),
+                             edge.to.y) -
+            m_slabYs.begin());
+        edgeSlabs.emplace_back(firstSlab, endSlab);
+        for (std::uint32_t slab = firstSlab; slab < endSlab; ++slab)
+        {
+            ++m_slabStarts[slab + 1];
+        }
+    }
+    for (std::size_t slab = 0; slab < numSlabs; ++slab)
+    {
+        m_slabStarts[slab + 1] += m_slabStarts[slab];
+    }
+
+    std::vector<std::uint32_t> offsets(m_slabStarts.begin(),
+                                       m_slabStarts.end() - 1);
+    m_slabEdges.resize(m_slabStarts.back());
+    for (std::size_t i = 0; i < m_edges.size(); ++i)
+    {
+        for (std::uint32_t slab = edgeSlabs[i].first;
+             slab < edgeSlabs[i].second;
+             ++slab)
+        {
+            m_slabEdges[offsets[slab]++] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    // Sort the edges of each slab by their x at its middle. Edges do not
+    // cross, so that is their order all along the slab.
+    std::vector<std::pair<T, std::uint32_t>> sortedEdges;
+    for (std::size_t slab = 0; slab < numSlabs; ++slab)
+    {
+        const T midY = (m_slabYs[slab] + m_slabYs[slab + 1]) / T(2);
+        sortedEdges.clear();
+        for (std::uint32_t i = m_slabStarts[slab]; i < m_slabStarts[slab + 1];
+             ++i)
+        {
+            const Edge &edge = m_edges[m_slabEdges[i]];
+            const T t = (midY - edge.from.y) / (edge.to.y - edge.from.y);
+            const T x = edge.from.x + (edge.to.x - edge.from.x) * t;
+            sortedEdges.emplace_back(x, m_slabEdges[i]);
+        }
+        std::sort(sortedEdges.begin(), sortedEdges.end());
+        for (std::size_t i = 0; i < sortedEdges.size(); ++i)
+        {
+            m_slabEdges[m_slabStarts[slab] + i] = sortedEdges[i].second;
+        }
+    }
+}
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <ostream>
 
 #include "BangMath/Defines.h"
@@ -51,6 +52,43 @@ public:
                                 const QuaternionG<T> &_to,
                                 T t);
 
+    // Normalized lerp along the shortest path. Same path as SLerp, without
+    // the constant angular speed.
+    static QuaternionG<T> NLerp(const QuaternionG<T> &from,
+                                const QuaternionG<T> &to,
+                                T t);
+
+    // SLerp approximated by NLerp with a polynomial correction of t, so with
+    // no trigonometric calls. The rotation is off by less than 1e-4 radians
+    // between rotations up to 120 degrees apart, 8e-4 at worst.
+    static QuaternionG<T> FastSLerp(const QuaternionG<T> &from,
+                                    const QuaternionG<T> &to,
+                                    T t);
+
+    // Batch versions of NLerp and FastSLerp, from from[i] to to[i] by t or
+    // ts[i], four at a time with SIMD. out can be the same buffer as from or
+    // to.
+    static void NLerp(const QuaternionG<T> *from,
+                      const QuaternionG<T> *to,
+                      T t,
+                      QuaternionG<T> *out,
+                      std::size_t count);
+    static void NLerp(const QuaternionG<T> *from,
+                      const QuaternionG<T> *to,
+                      const T *ts,
+                      QuaternionG<T> *out,
+                      std::size_t count);
+    static void FastSLerp(const QuaternionG<T> *from,
+                          const QuaternionG<T> *to,
+                          T t,
+                          QuaternionG<T> *out,
+                          std::size_t count);
+    static void FastSLerp(const QuaternionG<T> *from,
+                          const QuaternionG<T> *to,
+                          const T *ts,
+                          QuaternionG<T> *out,
+                          std::size_t count);
+
     static QuaternionG<T> FromTo(const Vector3G<T> &from,
                                  const Vector3G<T> &to);
 
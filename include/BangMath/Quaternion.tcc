@@ -1,7 +1,10 @@
 #pragma once
 #include "BangMath/Quaternion.h"
 
+#include <cmath>
+
 #include "BangMath/Math.h"
+#include "BangMath/QuaternionSIMD.h"
 
 namespace Bang
 {
@@ -196,6 +199,69 @@ QuaternionG<T> QuaternionG<T>::SLerp(const QuaternionG<T> &from,
     }
 }
 
+template <typename T>
+QuaternionG<T> QuaternionG<T>::NLerp(const QuaternionG<T> &from,
+                                     const QuaternionG<T> &to,
+                                     T t)
+{
+    const T toWeight =
+        std::copysign(static_cast<T>(1), QuaternionG<T>::Dot(from, to)) * t;
+    return (from * (static_cast<T>(1) - t) + to * toWeight).Normalized();
+}
+
+template <typename T>
+QuaternionG<T> QuaternionG<T>::FastSLerp(const QuaternionG<T> &from,
+                                         const QuaternionG<T> &to,
+                                         T t)
+{
+    const T cosTheta = QuaternionG<T>::Dot(from, to);
+    const T lerpT = QuaternionSIMD::GetFastSLerpT(t, Math::Abs(cosTheta));
+    const T toWeight = std::copysign(static_cast<T>(1), cosTheta) * lerpT;
+    return (from * (static_cast<T>(1) - lerpT) + to * toWeight).Normalized();
+}
+
+template <typename T>
+void QuaternionG<T>::NLerp(const QuaternionG<T> *from,
+                           const QuaternionG<T> *to,
+                           T t,
+                           QuaternionG<T> *out,
+                           std::size_t count)
+{
+    QuaternionSIMD::NLerp(
+        from, to, static_cast<const T *>(nullptr), t, out, count);
+}
+
+template <typename T>
+void QuaternionG<T>::NLerp(const QuaternionG<T> *from,
+                           const QuaternionG<T> *to,
+                           const T *ts,
+                           QuaternionG<T> *out,
+                           std::size_t count)
+{
+    QuaternionSIMD::NLerp(from, to, ts, static_cast<T>(0), out, count);
+}
+
+template <typename T>
+void QuaternionG<T>::FastSLerp(const QuaternionG<T> *from,
+                               const QuaternionG<T> *to,
+                               T t,
+                               QuaternionG<T> *out,
+                               std::size_t count)
+{
+    QuaternionSIMD::FastSLerp(
+        from, to, static_cast<const T *>(nullptr), t, out, count);
+}
+
+template <typename T>
+void QuaternionG<T>::FastSLerp(const QuaternionG<T> *from,
+                               const QuaternionG<T> *to,
+                               const T *ts,
+                               QuaternionG<T> *out,
+                               std::size_t count)
+{
+    QuaternionSIMD::FastSLerp(from, to, ts, static_cast<T>(0), out, count);
+}
+
 template <typename T>
 QuaternionG<T> QuaternionG<T>::FromTo(const Vector3G<T> &from,
                                       const Vector3G<T> &to)
@@ -295,7 +361,7 @@ QuaternionG<T> &operator+=(QuaternionG<T> &lhs, const QuaternionG<T> &rhs)
 template <typename T, class OtherT>
 QuaternionG<T> operator*(const QuaternionG<T> &q, OtherT a)
 {
-    return q * static_cast<T>(a);
+    return a * q;
 }
 
 template <typename T, class OtherT>
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+#include "BangMath/Defines.h"
+#include "BangMath/SIMD.h"
+
+namespace Bang
+{
+template <typename>
+class Matrix4G;
+template <typename>
+class QuaternionG;
+template <typename>
+class Vector3G;
+
+// Kernels for the batch quaternion functions, written against SIMD4G. Four
+// quaternions are loaded at a time and transposed in registers, so each
+// lane holds one of them in x, y, z, w registers (structure of arrays)
+// without changing the memory layout. Tails, and types without an
+// accelerated backend, go through the scalar functions.
+class QuaternionSIMD
+{
+public:
+    // Interpolates from[i] to to[i] by ts[i], or by t when ts is null.
+    // FastSLerp corrects t so that the normalized lerp follows the slerp
+    // angle, see QuaternionG::FastSLerp.
+    template <typename T>
+    static void NLerp(const QuaternionG<T> *from,
+                      const QuaternionG<T> *to,
+                      const T *ts,
+                      T t,
+                      QuaternionG<T> *out,
+                      std::size_t count);
+    template <typename T>
+    static void FastSLerp(const QuaternionG<T> *from,
+                          const QuaternionG<T> *to,
+                          const T *ts,
+                          T t,
+                          QuaternionG<T> *out,
+                          std::size_t count);
+
+    // Matrix4G::RotateMatrix of every rotation, scaled and translated when
+    // scales and positions are not null
+    template <typename T>
+    static void TransformMatrices(const Vector3G<T> *positions,
+                                  const QuaternionG<T> *rotations,
+                                  const Vector3G<T> *scales,
+                                  Matrix4G<T> *out,
+                                  std::size_t count);
+
+    // Polynomial correction of the interpolation parameter for FastSLerp,
+    // from the absolute cosine of the angle between the quaternions. V is
+    // T or SIMD4G<T>.
+    template <typename V>
+    static V GetFastSLerpT(const V &t, const V &absCosTheta);
+
+    QuaternionSIMD() = delete;
+
+private:
+    template <bool Fast, typename T>
+    static void Interpolate(const QuaternionG<T> *from,
+                            const QuaternionG<T> *to,
+                            const T *ts,
+                            T t,
+                            QuaternionG<T> *out,
+                            std::size_t count);
+};
+}
+
+#include "BangMath/QuaternionSIMD.tcc"
@@ -0,0 +1,188 @@
+#include "BangMath/QuaternionSIMD.h"
+
+#include "BangMath/Matrix4.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Vector3.h"
+#include "BangMath/Vector4.h"
+
+namespace Bang
+{
+template <typename T>
+void QuaternionSIMD::NLerp(const QuaternionG<T> *from,
+                           const QuaternionG<T> *to,
+                           const T *ts,
+                           T t,
+                           QuaternionG<T> *out,
+                           std::size_t count)
+{
+    Interpolate<false>(from, to, ts, t, out, count);
+}
+
+template <typename T>
+void QuaternionSIMD::FastSLerp(const QuaternionG<T> *from,
+                               const QuaternionG<T> *to,
+                               const T *ts,
+                               T t,
+                               QuaternionG<T> *out,
+                               std::size_t count)
+{
+    Interpolate<true>(from, to, ts, t, out, count);
+}
+
+template <typename T>
+void QuaternionSIMD::TransformMatrices(const Vector3G<T> *positions,
+                                       const QuaternionG<T> *rotations,
+                                       const Vector3G<T> *scales,
+                                       Matrix4G<T> *out,
+                                       std::size_t count)
+{
+    std::size_t i = 0;
+    if (SIMD4G<T>::IsAccelerated)
+    {
+        const SIMD4G<T> zero(static_cast<T>(0));
+        const SIMD4G<T> one(static_cast<T>(1));
+        const SIMD4G<T> two(static_cast<T>(2));
+        for (; i + 4 <= count; i += 4)
+        {
+            SIMD4G<T> x = SIMD4G<T>::Load(&rotations[i].x);
+            SIMD4G<T> y = SIMD4G<T>::Load(&rotations[i + 1].x);
+            SIMD4G<T> z = SIMD4G<T>::Load(&rotations[i + 2].x);
+            SIMD4G<T> w = SIMD4G<T>::Load(&rotations[i + 3].x);
+            SIMD4G<T>::Transpose(x, y, z, w);
+
+            const SIMD4G<T> x2 = x * two, y2 = y * two, z2 = z * two;
+            const SIMD4G<T> xx = x * x2, yy = y * y2, zz = z * z2;
+            const SIMD4G<T> xy = x * y2, xz = x * z2, yz = y * z2;
+            const SIMD4G<T> wx = w * x2, wy = w * y2, wz = w * z2;
+
+            // Element lanes to the columns of every matrix
+            SIMD4G<T> columns[3][4] = {
+                {one - (yy + zz), xy + wz, xz - wy, zero},
+                {xy - wz, one - (xx + zz), yz + wx, zero},
+                {xz + wy, yz - wx, one - (xx + yy), zero}};
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                SIMD4G<T>::Transpose(
+                    columns[c][0], columns[c][1], columns[c][2], columns[c][3]);
+            }
+
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                Matrix4G<T> &m = out[i + k];
+                if (scales)
+                {
+                    const Vector3G<T> &scale = scales[i + k];
+                    (columns[0][k] * SIMD4G<T>(scale.x)).Store(&m.c0.x);
+                    (columns[1][k] * SIMD4G<T>(scale.y)).Store(&m.c1.x);
+                    (columns[2][k] * SIMD4G<T>(scale.z)).Store(&m.c2.x);
+                }
+                else
+                {
+                    columns[0][k].Store(&m.c0.x);
+                    columns[1][k].Store(&m.c1.x);
+                    columns[2][k].Store(&m.c2.x);
+                }
+                m.c3 = (positions ? Vector4G<T>(positions[i + k], 1)
+                                  : Vector4G<T>(0, 0, 0, 1));
+            }
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        Matrix4G<T> &m = out[i];
+        m = Matrix4G<T>::RotateMatrix(rotations[i]);
+        if (scales)
+        {
+            m.c0 *= scales[i].x;
+            m.c1 *= scales[i].y;
+            m.c2 *= scales[i].z;
+        }
+        if (positions)
+        {
+            m.SetTranslation(positions[i]);
+        }
+    }
+}
+
+template <typename V>
+V QuaternionSIMD::GetFastSLerpT(const V &t, const V &absCosTheta)
+{
+    // t + t (t - 1/2) (t - 1) k, with k a polynomial in the cosine fitted so
+    // that the angle of the normalized lerp matches the slerp one
+    const V &d = absCosTheta;
+    const V half(0.5);
+    const V a =
+        V(1.0904) + d * (V(-3.2452) + d * (V(3.55645) - d * V(1.43519)));
+    const V b = V(0.848013) + d * (V(-1.06021) + d * V(0.215638));
+    const V centeredT = t - half;
+    const V k = (a * centeredT * centeredT) + b;
+    return t + (t * centeredT * (t - V(1)) * k);
+}
+
+template <bool Fast, typename T>
+void QuaternionSIMD::Interpolate(const QuaternionG<T> *from,
+                                 const QuaternionG<T> *to,
+                                 const T *ts,
+                                 T t,
+                                 QuaternionG<T> *out,
+                                 std::size_t count)
+{
+    std::size_t i = 0;
+    if (SIMD4G<T>::IsAccelerated)
+    {
+        const SIMD4G<T> one(static_cast<T>(1));
+        const SIMD4G<T> uniformT(t);
+        for (; i + 4 <= count; i += 4)
+        {
+            SIMD4G<T> fx = SIMD4G<T>::Load(&from[i].x);
+            SIMD4G<T> fy = SIMD4G<T>::Load(&from[i + 1].x);
+            SIMD4G<T> fz = SIMD4G<T>::Load(&from[i + 2].x);
+            SIMD4G<T> fw = SIMD4G<T>::Load(&from[i + 3].x);
+            SIMD4G<T>::Transpose(fx, fy, fz, fw);
+            SIMD4G<T> tx = SIMD4G<T>::Load(&to[i].x);
+            SIMD4G<T> ty = SIMD4G<T>::Load(&to[i + 1].x);
+            SIMD4G<T> tz = SIMD4G<T>::Load(&to[i + 2].x);
+            SIMD4G<T> tw = SIMD4G<T>::Load(&to[i + 3].x);
+            SIMD4G<T>::Transpose(tx, ty, tz, tw);
+
+            // Going to -to when the angle is obtuse takes the short way
+            const SIMD4G<T> cosTheta =
+                (fx * tx) + (fy * ty) + (fz * tz) + (fw * tw);
+            const SIMD4G<T> sign = SIMD4G<T>::CopySign(one, cosTheta);
+            SIMD4G<T> lerpT = (ts ? SIMD4G<T>::Load(ts + i) : uniformT);
+            if (Fast)
+            {
+                lerpT = GetFastSLerpT(lerpT, cosTheta * sign);
+            }
+            const SIMD4G<T> fromWeight = one - lerpT;
+            const SIMD4G<T> toWeight = lerpT * sign;
+
+            SIMD4G<T> rx = (fx * fromWeight) + (tx * toWeight);
+            SIMD4G<T> ry = (fy * fromWeight) + (ty * toWeight);
+            SIMD4G<T> rz = (fz * fromWeight) + (tz * toWeight);
+            SIMD4G<T> rw = (fw * fromWeight) + (tw * toWeight);
+            const SIMD4G<T> invLength =
+                one / SIMD4G<T>::Sqrt((rx * rx) + (ry * ry) + (rz * rz) +
+                                      (rw * rw));
+            rx = rx * invLength;
+            ry = ry * invLength;
+            rz = rz * invLength;
+            rw = rw * invLength;
+
+            SIMD4G<T>::Transpose(rx, ry, rz, rw);
+            rx.Store(&out[i].x);
+            ry.Store(&out[i + 1].x);
+            rz.Store(&out[i + 2].x);
+            rw.Store(&out[i + 3].x);
+        }
+    }
+
+    for (; i < count; ++i)
+    {
+        const T lerpT = (ts ? ts[i] : t);
+        out[i] = (Fast ? QuaternionG<T>::FastSLerp(from[i], to[i], lerpT)
+                       : QuaternionG<T>::NLerp(from[i], to[i], lerpT));
+    }
+}
+}
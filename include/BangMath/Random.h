@@ -1,9 +1,10 @@
 #pragma once
 
 #include <cstddef>
-#include <cstdlib>
+#include <cstdint>
 
 #include "BangMath/Defines.h"
+#include "BangMath/RandomGenerator.h"
 
 namespace Bang
 {
@@ -17,10 +18,17 @@ template <typename>
 class ColorG;
 template <typename>
 class QuaternionG;
+template <typename>
+class TriangleG;
 
+// Static access to a RandomGenerator owned by the calling thread. Threads
+// never share state, so this is safe to use from any worker. SetSeed only
+// affects the calling thread.
 class Random
 {
 public:
+    static RandomGenerator<> &GetThreadGenerator();
+
     static void SetSeed(long seed);
 
     template <typename T = MathDefaultType>
@@ -36,9 +44,24 @@ public:
     template <typename T = MathDefaultType>
     static Vector2G<T> GetInsideUnitCircle();
 
+    template <typename T = MathDefaultType>
+    static Vector2G<T> GetOnUnitCircle();
+
     template <typename T = MathDefaultType>
     static Vector3G<T> GetInsideUnitSphere();
 
+    template <typename T = MathDefaultType>
+    static Vector3G<T> GetOnUnitSphere();
+
+    template <typename T>
+    static Vector3G<T> GetOnUnitHemisphere(const Vector3G<T> &normal);
+
+    template <typename T>
+    static Vector3G<T> GetCosineWeightedHemisphere(const Vector3G<T> &normal);
+
+    template <typename T>
+    static Vector3G<T> GetInsideTriangle(const TriangleG<T> &triangle);
+
     template <typename T = MathDefaultType>
     static Vector2G<T> GetRandomVector2();
 
@@ -57,6 +80,56 @@ public:
     template <typename T = MathDefaultType>
     static ColorG<T> GetColorOpaque();
 
+    template <typename T>
+    static void FillValues01(T *valuesOut, std::size_t count);
+
+    template <typename T>
+    static void FillRange(T *valuesOut,
+                          std::size_t count,
+                          T minIncluded,
+                          T maxExcluded);
+
+    template <typename T>
+    static void FillRandomVectors2(Vector2G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    static void FillRandomVectors3(Vector3G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    static void FillRandomVectors4(Vector4G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    static void FillRotations(QuaternionG<T> *rotationsOut, std::size_t count);
+
+    template <typename T>
+    static void FillInsideUnitCircle(Vector2G<T> *pointsOut,
+                                     std::size_t count);
+
+    template <typename T>
+    static void FillOnUnitCircle(Vector2G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    static void FillInsideUnitSphere(Vector3G<T> *pointsOut,
+                                     std::size_t count);
+
+    template <typename T>
+    static void FillOnUnitSphere(Vector3G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    static void FillOnUnitHemisphere(const Vector3G<T> &normal,
+                                     Vector3G<T> *directionsOut,
+                                     std::size_t count);
+
+    template <typename T>
+    static void FillCosineWeightedHemisphere(const Vector3G<T> &normal,
+                                             Vector3G<T> *directionsOut,
+                                             std::size_t count);
+
+    template <typename T>
+    static void FillInsideTriangle(const TriangleG<T> &triangle,
+                                   Vector3G<T> *pointsOut,
+                                   std::size_t count);
+
     Random() = delete;
 };
 
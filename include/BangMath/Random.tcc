@@ -1,94 +1,208 @@
 #include "BangMath/Random.h"
 
-#include "BangMath/Math.h"
+#include <atomic>
 
 namespace Bang
 {
+inline RandomGenerator<> &Random::GetThreadGenerator()
+{
+    // Threads get consecutive seeds, spread by the engine seeding
+    static std::atomic<std::uint64_t> s_threadCount(0);
+    thread_local RandomGenerator<> generator(s_threadCount++);
+    return generator;
+}
+
 inline void Random::SetSeed(long seed)
 {
-    srand(seed);
+    GetThreadGenerator().SetSeed(static_cast<std::uint64_t>(seed));
 }
 
 template <typename T>
 T Random::GetValue01()
 {
-    return static_cast<T>(rand()) / RAND_MAX;
+    return GetThreadGenerator().GetValue01<T>();
 }
 
 inline unsigned long long Random::GetValueLong()
 {
-    return static_cast<unsigned long long>(rand());
+    return GetThreadGenerator().GetBits64();
 }
 
 template <typename T>
 T Random::GetRange(T minIncluded, T maxExcluded)
 {
-    return static_cast<T>(Random::GetValue01() * (maxExcluded - minIncluded)) +
-           minIncluded;
+    return GetThreadGenerator().GetRange<T>(minIncluded, maxExcluded);
 }
 
 inline bool Random::GetBool()
 {
-    return (GetValue01() > 0.5f);
+    return GetThreadGenerator().GetBool();
 }
 
 template <typename T>
 Vector2G<T> Random::GetInsideUnitCircle()
 {
-    return Random::GetRandomVector2<T>().NormalizedSafe();
+    return GetThreadGenerator().GetInsideUnitCircle<T>();
+}
+
+template <typename T>
+Vector2G<T> Random::GetOnUnitCircle()
+{
+    return GetThreadGenerator().GetOnUnitCircle<T>();
 }
 
 template <typename T>
 Vector3G<T> Random::GetInsideUnitSphere()
 {
-    return Random::GetRandomVector3<T>().NormalizedSafe();
+    return GetThreadGenerator().GetInsideUnitSphere<T>();
+}
+
+template <typename T>
+Vector3G<T> Random::GetOnUnitSphere()
+{
+    return GetThreadGenerator().GetOnUnitSphere<T>();
+}
+
+template <typename T>
+Vector3G<T> Random::GetOnUnitHemisphere(const Vector3G<T> &normal)
+{
+    return GetThreadGenerator().GetOnUnitHemisphere(normal);
+}
+
+template <typename T>
+Vector3G<T> Random::GetCosineWeightedHemisphere(const Vector3G<T> &normal)
+{
+    return GetThreadGenerator().GetCosineWeightedHemisphere(normal);
+}
+
+template <typename T>
+Vector3G<T> Random::GetInsideTriangle(const TriangleG<T> &triangle)
+{
+    return GetThreadGenerator().GetInsideTriangle(triangle);
 }
 
 template <typename T>
 Vector2G<T> Random::GetRandomVector2()
 {
-    return Vector2G<T>(Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f));
+    return GetThreadGenerator().GetRandomVector2<T>();
 }
 
 template <typename T>
 Vector3G<T> Random::GetRandomVector3()
 {
-    return Vector3G<T>(Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f));
+    return GetThreadGenerator().GetRandomVector3<T>();
 }
 
 template <typename T>
 Vector4G<T> Random::GetRandomVector4()
 {
-    return Vector4G<T>(Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f),
-                       Random::GetRange(-1.0f, 1.0f));
+    return GetThreadGenerator().GetRandomVector4<T>();
 }
 
 template <typename T>
 QuaternionG<T> Random::GetRotation()
 {
-    const auto angle =
-        Random::GetRange(0.0f, 2.0f * static_cast<T>(Math::Pi<T>()));
-    return QuaternionG<T>::AngleAxis(angle, Random::GetInsideUnitSphere<T>());
+    return GetThreadGenerator().GetRotation<T>();
 }
 
 template <typename T>
 ColorG<T> Random::GetColor()
 {
-    return ColorG<T>(Random::GetValue01(),
-                     Random::GetValue01(),
-                     Random::GetValue01(),
-                     Random::GetValue01());
+    return GetThreadGenerator().GetColor<T>();
 }
 
 template <typename T>
 ColorG<T> Random::GetColorOpaque()
 {
-    return ColorG<T>(
-        Random::GetValue01(), Random::GetValue01(), Random::GetValue01(), 1.0f);
+    return GetThreadGenerator().GetColorOpaque<T>();
+}
+
+template <typename T>
+void Random::FillValues01(T *valuesOut, std::size_t count)
+{
+    GetThreadGenerator().FillValues01(valuesOut, count);
+}
+
+template <typename T>
+void Random::FillRange(T *valuesOut,
+                       std::size_t count,
+                       T minIncluded,
+                       T maxExcluded)
+{
+    GetThreadGenerator().FillRange(
+        valuesOut, count, minIncluded, maxExcluded);
+}
+
+template <typename T>
+void Random::FillRandomVectors2(Vector2G<T> *vectorsOut, std::size_t count)
+{
+    GetThreadGenerator().FillRandomVectors2(vectorsOut, count);
+}
+
+template <typename T>
+void Random::FillRandomVectors3(Vector3G<T> *vectorsOut, std::size_t count)
+{
+    GetThreadGenerator().FillRandomVectors3(vectorsOut, count);
+}
+
+template <typename T>
+void Random::FillRandomVectors4(Vector4G<T> *vectorsOut, std::size_t count)
+{
+    GetThreadGenerator().FillRandomVectors4(vectorsOut, count);
+}
+
+template <typename T>
+void Random::FillRotations(QuaternionG<T> *rotationsOut, std::size_t count)
+{
+    GetThreadGenerator().FillRotations(rotationsOut, count);
+}
+
+template <typename T>
+void Random::FillInsideUnitCircle(Vector2G<T> *pointsOut, std::size_t count)
+{
+    GetThreadGenerator().FillInsideUnitCircle(pointsOut, count);
+}
+
+template <typename T>
+void Random::FillOnUnitCircle(Vector2G<T> *pointsOut, std::size_t count)
+{
+    GetThreadGenerator().FillOnUnitCircle(pointsOut, count);
+}
+
+template <typename T>
+void Random::FillInsideUnitSphere(Vector3G<T> *pointsOut, std::size_t count)
+{
+    GetThreadGenerator().FillInsideUnitSphere(pointsOut, count);
+}
+
+template <typename T>
+void Random::FillOnUnitSphere(Vector3G<T> *pointsOut, std::size_t count)
+{
+    GetThreadGenerator().FillOnUnitSphere(pointsOut, count);
+}
+
+template <typename T>
+void Random::FillOnUnitHemisphere(const Vector3G<T> &normal,
+                                  Vector3G<T> *directionsOut,
+                                  std::size_t count)
+{
+    GetThreadGenerator().FillOnUnitHemisphere(normal, directionsOut, count);
+}
+
+template <typename T>
+void Random::FillCosineWeightedHemisphere(const Vector3G<T> &normal,
+                                          Vector3G<T> *directionsOut,
+                                          std::size_t count)
+{
+    GetThreadGenerator().FillCosineWeightedHemisphere(
+        normal, directionsOut, count);
+}
+
+template <typename T>
+void Random::FillInsideTriangle(const TriangleG<T> &triangle,
+                                Vector3G<T> *pointsOut,
+                                std::size_t count)
+{
+    GetThreadGenerator().FillInsideTriangle(triangle, pointsOut, count);
 }
 }
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+// Pseudo random bit engines. All of them satisfy the standard
+// UniformRandomBitGenerator requirements, so they also work with <random>.
+//
+// For deterministic parallel generation, give every worker a copy of the
+// same engine advanced a different number of times with Jump(), or (PCG32)
+// a different stream.
+
+// SplitMix64 (Steele, Lea & Flood). Tiny and fast, mostly used to expand a
+// single seed into the state of the other engines.
+class SplitMix64
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit SplitMix64(std::uint64_t seed = 0);
+
+    void Seed(std::uint64_t seed);
+    std::uint64_t Next();
+    // Advances the sequence by 2^64 / 2^16 steps
+    void Jump();
+    void Advance(std::uint64_t delta);
+
+    result_type operator()();
+    static constexpr result_type min();
+    static constexpr result_type max();
+
+private:
+    std::uint64_t m_state = 0;
+};
+
+// PCG32, XSH-RR variant (O'Neill). 64 bits of state, 32 bit output and
+// 2^63 selectable streams with independent sequences.
+class PCG32
+{
+public:
+    using result_type = std::uint32_t;
+
+    explicit PCG32(std::uint64_t seed = 0x853c49e6748fea9bULL,
+                   std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+
+    void Seed(std::uint64_t seed,
+              std::uint64_t stream = 0xda3e39cb94b95bdbULL);
+    std::uint32_t Next();
+    // Advances the sequence by 2^48 steps
+    void Jump();
+    // Advances the sequence by delta steps in O(log(delta))
+    void Advance(std::uint64_t delta);
+
+    result_type operator()();
+    static constexpr result_type min();
+    static constexpr result_type max();
+
+private:
+    std::uint64_t m_state = 0;
+    std::uint64_t m_increment = 1;
+};
+
+// xoshiro256** (Blackman & Vigna). 256 bits of state and 64 bit output,
+// the default engine of RandomGenerator.
+class Xoshiro256StarStar
+{
+public:
+    using result_type = std::uint64_t;
+
+    explicit Xoshiro256StarStar(std::uint64_t seed = 0);
+
+    // The state is filled from the seed with SplitMix64
+    void Seed(std::uint64_t seed);
+    std::uint64_t Next();
+    // Advances the sequence by 2^128 steps
+    void Jump();
+    // Advances the sequence by 2^192 steps
+    void LongJump();
+
+    result_type operator()();
+    static constexpr result_type min();
+    static constexpr result_type max();
+
+private:
+    std::uint64_t m_state[4];
+
+    void Jump(const std::uint64_t (&polynomial)[4]);
+    static std::uint64_t RotateLeft(std::uint64_t x, int k);
+};
+}
+
+#include "BangMath/RandomEngines.tcc"
@@ -0,0 +1,208 @@
+#include "BangMath/RandomEngines.h"
+
+#include <limits>
+
+namespace Bang
+{
+inline SplitMix64::SplitMix64(std::uint64_t seed)
+{
+    Seed(seed);
+}
+
+inline void SplitMix64::Seed(std::uint64_t seed)
+{
+    m_state = seed;
+}
+
+inline std::uint64_t SplitMix64::Next()
+{
+    std::uint64_t z = (m_state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+inline void SplitMix64::Jump()
+{
+    Advance(std::uint64_t(1) << 48);
+}
+
+inline void SplitMix64::Advance(std::uint64_t delta)
+{
+    // The state is a plain Weyl sequence
+    m_state += delta * 0x9e3779b97f4a7c15ULL;
+}
+
+inline SplitMix64::result_type SplitMix64::operator()()
+{
+    return Next();
+}
+
+constexpr SplitMix64::result_type SplitMix64::min()
+{
+    return std::numeric_limits<result_type>::min();
+}
+
+constexpr SplitMix64::result_type SplitMix64::max()
+{
+    return std::numeric_limits<result_type>::max();
+}
+
+inline PCG32::PCG32(std::uint64_t seed, std::uint64_t stream)
+{
+    Seed(seed, stream);
+}
+
+inline void PCG32::Seed(std::uint64_t seed, std::uint64_t stream)
+{
+    m_state = 0;
+    m_increment = (stream << 1) | 1;
+    Next();
+    m_state += seed;
+    Next();
+}
+
+inline std::uint32_t PCG32::Next()
+{
+    const std::uint64_t oldState = m_state;
+    m_state = oldState * 6364136223846793005ULL + m_increment;
+    const auto xorShifted =
+        static_cast<std::uint32_t>(((oldState >> 18) ^ oldState) >> 27);
+    const auto rotation = static_cast<std::uint32_t>(oldState >> 59);
+    return (xorShifted >> rotation) |
+           (xorShifted << ((32u - rotation) & 31u));
+}
+
+inline void PCG32::Jump()
+{
+    Advance(std::uint64_t(1) << 48);
+}
+
+// Brown, "Random Number Generation with Arbitrary Stride" (1994)
+inline void PCG32::Advance(std::uint64_t delta)
+{
+    std::uint64_t curMult = 6364136223846793005ULL;
+    std::uint64_t curPlus = m_increment;
+    std::uint64_t accMult = 1;
+    std::uint64_t accPlus = 0;
+    while (delta > 0)
+    {
+        if (delta & 1)
+        {
+            accMult *= curMult;
+            accPlus = accPlus * curMult + curPlus;
+        }
+        curPlus = (curMult + 1) * curPlus;
+        curMult *= curMult;
+        delta >>= 1;
+    }
+    m_state = accMult * m_state + accPlus;
+}
+
+inline PCG32::result_type PCG32::operator()()
+{
+    return Next();
+}
+
+constexpr PCG32::result_type PCG32::min()
+{
+    return std::numeric_limits<result_type>::min();
+}
+
+constexpr PCG32::result_type PCG32::max()
+{
+    return std::numeric_limits<result_type>::max();
+}
+
+inline Xoshiro256StarStar::Xoshiro256StarStar(std::uint64_t seed)
+{
+    Seed(seed);
+}
+
+inline void Xoshiro256StarStar::Seed(std::uint64_t seed)
+{
+    SplitMix64 splitMix(seed);
+    for (auto &s : m_state)
+    {
+        s = splitMix.Next();
+    }
+}
+
+inline std::uint64_t Xoshiro256StarStar::Next()
+{
+    const std::uint64_t result = RotateLeft(m_state[1] * 5, 7) * 9;
+    const std::uint64_t t = (m_state[1] << 17);
+
+    m_state[2] ^= m_state[0];
+    m_state[3] ^= m_state[1];
+    m_state[1] ^= m_state[2];
+    m_state[0] ^= m_state[3];
+    m_state[2] ^= t;
+    m_state[3] = RotateLeft(m_state[3], 45);
+
+    return result;
+}
+
+inline void Xoshiro256StarStar::Jump()
+{
+    static const std::uint64_t JumpPolynomial[4] = {0x180ec6d33cfd0abaULL,
+                                                    0xd5a61266f0c9392cULL,
+                                                    0xa9582618e03fc9aaULL,
+                                                    0x39abdc4529b1661cULL};
+    Jump(JumpPolynomial);
+}
+
+inline void Xoshiro256StarStar::LongJump()
+{
+    static const std::uint64_t LongJumpPolynomial[4] = {
+        0x76e15d3efefdcbbfULL,
+        0xc5004e441c522fb3ULL,
+        0x77710069854ee241ULL,
+        0x39109bb02acbe635ULL};
+    Jump(LongJumpPolynomial);
+}
+
+inline void Xoshiro256StarStar::Jump(const std::uint64_t (&polynomial)[4])
+{
+    std::uint64_t jumped[4] = {0, 0, 0, 0};
+    for (std::uint64_t word : polynomial)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (word & (std::uint64_t(1) << b))
+            {
+                for (int i = 0; i < 4; ++i)
+                {
+                    jumped[i] ^= m_state[i];
+                }
+            }
+            Next();
+        }
+    }
+
+    for (int i = 0; i < 4; ++i)
+    {
+        m_state[i] = jumped[i];
+    }
+}
+
+inline Xoshiro256StarStar::result_type Xoshiro256StarStar::operator()()
+{
+    return Next();
+}
+
+constexpr Xoshiro256StarStar::result_type Xoshiro256StarStar::min()
+{
+    return std::numeric_limits<result_type>::min();
+}
+
+constexpr Xoshiro256StarStar::result_type Xoshiro256StarStar::max()
+{
+    return std::numeric_limits<result_type>::max();
+}
+
+inline std::uint64_t Xoshiro256StarStar::RotateLeft(std::uint64_t x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+}
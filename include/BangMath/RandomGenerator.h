@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BangMath/Defines.h"
+#include "BangMath/RandomEngines.h"
+
+namespace Bang
+{
+template <typename>
+class Vector2G;
+template <typename>
+class Vector3G;
+template <typename>
+class Vector4G;
+template <typename>
+class ColorG;
+template <typename>
+class QuaternionG;
+template <typename>
+class TriangleG;
+
+// Random values, vectors, rotations and colors drawn from its own Engine.
+// Each instance is independent, so it can be owned by a system or a worker
+// thread without any locking. Random offers the same functions on a
+// thread local generator.
+template <class Engine = Xoshiro256StarStar>
+class RandomGenerator
+{
+public:
+    explicit RandomGenerator(std::uint64_t seed = 0);
+    explicit RandomGenerator(const Engine &engine);
+
+    void SetSeed(std::uint64_t seed);
+    // Advances the engine far ahead, see the engines for the distance.
+    // Copies of a generator jumped a different number of times give
+    // non-overlapping sequences, e.g. one per job.
+    void Jump();
+
+    Engine &GetEngine();
+    const Engine &GetEngine() const;
+
+    std::uint32_t GetBits32();
+    std::uint64_t GetBits64();
+
+    // In [0, 1)
+    template <typename T = MathDefaultType>
+    T GetValue01();
+
+    template <typename T = MathDefaultType>
+    T GetRange(T minIncluded, T maxExcluded);
+
+    bool GetBool();
+
+    // Uniformly distributed, see Sampling for the warps used
+    template <typename T = MathDefaultType>
+    Vector2G<T> GetInsideUnitCircle();
+
+    template <typename T = MathDefaultType>
+    Vector2G<T> GetOnUnitCircle();
+
+    template <typename T = MathDefaultType>
+    Vector3G<T> GetInsideUnitSphere();
+
+    template <typename T = MathDefaultType>
+    Vector3G<T> GetOnUnitSphere();
+
+    template <typename T>
+    Vector3G<T> GetOnUnitHemisphere(const Vector3G<T> &normal);
+
+    // Density proportional to the cosine with the normal
+    template <typename T>
+    Vector3G<T> GetCosineWeightedHemisphere(const Vector3G<T> &normal);
+
+    template <typename T>
+    Vector3G<T> GetInsideTriangle(const TriangleG<T> &triangle);
+
+    template <typename T = MathDefaultType>
+    Vector2G<T> GetRandomVector2();
+
+    template <typename T = MathDefaultType>
+    Vector3G<T> GetRandomVector3();
+
+    template <typename T = MathDefaultType>
+    Vector4G<T> GetRandomVector4();
+
+    template <typename T = MathDefaultType>
+    QuaternionG<T> GetRotation();
+
+    template <typename T = MathDefaultType>
+    ColorG<T> GetColor();
+
+    template <typename T = MathDefaultType>
+    ColorG<T> GetColorOpaque();
+
+    // Bulk versions, writing count values to valuesOut
+    template <typename T>
+    void FillValues01(T *valuesOut, std::size_t count);
+
+    template <typename T>
+    void FillRange(T *valuesOut,
+                   std::size_t count,
+                   T minIncluded,
+                   T maxExcluded);
+
+    template <typename T>
+    void FillRandomVectors2(Vector2G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    void FillRandomVectors3(Vector3G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    void FillRandomVectors4(Vector4G<T> *vectorsOut, std::size_t count);
+
+    template <typename T>
+    void FillRotations(QuaternionG<T> *rotationsOut, std::size_t count);
+
+    template <typename T>
+    void FillInsideUnitCircle(Vector2G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    void FillOnUnitCircle(Vector2G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    void FillInsideUnitSphere(Vector3G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    void FillOnUnitSphere(Vector3G<T> *pointsOut, std::size_t count);
+
+    template <typename T>
+    void FillOnUnitHemisphere(const Vector3G<T> &normal,
+                              Vector3G<T> *directionsOut,
+                              std::size_t count);
+
+    template <typename T>
+    void FillCosineWeightedHemisphere(const Vector3G<T> &normal,
+                                      Vector3G<T> *directionsOut,
+                                      std::size_t count);
+
+    template <typename T>
+    void FillInsideTriangle(const TriangleG<T> &triangle,
+                            Vector3G<T> *pointsOut,
+                            std::size_t count);
+
+private:
+    // Samples are drawn in chunks of this size and then warped with SIMD
+    static constexpr std::size_t ChunkSize = 64;
+
+    Engine m_engine;
+
+    template <typename T, class Warp>
+    void FillChunked(std::size_t count, int numDimensions, Warp warp);
+};
+}
+
+#include "BangMath/RandomGenerator.tcc"
@@ -0,0 +1,424 @@
+#include "BangMath/RandomGenerator.h"
+
+#include <type_traits>
+
+#include "BangMath/Color.h"
+#include "BangMath/Math.h"
+#include "BangMath/Quaternion.h"
+#include "BangMath/Sampling.h"
+#include "BangMath/Triangle.h"
+#include "BangMath/Vector2.h"
+#include "BangMath/Vector3.h"
+#include "BangMath/Vector4.h"
+
+namespace Bang
+{
+template <class Engine>
+RandomGenerator<Engine>::RandomGenerator(std::uint64_t seed)
+{
+    SetSeed(seed);
+}
+
+template <class Engine>
+RandomGenerator<Engine>::RandomGenerator(const Engine &engine)
+    : m_engine(engine)
+{
+}
+
+template <class Engine>
+void RandomGenerator<Engine>::SetSeed(std::uint64_t seed)
+{
+    m_engine.Seed(seed);
+}
+
+template <class Engine>
+void RandomGenerator<Engine>::Jump()
+{
+    m_engine.Jump();
+}
+
+template <class Engine>
+Engine &RandomGenerator<Engine>::GetEngine()
+{
+    return m_engine;
+}
+
+template <class Engine>
+const Engine &RandomGenerator<Engine>::GetEngine() const
+{
+    return m_engine;
+}
+
+template <class Engine>
+std::uint32_t RandomGenerator<Engine>::GetBits32()
+{
+    // High bits are the best ones in every engine
+    using ResultType = typename Engine::result_type;
+    const int shift = static_cast<int>(sizeof(ResultType) * 8) - 32;
+    return static_cast<std::uint32_t>(m_engine() >> shift);
+}
+
+template <class Engine>
+std::uint64_t RandomGenerator<Engine>::GetBits64()
+{
+    using ResultType = typename Engine::result_type;
+    if (sizeof(ResultType) >= sizeof(std::uint64_t))
+    {
+        return static_cast<std::uint64_t>(m_engine());
+    }
+
+    const auto high = static_cast<std::uint64_t>(m_engine());
+    const auto low = static_cast<std::uint64_t>(m_engine());
+    return (high << 32) | (low & 0xffffffffULL);
+}
+
+template <class Engine>
+template <typename T>
+T RandomGenerator<Engine>::GetValue01()
+{
+    // Use as many high bits as the mantissa holds, so that the result is
+    // evenly spaced and never rounds up to 1
+    if (std::is_same<T, float>::value)
+    {
+        return static_cast<T>(static_cast<float>(GetBits32() >> 8) *
+                              (1.0f / 16777216.0f));
+    }
+    return static_cast<T>(static_cast<double>(GetBits64() >> 11) *
+                          (1.0 / 9007199254740992.0));
+}
+
+template <class Engine>
+template <typename T>
+T RandomGenerator<Engine>::GetRange(T minIncluded, T maxExcluded)
+{
+    using RealT = typename std::
+        conditional<std::is_floating_point<T>::value, T, double>::type;
+    return static_cast<T>(GetValue01<RealT>() * (maxExcluded - minIncluded)) +
+           minIncluded;
+}
+
+template <class Engine>
+bool RandomGenerator<Engine>::GetBool()
+{
+    return ((GetBits64() >> 63) != 0);
+}
+
+template <class Engine>
+template <typename T>
+Vector2G<T> RandomGenerator<Engine>::GetInsideUnitCircle()
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    return Sampling::SquareToUniformDisk(Vector2G<T>(u, v));
+}
+
+template <class Engine>
+template <typename T>
+Vector2G<T> RandomGenerator<Engine>::GetOnUnitCircle()
+{
+    return Sampling::UnitToCircle(GetValue01<T>());
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetInsideUnitSphere()
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    const T w = GetValue01<T>();
+    return Sampling::CubeToUniformBall(Vector3G<T>(u, v, w));
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetOnUnitSphere()
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    return Sampling::SquareToUniformSphere(Vector2G<T>(u, v));
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetOnUnitHemisphere(
+    const Vector3G<T> &normal)
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    return Sampling::ToNormalSpace(
+        Sampling::SquareToUniformHemisphere(Vector2G<T>(u, v)), normal);
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetCosineWeightedHemisphere(
+    const Vector3G<T> &normal)
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    return Sampling::ToNormalSpace(
+        Sampling::SquareToCosineHemisphere(Vector2G<T>(u, v)), normal);
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetInsideTriangle(
+    const TriangleG<T> &triangle)
+{
+    const T u = GetValue01<T>();
+    const T v = GetValue01<T>();
+    const auto barycentric =
+        Sampling::SquareToTriangleBarycentric(Vector2G<T>(u, v));
+    return triangle.GetPoint(0) * barycentric.x +
+           triangle.GetPoint(1) * barycentric.y +
+           triangle.GetPoint(2) * barycentric.z;
+}
+
+template <class Engine>
+template <typename T>
+Vector2G<T> RandomGenerator<Engine>::GetRandomVector2()
+{
+    const T x = GetRange<T>(T(-1), T(1));
+    const T y = GetRange<T>(T(-1), T(1));
+    return Vector2G<T>(x, y);
+}
+
+template <class Engine>
+template <typename T>
+Vector3G<T> RandomGenerator<Engine>::GetRandomVector3()
+{
+    const T x = GetRange<T>(T(-1), T(1));
+    const T y = GetRange<T>(T(-1), T(1));
+    const T z = GetRange<T>(T(-1), T(1));
+    return Vector3G<T>(x, y, z);
+}
+
+template <class Engine>
+template <typename T>
+Vector4G<T> RandomGenerator<Engine>::GetRandomVector4()
+{
+    const T x = GetRange<T>(T(-1), T(1));
+    const T y = GetRange<T>(T(-1), T(1));
+    const T z = GetRange<T>(T(-1), T(1));
+    const T w = GetRange<T>(T(-1), T(1));
+    return Vector4G<T>(x, y, z, w);
+}
+
+template <class Engine>
+template <typename T>
+QuaternionG<T> RandomGenerator<Engine>::GetRotation()
+{
+    const T angle = GetRange<T>(T(0), T(2) * Math::Pi<T>());
+    return QuaternionG<T>::AngleAxis(angle, GetOnUnitSphere<T>());
+}
+
+template <class Engine>
+template <typename T>
+ColorG<T> RandomGenerator<Engine>::GetColor()
+{
+    const T r = GetValue01<T>();
+    const T g = GetValue01<T>();
+    const T b = GetValue01<T>();
+    const T a = GetValue01<T>();
+    return ColorG<T>(r, g, b, a);
+}
+
+template <class Engine>
+template <typename T>
+ColorG<T> RandomGenerator<Engine>::GetColorOpaque()
+{
+    const T r = GetValue01<T>();
+    const T g = GetValue01<T>();
+    const T b = GetValue01<T>();
+    return ColorG<T>(r, g, b, T(1));
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillValues01(T *valuesOut, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        valuesOut[i] = GetValue01<T>();
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillRange(T *valuesOut,
+                                        std::size_t count,
+                                        T minIncluded,
+                                        T maxExcluded)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        valuesOut[i] = GetRange<T>(minIncluded, maxExcluded);
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillRandomVectors2(Vector2G<T> *vectorsOut,
+                                                 std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectorsOut[i] = GetRandomVector2<T>();
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillRandomVectors3(Vector3G<T> *vectorsOut,
+                                                 std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectorsOut[i] = GetRandomVector3<T>();
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillRandomVectors4(Vector4G<T> *vectorsOut,
+                                                 std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        vectorsOut[i] = GetRandomVector4<T>();
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillRotations(QuaternionG<T> *rotationsOut,
+                                            std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        rotationsOut[i] = GetRotation<T>();
+    }
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillInsideUnitCircle(Vector2G<T> *pointsOut,
+                                                   std::size_t count)
+{
+    FillChunked<T>(count, 2, [&](T **samples, std::size_t i, std::size_t n) {
+        Sampling::SquareToUniformDisk(samples[0], samples[1], n, pointsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillOnUnitCircle(Vector2G<T> *pointsOut,
+                                               std::size_t count)
+{
+    FillChunked<T>(count, 1, [&](T **samples, std::size_t i, std::size_t n) {
+        Sampling::UnitToCircle(samples[0], n, pointsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillInsideUnitSphere(Vector3G<T> *pointsOut,
+                                                   std::size_t count)
+{
+    // The maximum of three uniforms is distributed as the cubic root of one,
+    // which is the radius distribution of a uniform ball
+    FillChunked<T>(count, 5, [&](T **samples, std::size_t i, std::size_t n) {
+        T *radii = samples[2];
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            radii[j] = Math::Max(radii[j],
+                                 Math::Max(samples[3][j], samples[4][j]));
+        }
+        Sampling::SquareToSphereScaled(
+            samples[0], samples[1], radii, n, pointsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillOnUnitSphere(Vector3G<T> *pointsOut,
+                                               std::size_t count)
+{
+    FillChunked<T>(count, 2, [&](T **samples, std::size_t i, std::size_t n) {
+        Sampling::SquareToUniformSphere(
+            samples[0], samples[1], n, pointsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillOnUnitHemisphere(const Vector3G<T> &normal,
+                                                   Vector3G<T> *directionsOut,
+                                                   std::size_t count)
+{
+    FillChunked<T>(count, 2, [&](T **samples, std::size_t i, std::size_t n) {
+        Sampling::SquareToUniformHemisphere(
+            samples[0], samples[1], normal, n, directionsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillCosineWeightedHemisphere(
+    const Vector3G<T> &normal,
+    Vector3G<T> *directionsOut,
+    std::size_t count)
+{
+    FillChunked<T>(count, 2, [&](T **samples, std::size_t i, std::size_t n) {
+        Sampling::SquareToCosineHemisphere(
+            samples[0], samples[1], normal, n, directionsOut + i);
+    });
+}
+
+template <class Engine>
+template <typename T>
+void RandomGenerator<Engine>::FillInsideTriangle(const TriangleG<T> &triangle,
+                                                 Vector3G<T> *pointsOut,
+                                                 std::size_t count)
+{
+    const auto &p0 = triangle.GetPoint(0);
+    const auto &p1 = triangle.GetPoint(1);
+    const auto &p2 = triangle.GetPoint(2);
+    FillChunked<T>(count, 2, [&](T **samples, std::size_t i, std::size_t n) {
+        Vector3G<T> *points = pointsOut + i;
+        Sampling::SquareToTriangleBarycentric(
+            samples[0], samples[1], n, points);
+        for (std::size_t j = 0; j < n; ++j)
+        {
+            const Vector3G<T> barycentric = points[j];
+            points[j] = p0 * barycentric.x + p1 * barycentric.y +
+                        p2 * barycentric.z;
+        }
+    });
+}
+
+template <class Engine>
+template <typename T, class Warp>
+void RandomGenerator<Engine>::FillChunked(std::size_t count,
+                                          int numDimensions,
+                                          Warp warp)
+{
+    constexpr int MaxDimensions = 5;
+    T chunk[MaxDimensions][ChunkSize];
+    T *samples[MaxDimensions];
+    for (int d = 0; d < MaxDimensions; ++d)
+    {
+        samples[d] = chunk[d];
+    }
+
+    for (std::size_t i = 0; i < count; i += ChunkSize)
+    {
+        const std::size_t n = Math::Min(count - i, std::size_t(ChunkSize));
+        for (int d = 0; d < numDimensions; ++d)
+        {
+            FillValues01(chunk[d], n);
+        }
+        warp(samples, i, n);
+    }
+}
+}
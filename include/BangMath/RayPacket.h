@@ -0,0 +1,65 @@
+#pragma once
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class AABoxG;
+template <typename>
+class RayG;
+template <typename>
+class TriangleG;
+template <typename>
+class Vector3G;
+
+// N rays stored as structure of arrays, with their inverse directions
+// precomputed, so they can be tested against one primitive in SIMD4G blocks
+// without branches. N must be a multiple of 4 (8 rays are two blocks).
+//
+// The intersection functions return a hit mask, where bit i is set when ray i
+// hits. maxDistances, if given, points to N per-ray limits.
+template <typename T, int N>
+class RayPacketG
+{
+public:
+    RayPacketG();
+    explicit RayPacketG(const RayG<T> *rays);
+
+    void SetRay(int i, const RayG<T> &ray);
+    RayG<T> GetRay(int i) const;
+
+    const T *GetOrigins(int axis) const;
+    const T *GetDirections(int axis) const;
+    const T *GetInverseDirections(int axis) const;
+
+    // distancesOut gets where each ray enters the box, 0 if it starts inside.
+    // Unlike Geometry::IntersectRayAABox, boxes behind the origin are misses.
+    int IntersectAABox(const AABoxG<T> &aaBox,
+                       const T *maxDistances = nullptr,
+                       T *distancesOut = nullptr) const;
+
+    // Same test as Geometry::IntersectRayTriangle, for the N rays at once
+    int IntersectTriangle(const TriangleG<T> &triangle,
+                          const T *maxDistances = nullptr,
+                          T *distancesOut = nullptr) const;
+
+    static constexpr int GetSize();
+    static constexpr int GetFullMask();
+
+private:
+    alignas(32) T m_origins[3][N];
+    alignas(32) T m_directions[3][N];
+    alignas(32) T m_invDirections[3][N];
+};
+
+template <typename T>
+using RayPacket4G = RayPacketG<T, 4>;
+template <typename T>
+using RayPacket8G = RayPacketG<T, 8>;
+
+BANG_MATH_DEFINE_USINGS(RayPacket4)
+BANG_MATH_DEFINE_USINGS(RayPacket8)
+}
+
+#include "BangMath/RayPacket.tcc"
@@ -0,0 +1,202 @@
+#include "BangMath/RayPacket.h"
+
+#include "BangMath/AABox.h"
+#include "BangMath/Math.h"
+#include "BangMath/Ray.h"
+#include "BangMath/SIMD.h"
+#include "BangMath/Triangle.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T, int N>
+RayPacketG<T, N>::RayPacketG()
+{
+    static_assert(N > 0 && N % 4 == 0 && N <= 16,
+                  "RayPacketG size must be a multiple of 4, up to 16");
+
+    const RayG<T> ray;
+    for (int i = 0; i < N; ++i)
+    {
+        SetRay(i, ray);
+    }
+}
+
+template <typename T, int N>
+RayPacketG<T, N>::RayPacketG(const RayG<T> *rays) : RayPacketG()
+{
+    for (int i = 0; i < N; ++i)
+    {
+        SetRay(i, rays[i]);
+    }
+}
+
+template <typename T, int N>
+void RayPacketG<T, N>::SetRay(int i, const RayG<T> &ray)
+{
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        const T dir = ray.GetDirection()[axis];
+        m_origins[axis][i] = ray.GetOrigin()[axis];
+        m_directions[axis][i] = dir;
+
+        // A huge finite value instead of infinity, so that a ray lying on a
+        // slab plane gives 0 instead of NaN in the slab test
+        m_invDirections[axis][i] =
+            (dir != 0) ? (T(1) / dir) : Math::Max<T>();
+    }
+}
+
+template <typename T, int N>
+RayG<T> RayPacketG<T, N>::GetRay(int i) const
+{
+    return RayG<T>(
+        Vector3G<T>(m_origins[0][i], m_origins[1][i], m_origins[2][i]),
+        Vector3G<T>(
+            m_directions[0][i], m_directions[1][i], m_directions[2][i]));
+}
+
+template <typename T, int N>
+const T *RayPacketG<T, N>::GetOrigins(int axis) const
+{
+    return m_origins[axis];
+}
+
+template <typename T, int N>
+const T *RayPacketG<T, N>::GetDirections(int axis) const
+{
+    return m_directions[axis];
+}
+
+template <typename T, int N>
+const T *RayPacketG<T, N>::GetInverseDirections(int axis) const
+{
+    return m_invDirections[axis];
+}
+
+template <typename T, int N>
+int RayPacketG<T, N>::IntersectAABox(const AABoxG<T> &aaBox,
+                                     const T *maxDistances,
+                                     T *distancesOut) const
+{
+    using SIMD = SIMD4G<T>;
+
+    if (!(aaBox.GetMin() <= aaBox.GetMax()))
+    {
+        return 0;
+    }
+
+    const SIMD zero(T(0));
+    const SIMD infinity(Math::Infinity<T>());
+    const SIMD minX(aaBox.GetMin().x), maxX(aaBox.GetMax().x);
+    const SIMD minY(aaBox.GetMin().y), maxY(aaBox.GetMax().y);
+    const SIMD minZ(aaBox.GetMin().z), maxZ(aaBox.GetMax().z);
+
+    int hitMask = 0;
+    for (int b = 0; b < N; b += 4)
+    {
+        const SIMD ox = SIMD::Load(m_origins[0] + b);
+        const SIMD oy = SIMD::Load(m_origins[1] + b);
+        const SIMD oz = SIMD::Load(m_origins[2] + b);
+        const SIMD invX = SIMD::Load(m_invDirections[0] + b);
+        const SIMD invY = SIMD::Load(m_invDirections[1] + b);
+        const SIMD invZ = SIMD::Load(m_invDirections[2] + b);
+
+        const SIMD tx0 = (minX - ox) * invX, tx1 = (maxX - ox) * invX;
+        const SIMD ty0 = (minY - oy) * invY, ty1 = (maxY - oy) * invY;
+        const SIMD tz0 = (minZ - oz) * invZ, tz1 = (maxZ - oz) * invZ;
+
+        const SIMD tNear =
+            SIMD::Max(SIMD::Max(SIMD::Min(tx0, tx1), SIMD::Min(ty0, ty1)),
+                      SIMD::Max(SIMD::Min(tz0, tz1), zero));
+        const SIMD maxDistance =
+            maxDistances ? SIMD::Load(maxDistances + b) : infinity;
+        const SIMD tFar =
+            SIMD::Min(SIMD::Min(SIMD::Max(tx0, tx1), SIMD::Max(ty0, ty1)),
+                      SIMD::Min(SIMD::Max(tz0, tz1), maxDistance));
+
+        hitMask |= (SIMD::LessEqualMask(tNear, tFar) << b);
+        if (distancesOut)
+        {
+            tNear.Store(distancesOut + b);
+        }
+    }
+    return hitMask;
+}
+
+// Moller-Trumbore, with every early out turned into a lane mask
+template <typename T, int N>
+int RayPacketG<T, N>::IntersectTriangle(const TriangleG<T> &triangle,
+                                        const T *maxDistances,
+                                        T *distancesOut) const
+{
+    using SIMD = SIMD4G<T>;
+
+    const auto &triP0 = triangle.GetPoint(0);
+    const auto v10 = triangle.GetPoint(1) - triP0;
+    const auto v20 = triangle.GetPoint(2) - triP0;
+
+    const SIMD p0x(triP0.x), p0y(triP0.y), p0z(triP0.z);
+    const SIMD e1x(v10.x), e1y(v10.y), e1z(v10.z);
+    const SIMD e2x(v20.x), e2y(v20.y), e2z(v20.z);
+    const SIMD zero(T(0)), one(T(1));
+    const SIMD epsilon(T(1e-8)), negEpsilon(T(-1e-8));
+    const SIMD infinity(Math::Infinity<T>());
+
+    int hitMask = 0;
+    for (int b = 0; b < N; b += 4)
+    {
+        const SIMD dx = SIMD::Load(m_directions[0] + b);
+        const SIMD dy = SIMD::Load(m_directions[1] + b);
+        const SIMD dz = SIMD::Load(m_directions[2] + b);
+
+        // h = cross(dir, v20), a = dot(v10, h)
+        const SIMD hx = dy * e2z - dz * e2y;
+        const SIMD hy = dz * e2x - dx * e2z;
+        const SIMD hz = dx * e2y - dy * e2x;
+        const SIMD a = e1x * hx + e1y * hy + e1z * hz;
+        int mask =
+            (SIMD::LessMask(a, negEpsilon) | SIMD::LessMask(epsilon, a));
+
+        const SIMD f = one / a;
+        const SIMD sx = SIMD::Load(m_origins[0] + b) - p0x;
+        const SIMD sy = SIMD::Load(m_origins[1] + b) - p0y;
+        const SIMD sz = SIMD::Load(m_origins[2] + b) - p0z;
+        const SIMD u = f * (sx * hx + sy * hy + sz * hz);
+        mask &= SIMD::LessEqualMask(zero, u) & SIMD::LessEqualMask(u, one);
+
+        // q = cross(s, v10)
+        const SIMD qx = sy * e1z - sz * e1y;
+        const SIMD qy = sz * e1x - sx * e1z;
+        const SIMD qz = sx * e1y - sy * e1x;
+        const SIMD v = f * (dx * qx + dy * qy + dz * qz);
+        mask &= SIMD::LessEqualMask(zero, v) &
+                SIMD::LessEqualMask(u + v, one);
+
+        const SIMD t = f * (e2x * qx + e2y * qy + e2z * qz);
+        const SIMD maxDistance =
+            maxDistances ? SIMD::Load(maxDistances + b) : infinity;
+        mask &= SIMD::LessEqualMask(epsilon, t) &
+                SIMD::LessEqualMask(t, maxDistance);
+
+        hitMask |= (mask << b);
+        if (distancesOut)
+        {
+            t.Store(distancesOut + b);
+        }
+    }
+    return hitMask;
+}
+
+template <typename T, int N>
+constexpr int RayPacketG<T, N>::GetSize()
+{
+    return N;
+}
+
+template <typename T, int N>
+constexpr int RayPacketG<T, N>::GetFullMask()
+{
+    return (1 << N) - 1;
+}
+}
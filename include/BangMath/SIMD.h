@@ -0,0 +1,200 @@
+#pragma once
+
+#include <cstddef>
+
+#include "BangMath/Defines.h"
+
+// Backend selection, done at compile time from the target flags.
+// Define BANG_MATH_DISABLE_SIMD to force the scalar fallback everywhere.
+#if !defined(BANG_MATH_DISABLE_SIMD)
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BANG_MATH_SIMD_SSE
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define BANG_MATH_SIMD_NEON
+#endif
+#if defined(__AVX__)
+#define BANG_MATH_SIMD_AVX
+#endif
+#endif
+
+#if defined(BANG_MATH_SIMD_SSE)
+#include <emmintrin.h>
+#elif defined(BANG_MATH_SIMD_NEON)
+#include <arm_neon.h>
+#endif
+#if defined(BANG_MATH_SIMD_AVX)
+#include <immintrin.h>
+#endif
+
+#if defined(BANG_MATH_SIMD_SSE) || defined(BANG_MATH_SIMD_NEON)
+#define BANG_MATH_SIMD_FLOAT4
+#endif
+#if defined(BANG_MATH_SIMD_AVX)
+#define BANG_MATH_SIMD_DOUBLE4
+#endif
+
+namespace Bang
+{
+// Four lanes of T. The generic template is the scalar fallback, float is
+// specialized for SSE/NEON and double for AVX.
+template <typename T>
+class SIMD4G
+{
+public:
+    static constexpr bool IsAccelerated = false;
+
+    SIMD4G() = default;
+    explicit SIMD4G(T a);
+    SIMD4G(T x, T y, T z, T w);
+
+    static SIMD4G<T> Load(const T *src);
+    void Store(T *dst) const;
+    T Get(std::size_t i) const;
+
+    template <int I>
+    SIMD4G<T> Broadcast() const;
+
+    // Returns (a[I0], a[I1], b[I2], b[I3]), same as _mm_shuffle_ps
+    template <int I0, int I1, int I2, int I3>
+    static SIMD4G<T> Shuffle(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+    static void Transpose(SIMD4G<T> &r0,
+                          SIMD4G<T> &r1,
+                          SIMD4G<T> &r2,
+                          SIMD4G<T> &r3);
+
+    static SIMD4G<T> Min(const SIMD4G<T> &a, const SIMD4G<T> &b);
+    static SIMD4G<T> Max(const SIMD4G<T> &a, const SIMD4G<T> &b);
+    static SIMD4G<T> Sqrt(const SIMD4G<T> &a);
+    // Magnitude of a with the sign of b, lane by lane
+    static SIMD4G<T> CopySign(const SIMD4G<T> &a, const SIMD4G<T> &b);
+    static T HorizontalSum(const SIMD4G<T> &a);
+
+    // Bit i of the result is set when the comparison holds for lane i
+    static int LessMask(const SIMD4G<T> &a, const SIMD4G<T> &b);
+    static int LessEqualMask(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+private:
+    T m_v[4];
+};
+
+#if defined(BANG_MATH_SIMD_FLOAT4)
+template <>
+class SIMD4G<float>
+{
+public:
+#if defined(BANG_MATH_SIMD_SSE)
+    using Register = __m128;
+#else
+    using Register = float32x4_t;
+#endif
+
+    static constexpr bool IsAccelerated = true;
+
+    SIMD4G() = default;
+    explicit SIMD4G(Register reg);
+    explicit SIMD4G(float a);
+    SIMD4G(float x, float y, float z, float w);
+
+    static SIMD4G<float> Load(const float *src);
+    void Store(float *dst) const;
+    float Get(std::size_t i) const;
+    Register GetRegister() const;
+
+    template <int I>
+    SIMD4G<float> Broadcast() const;
+
+    template <int I0, int I1, int I2, int I3>
+    static SIMD4G<float> Shuffle(const SIMD4G<float> &a,
+                                 const SIMD4G<float> &b);
+
+    static void Transpose(SIMD4G<float> &r0,
+                          SIMD4G<float> &r1,
+                          SIMD4G<float> &r2,
+                          SIMD4G<float> &r3);
+
+    static SIMD4G<float> Min(const SIMD4G<float> &a, const SIMD4G<float> &b);
+    static SIMD4G<float> Max(const SIMD4G<float> &a, const SIMD4G<float> &b);
+    static SIMD4G<float> Sqrt(const SIMD4G<float> &a);
+    static SIMD4G<float> CopySign(const SIMD4G<float> &a,
+                                  const SIMD4G<float> &b);
+    static float HorizontalSum(const SIMD4G<float> &a);
+
+    static int LessMask(const SIMD4G<float> &a, const SIMD4G<float> &b);
+    static int LessEqualMask(const SIMD4G<float> &a, const SIMD4G<float> &b);
+
+private:
+    Register m_reg;
+};
+#endif
+
+#if defined(BANG_MATH_SIMD_DOUBLE4)
+template <>
+class SIMD4G<double>
+{
+public:
+    using Register = __m256d;
+
+    static constexpr bool IsAccelerated = true;
+
+    SIMD4G() = default;
+    explicit SIMD4G(Register reg);
+    explicit SIMD4G(double a);
+    SIMD4G(double x, double y, double z, double w);
+
+    static SIMD4G<double> Load(const double *src);
+    void Store(double *dst) const;
+    double Get(std::size_t i) const;
+    Register GetRegister() const;
+
+    template <int I>
+    SIMD4G<double> Broadcast() const;
+
+    template <int I0, int I1, int I2, int I3>
+    static SIMD4G<double> Shuffle(const SIMD4G<double> &a,
+                                  const SIMD4G<double> &b);
+
+    static void Transpose(SIMD4G<double> &r0,
+                          SIMD4G<double> &r1,
+                          SIMD4G<double> &r2,
+                          SIMD4G<double> &r3);
+
+    static SIMD4G<double> Min(const SIMD4G<double> &a,
+                              const SIMD4G<double> &b);
+    static SIMD4G<double> Max(const SIMD4G<double> &a,
+                              const SIMD4G<double> &b);
+    static SIMD4G<double> Sqrt(const SIMD4G<double> &a);
+    static SIMD4G<double> CopySign(const SIMD4G<double> &a,
+                                   const SIMD4G<double> &b);
+    static double HorizontalSum(const SIMD4G<double> &a);
+
+    static int LessMask(const SIMD4G<double> &a, const SIMD4G<double> &b);
+    static int LessEqualMask(const SIMD4G<double> &a,
+                             const SIMD4G<double> &b);
+
+private:
+    Register m_reg;
+};
+#endif
+
+template <typename T>
+SIMD4G<T> operator+(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+template <typename T>
+SIMD4G<T> operator-(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+template <typename T>
+SIMD4G<T> operator*(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+template <typename T>
+SIMD4G<T> operator/(const SIMD4G<T> &a, const SIMD4G<T> &b);
+
+template <typename T>
+SIMD4G<T> operator-(const SIMD4G<T> &a);
+
+using SIMD4f = SIMD4G<float>;
+using SIMD4d = SIMD4G<double>;
+}
+
+#include "BangMath/SIMD.tcc"
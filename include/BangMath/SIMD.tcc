@@ -0,0 +1,614 @@
+#include "BangMath/SIMD.h"
+
+#include <cmath>
+
+namespace Bang
+{
+template <typename T>
+SIMD4G<T>::SIMD4G(T a)
+{
+    m_v[0] = m_v[1] = m_v[2] = m_v[3] = a;
+}
+
+template <typename T>
+SIMD4G<T>::SIMD4G(T x, T y, T z, T w)
+{
+    m_v[0] = x;
+    m_v[1] = y;
+    m_v[2] = z;
+    m_v[3] = w;
+}
+
+template <typename T>
+SIMD4G<T> SIMD4G<T>::Load(const T *src)
+{
+    return SIMD4G<T>(src[0], src[1], src[2], src[3]);
+}
+
+template <typename T>
+void SIMD4G<T>::Store(T *dst) const
+{
+    dst[0] = m_v[0];
+    dst[1] = m_v[1];
+    dst[2] = m_v[2];
+    dst[3] = m_v[3];
+}
+
+template <typename T>
+T SIMD4G<T>::Get(std::size_t i) const
+{
+    return m_v[i];
+}
+
+template <typename T>
+template <int I>
+SIMD4G<T> SIMD4G<T>::Broadcast() const
+{
+    return SIMD4G<T>(m_v[I]);
+}
+
+template <typename T>
+template <int I0, int I1, int I2, int I3>
+SIMD4G<T> SIMD4G<T>::Shuffle(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(a.m_v[I0], a.m_v[I1], b.m_v[I2], b.m_v[I3]);
+}
+
+template <typename T>
+void SIMD4G<T>::Transpose(SIMD4G<T> &r0,
+                          SIMD4G<T> &r1,
+                          SIMD4G<T> &r2,
+                          SIMD4G<T> &r3)
+{
+    const SIMD4G<T> c0(r0.m_v[0], r1.m_v[0], r2.m_v[0], r3.m_v[0]);
+    const SIMD4G<T> c1(r0.m_v[1], r1.m_v[1], r2.m_v[1], r3.m_v[1]);
+    const SIMD4G<T> c2(r0.m_v[2], r1.m_v[2], r2.m_v[2], r3.m_v[2]);
+    const SIMD4G<T> c3(r0.m_v[3], r1.m_v[3], r2.m_v[3], r3.m_v[3]);
+    r0 = c0;
+    r1 = c1;
+    r2 = c2;
+    r3 = c3;
+}
+
+template <typename T>
+SIMD4G<T> SIMD4G<T>::Min(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>((a.m_v[0] < b.m_v[0]) ? a.m_v[0] : b.m_v[0],
+                     (a.m_v[1] < b.m_v[1]) ? a.m_v[1] : b.m_v[1],
+                     (a.m_v[2] < b.m_v[2]) ? a.m_v[2] : b.m_v[2],
+                     (a.m_v[3] < b.m_v[3]) ? a.m_v[3] : b.m_v[3]);
+}
+
+template <typename T>
+SIMD4G<T> SIMD4G<T>::Max(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>((a.m_v[0] > b.m_v[0]) ? a.m_v[0] : b.m_v[0],
+                     (a.m_v[1] > b.m_v[1]) ? a.m_v[1] : b.m_v[1],
+                     (a.m_v[2] > b.m_v[2]) ? a.m_v[2] : b.m_v[2],
+                     (a.m_v[3] > b.m_v[3]) ? a.m_v[3] : b.m_v[3]);
+}
+
+template <typename T>
+SIMD4G<T> SIMD4G<T>::Sqrt(const SIMD4G<T> &a)
+{
+    return SIMD4G<T>(static_cast<T>(std::sqrt(a.m_v[0])),
+                     static_cast<T>(std::sqrt(a.m_v[1])),
+                     static_cast<T>(std::sqrt(a.m_v[2])),
+                     static_cast<T>(std::sqrt(a.m_v[3])));
+}
+
+template <typename T>
+SIMD4G<T> SIMD4G<T>::CopySign(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(static_cast<T>(std::copysign(a.m_v[0], b.m_v[0])),
+                     static_cast<T>(std::copysign(a.m_v[1], b.m_v[1])),
+                     static_cast<T>(std::copysign(a.m_v[2], b.m_v[2])),
+                     static_cast<T>(std::copysign(a.m_v[3], b.m_v[3])));
+}
+
+template <typename T>
+T SIMD4G<T>::HorizontalSum(const SIMD4G<T> &a)
+{
+    return (a.m_v[0] + a.m_v[2]) + (a.m_v[1] + a.m_v[3]);
+}
+
+template <typename T>
+int SIMD4G<T>::LessMask(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return ((a.m_v[0] < b.m_v[0]) ? 1 : 0) | ((a.m_v[1] < b.m_v[1]) ? 2 : 0) |
+           ((a.m_v[2] < b.m_v[2]) ? 4 : 0) | ((a.m_v[3] < b.m_v[3]) ? 8 : 0);
+}
+
+template <typename T>
+int SIMD4G<T>::LessEqualMask(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return ((a.m_v[0] <= b.m_v[0]) ? 1 : 0) |
+           ((a.m_v[1] <= b.m_v[1]) ? 2 : 0) |
+           ((a.m_v[2] <= b.m_v[2]) ? 4 : 0) | ((a.m_v[3] <= b.m_v[3]) ? 8 : 0);
+}
+
+template <typename T>
+SIMD4G<T> operator+(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(a.Get(0) + b.Get(0),
+                     a.Get(1) + b.Get(1),
+                     a.Get(2) + b.Get(2),
+                     a.Get(3) + b.Get(3));
+}
+
+template <typename T>
+SIMD4G<T> operator-(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(a.Get(0) - b.Get(0),
+                     a.Get(1) - b.Get(1),
+                     a.Get(2) - b.Get(2),
+                     a.Get(3) - b.Get(3));
+}
+
+template <typename T>
+SIMD4G<T> operator*(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(a.Get(0) * b.Get(0),
+                     a.Get(1) * b.Get(1),
+                     a.Get(2) * b.Get(2),
+                     a.Get(3) * b.Get(3));
+}
+
+template <typename T>
+SIMD4G<T> operator/(const SIMD4G<T> &a, const SIMD4G<T> &b)
+{
+    return SIMD4G<T>(a.Get(0) / b.Get(0),
+                     a.Get(1) / b.Get(1),
+                     a.Get(2) / b.Get(2),
+                     a.Get(3) / b.Get(3));
+}
+
+template <typename T>
+SIMD4G<T> operator-(const SIMD4G<T> &a)
+{
+    return SIMD4G<T>(-a.Get(0), -a.Get(1), -a.Get(2), -a.Get(3));
+}
+
+#if defined(BANG_MATH_SIMD_FLOAT4)
+inline SIMD4G<float>::SIMD4G(Register reg) : m_reg(reg)
+{
+}
+
+inline SIMD4G<float>::Register SIMD4G<float>::GetRegister() const
+{
+    return m_reg;
+}
+
+inline float SIMD4G<float>::Get(std::size_t i) const
+{
+    float v[4];
+    Store(v);
+    return v[i];
+}
+
+#if defined(BANG_MATH_SIMD_SSE)
+inline SIMD4G<float>::SIMD4G(float a) : m_reg(_mm_set1_ps(a))
+{
+}
+
+inline SIMD4G<float>::SIMD4G(float x, float y, float z, float w)
+    : m_reg(_mm_setr_ps(x, y, z, w))
+{
+}
+
+inline SIMD4G<float> SIMD4G<float>::Load(const float *src)
+{
+    return SIMD4G<float>(_mm_loadu_ps(src));
+}
+
+inline void SIMD4G<float>::Store(float *dst) const
+{
+    _mm_storeu_ps(dst, m_reg);
+}
+
+template <int I>
+SIMD4G<float> SIMD4G<float>::Broadcast() const
+{
+    return SIMD4G<float>(_mm_shuffle_ps(m_reg, m_reg, _MM_SHUFFLE(I, I, I, I)));
+}
+
+template <int I0, int I1, int I2, int I3>
+SIMD4G<float> SIMD4G<float>::Shuffle(const SIMD4G<float> &a,
+                                     const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(
+        _mm_shuffle_ps(a.m_reg, b.m_reg, _MM_SHUFFLE(I3, I2, I1, I0)));
+}
+
+inline void SIMD4G<float>::Transpose(SIMD4G<float> &r0,
+                                     SIMD4G<float> &r1,
+                                     SIMD4G<float> &r2,
+                                     SIMD4G<float> &r3)
+{
+    _MM_TRANSPOSE4_PS(r0.m_reg, r1.m_reg, r2.m_reg, r3.m_reg);
+}
+
+inline SIMD4G<float> SIMD4G<float>::Min(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_min_ps(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<float> SIMD4G<float>::Max(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_max_ps(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<float> SIMD4G<float>::Sqrt(const SIMD4G<float> &a)
+{
+    return SIMD4G<float>(_mm_sqrt_ps(a.m_reg));
+}
+
+inline SIMD4G<float> SIMD4G<float>::CopySign(const SIMD4G<float> &a,
+                                             const SIMD4G<float> &b)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    return SIMD4G<float>(_mm_or_ps(_mm_andnot_ps(signMask, a.m_reg),
+                                   _mm_and_ps(signMask, b.m_reg)));
+}
+
+inline float SIMD4G<float>::HorizontalSum(const SIMD4G<float> &a)
+{
+    const __m128 hi = _mm_movehl_ps(a.m_reg, a.m_reg);
+    const __m128 sum2 = _mm_add_ps(a.m_reg, hi);
+    const __m128 sum1 = _mm_shuffle_ps(sum2, sum2, _MM_SHUFFLE(1, 1, 1, 1));
+    return _mm_cvtss_f32(_mm_add_ss(sum2, sum1));
+}
+
+inline int SIMD4G<float>::LessMask(const SIMD4G<float> &a,
+                                   const SIMD4G<float> &b)
+{
+    return _mm_movemask_ps(_mm_cmplt_ps(a.m_reg, b.m_reg));
+}
+
+inline int SIMD4G<float>::LessEqualMask(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    return _mm_movemask_ps(_mm_cmple_ps(a.m_reg, b.m_reg));
+}
+
+template <>
+inline SIMD4G<float> operator+(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_add_ps(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator-(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_sub_ps(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator*(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_mul_ps(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator/(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(_mm_div_ps(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator-(const SIMD4G<float> &a)
+{
+    return SIMD4G<float>(_mm_xor_ps(a.GetRegister(), _mm_set1_ps(-0.0f)));
+}
+#else   // NEON
+inline SIMD4G<float>::SIMD4G(float a) : m_reg(vdupq_n_f32(a))
+{
+}
+
+inline SIMD4G<float>::SIMD4G(float x, float y, float z, float w)
+{
+    const float v[4] = {x, y, z, w};
+    m_reg = vld1q_f32(v);
+}
+
+inline SIMD4G<float> SIMD4G<float>::Load(const float *src)
+{
+    return SIMD4G<float>(vld1q_f32(src));
+}
+
+inline void SIMD4G<float>::Store(float *dst) const
+{
+    vst1q_f32(dst, m_reg);
+}
+
+template <int I>
+SIMD4G<float> SIMD4G<float>::Broadcast() const
+{
+    return SIMD4G<float>(vdupq_n_f32(vgetq_lane_f32(m_reg, I)));
+}
+
+template <int I0, int I1, int I2, int I3>
+SIMD4G<float> SIMD4G<float>::Shuffle(const SIMD4G<float> &a,
+                                     const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vgetq_lane_f32(a.m_reg, I0),
+                         vgetq_lane_f32(a.m_reg, I1),
+                         vgetq_lane_f32(b.m_reg, I2),
+                         vgetq_lane_f32(b.m_reg, I3));
+}
+
+inline void SIMD4G<float>::Transpose(SIMD4G<float> &r0,
+                                     SIMD4G<float> &r1,
+                                     SIMD4G<float> &r2,
+                                     SIMD4G<float> &r3)
+{
+    const float32x4x2_t t01 = vtrnq_f32(r0.m_reg, r1.m_reg);
+    const float32x4x2_t t23 = vtrnq_f32(r2.m_reg, r3.m_reg);
+    r0.m_reg = vcombine_f32(vget_low_f32(t01.val[0]), vget_low_f32(t23.val[0]));
+    r1.m_reg = vcombine_f32(vget_low_f32(t01.val[1]), vget_low_f32(t23.val[1]));
+    r2.m_reg =
+        vcombine_f32(vget_high_f32(t01.val[0]), vget_high_f32(t23.val[0]));
+    r3.m_reg =
+        vcombine_f32(vget_high_f32(t01.val[1]), vget_high_f32(t23.val[1]));
+}
+
+inline SIMD4G<float> SIMD4G<float>::Min(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vminq_f32(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<float> SIMD4G<float>::Max(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vmaxq_f32(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<float> SIMD4G<float>::Sqrt(const SIMD4G<float> &a)
+{
+#if defined(__aarch64__)
+    return SIMD4G<float>(vsqrtq_f32(a.m_reg));
+#else
+    return SIMD4G<float>(std::sqrt(vgetq_lane_f32(a.m_reg, 0)),
+                         std::sqrt(vgetq_lane_f32(a.m_reg, 1)),
+                         std::sqrt(vgetq_lane_f32(a.m_reg, 2)),
+                         std::sqrt(vgetq_lane_f32(a.m_reg, 3)));
+#endif
+}
+
+inline SIMD4G<float> SIMD4G<float>::CopySign(const SIMD4G<float> &a,
+                                             const SIMD4G<float> &b)
+{
+    const uint32x4_t signMask = vdupq_n_u32(0x80000000u);
+    return SIMD4G<float>(vbslq_f32(signMask, b.m_reg, a.m_reg));
+}
+
+inline float SIMD4G<float>::HorizontalSum(const SIMD4G<float> &a)
+{
+    const float32x2_t sum2 =
+        vadd_f32(vget_low_f32(a.m_reg), vget_high_f32(a.m_reg));
+    return vget_lane_f32(sum2, 0) + vget_lane_f32(sum2, 1);
+}
+
+inline int SIMD4G<float>::LessMask(const SIMD4G<float> &a,
+                                   const SIMD4G<float> &b)
+{
+    const uint32x4_t m = vcltq_f32(a.m_reg, b.m_reg);
+    return static_cast<int>((vgetq_lane_u32(m, 0) & 1u) |
+                            (vgetq_lane_u32(m, 1) & 2u) |
+                            (vgetq_lane_u32(m, 2) & 4u) |
+                            (vgetq_lane_u32(m, 3) & 8u));
+}
+
+inline int SIMD4G<float>::LessEqualMask(const SIMD4G<float> &a,
+                                        const SIMD4G<float> &b)
+{
+    const uint32x4_t m = vcleq_f32(a.m_reg, b.m_reg);
+    return static_cast<int>((vgetq_lane_u32(m, 0) & 1u) |
+                            (vgetq_lane_u32(m, 1) & 2u) |
+                            (vgetq_lane_u32(m, 2) & 4u) |
+                            (vgetq_lane_u32(m, 3) & 8u));
+}
+
+template <>
+inline SIMD4G<float> operator+(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vaddq_f32(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator-(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vsubq_f32(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator*(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+    return SIMD4G<float>(vmulq_f32(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<float> operator/(const SIMD4G<float> &a, const SIMD4G<float> &b)
+{
+#if defined(__aarch64__)
+    return SIMD4G<float>(vdivq_f32(a.GetRegister(), b.GetRegister()));
+#else
+    return SIMD4G<float>(a.Get(0) / b.Get(0),
+                         a.Get(1) / b.Get(1),
+                         a.Get(2) / b.Get(2),
+                         a.Get(3) / b.Get(3));
+#endif
+}
+
+template <>
+inline SIMD4G<float> operator-(const SIMD4G<float> &a)
+{
+    return SIMD4G<float>(vnegq_f32(a.GetRegister()));
+}
+#endif  // BANG_MATH_SIMD_SSE
+#endif  // BANG_MATH_SIMD_FLOAT4
+
+#if defined(BANG_MATH_SIMD_DOUBLE4)
+inline SIMD4G<double>::SIMD4G(Register reg) : m_reg(reg)
+{
+}
+
+inline SIMD4G<double>::SIMD4G(double a) : m_reg(_mm256_set1_pd(a))
+{
+}
+
+inline SIMD4G<double>::SIMD4G(double x, double y, double z, double w)
+    : m_reg(_mm256_setr_pd(x, y, z, w))
+{
+}
+
+inline SIMD4G<double> SIMD4G<double>::Load(const double *src)
+{
+    return SIMD4G<double>(_mm256_loadu_pd(src));
+}
+
+inline void SIMD4G<double>::Store(double *dst) const
+{
+    _mm256_storeu_pd(dst, m_reg);
+}
+
+inline double SIMD4G<double>::Get(std::size_t i) const
+{
+    double v[4];
+    Store(v);
+    return v[i];
+}
+
+inline SIMD4G<double>::Register SIMD4G<double>::GetRegister() const
+{
+    return m_reg;
+}
+
+template <int I>
+SIMD4G<double> SIMD4G<double>::Broadcast() const
+{
+#if defined(__AVX2__)
+    return SIMD4G<double>(
+        _mm256_permute4x64_pd(m_reg, _MM_SHUFFLE(I, I, I, I)));
+#else
+    return SIMD4G<double>(Get(I));
+#endif
+}
+
+template <int I0, int I1, int I2, int I3>
+SIMD4G<double> SIMD4G<double>::Shuffle(const SIMD4G<double> &a,
+                                       const SIMD4G<double> &b)
+{
+#if defined(__AVX2__)
+    const __m256d pa =
+        _mm256_permute4x64_pd(a.m_reg, _MM_SHUFFLE(0, 0, I1, I0));
+    const __m256d pb =
+        _mm256_permute4x64_pd(b.m_reg, _MM_SHUFFLE(I3, I2, 0, 0));
+    return SIMD4G<double>(_mm256_blend_pd(pa, pb, 0xC));
+#else
+    double va[4], vb[4];
+    a.Store(va);
+    b.Store(vb);
+    return SIMD4G<double>(va[I0], va[I1], vb[I2], vb[I3]);
+#endif
+}
+
+inline void SIMD4G<double>::Transpose(SIMD4G<double> &r0,
+                                      SIMD4G<double> &r1,
+                                      SIMD4G<double> &r2,
+                                      SIMD4G<double> &r3)
+{
+    const __m256d t0 = _mm256_unpacklo_pd(r0.m_reg, r1.m_reg);
+    const __m256d t1 = _mm256_unpackhi_pd(r0.m_reg, r1.m_reg);
+    const __m256d t2 = _mm256_unpacklo_pd(r2.m_reg, r3.m_reg);
+    const __m256d t3 = _mm256_unpackhi_pd(r2.m_reg, r3.m_reg);
+    r0.m_reg = _mm256_permute2f128_pd(t0, t2, 0x20);
+    r1.m_reg = _mm256_permute2f128_pd(t1, t3, 0x20);
+    r2.m_reg = _mm256_permute2f128_pd(t0, t2, 0x31);
+    r3.m_reg = _mm256_permute2f128_pd(t1, t3, 0x31);
+}
+
+inline SIMD4G<double> SIMD4G<double>::Min(const SIMD4G<double> &a,
+                                          const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_min_pd(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<double> SIMD4G<double>::Max(const SIMD4G<double> &a,
+                                          const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_max_pd(a.m_reg, b.m_reg));
+}
+
+inline SIMD4G<double> SIMD4G<double>::Sqrt(const SIMD4G<double> &a)
+{
+    return SIMD4G<double>(_mm256_sqrt_pd(a.m_reg));
+}
+
+inline SIMD4G<double> SIMD4G<double>::CopySign(const SIMD4G<double> &a,
+                                               const SIMD4G<double> &b)
+{
+    const __m256d signMask = _mm256_set1_pd(-0.0);
+    return SIMD4G<double>(_mm256_or_pd(_mm256_andnot_pd(signMask, a.m_reg),
+                                       _mm256_and_pd(signMask, b.m_reg)));
+}
+
+inline double SIMD4G<double>::HorizontalSum(const SIMD4G<double> &a)
+{
+    const __m128d lo = _mm256_castpd256_pd128(a.m_reg);
+    const __m128d hi = _mm256_extractf128_pd(a.m_reg, 1);
+    const __m128d sum2 = _mm_add_pd(lo, hi);
+    return _mm_cvtsd_f64(_mm_add_sd(sum2, _mm_unpackhi_pd(sum2, sum2)));
+}
+
+inline int SIMD4G<double>::LessMask(const SIMD4G<double> &a,
+                                    const SIMD4G<double> &b)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_LT_OQ));
+}
+
+inline int SIMD4G<double>::LessEqualMask(const SIMD4G<double> &a,
+                                         const SIMD4G<double> &b)
+{
+    return _mm256_movemask_pd(_mm256_cmp_pd(a.m_reg, b.m_reg, _CMP_LE_OQ));
+}
+
+template <>
+inline SIMD4G<double> operator+(const SIMD4G<double> &a,
+                                const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_add_pd(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<double> operator-(const SIMD4G<double> &a,
+                                const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_sub_pd(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<double> operator*(const SIMD4G<double> &a,
+                                const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_mul_pd(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<double> operator/(const SIMD4G<double> &a,
+                                const SIMD4G<double> &b)
+{
+    return SIMD4G<double>(_mm256_div_pd(a.GetRegister(), b.GetRegister()));
+}
+
+template <>
+inline SIMD4G<double> operator-(const SIMD4G<double> &a)
+{
+    return SIMD4G<double>(
+        _mm256_xor_pd(a.GetRegister(), _mm256_set1_pd(-0.0)));
+}
+#endif  // BANG_MATH_SIMD_DOUBLE4
+}
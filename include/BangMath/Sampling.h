@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+template <typename>
+class SIMD4G;
+template <typename>
+class Vector2G;
+template <typename>
+class Vector3G;
+
+// Warps from uniform samples in [0, 1) to uniformly (or cosine) distributed
+// points on common domains, plus low discrepancy sequences to feed them.
+// RandomGenerator uses these with random samples. Quasi random points from
+// Halton/Sobol/R2 go through the same warps for faster Monte Carlo
+// convergence.
+//
+// The batch overloads take the samples as separate arrays and run the warp
+// four samples at a time with SIMD4G, sine and cosine included.
+class Sampling
+{
+public:
+    // Point on the unit circle
+    template <typename T>
+    static Vector2G<T> UnitToCircle(T u);
+
+    // Point inside the unit disk (polar mapping)
+    template <typename T>
+    static Vector2G<T> SquareToUniformDisk(const Vector2G<T> &uv);
+
+    // Point inside the unit disk (Shirley-Chiu). Keeps neighbouring samples
+    // close, better for stratified and low discrepancy samples.
+    template <typename T>
+    static Vector2G<T> SquareToConcentricDisk(const Vector2G<T> &uv);
+
+    // Point on the unit sphere
+    template <typename T>
+    static Vector3G<T> SquareToUniformSphere(const Vector2G<T> &uv);
+
+    // Point inside the unit ball
+    template <typename T>
+    static Vector3G<T> CubeToUniformBall(const Vector3G<T> &uvw);
+
+    // Directions on the hemisphere around +Z, uniform or with density
+    // proportional to the cosine with +Z
+    template <typename T>
+    static Vector3G<T> SquareToUniformHemisphere(const Vector2G<T> &uv);
+    template <typename T>
+    static Vector3G<T> SquareToCosineHemisphere(const Vector2G<T> &uv);
+
+    // Barycentric coordinates of a uniform point inside a triangle
+    template <typename T>
+    static Vector3G<T> SquareToTriangleBarycentric(const Vector2G<T> &uv);
+
+    // Rotates directions around +Z to be around normal (must be unit)
+    template <typename T>
+    static Vector3G<T> ToNormalSpace(const Vector3G<T> &direction,
+                                     const Vector3G<T> &normal);
+
+    template <typename T>
+    static void UnitToCircle(const T *u,
+                             std::size_t count,
+                             Vector2G<T> *pointsOut);
+    template <typename T>
+    static void SquareToUniformDisk(const T *u,
+                                    const T *v,
+                                    std::size_t count,
+                                    Vector2G<T> *pointsOut);
+    template <typename T>
+    static void SquareToUniformSphere(const T *u,
+                                      const T *v,
+                                      std::size_t count,
+                                      Vector3G<T> *pointsOut);
+    // Like SquareToUniformSphere, scaled by the given radii (ball sampling
+    // with radii distributed as the cubic root of a uniform)
+    template <typename T>
+    static void SquareToSphereScaled(const T *u,
+                                     const T *v,
+                                     const T *radii,
+                                     std::size_t count,
+                                     Vector3G<T> *pointsOut);
+    template <typename T>
+    static void SquareToUniformHemisphere(const T *u,
+                                          const T *v,
+                                          const Vector3G<T> &normal,
+                                          std::size_t count,
+                                          Vector3G<T> *directionsOut);
+    template <typename T>
+    static void SquareToCosineHemisphere(const T *u,
+                                         const T *v,
+                                         const Vector3G<T> &normal,
+                                         std::size_t count,
+                                         Vector3G<T> *directionsOut);
+    template <typename T>
+    static void SquareToTriangleBarycentric(const T *u,
+                                            const T *v,
+                                            std::size_t count,
+                                            Vector3G<T> *barycentricsOut);
+
+    // Van der Corput radical inverse of index in the given base
+    template <typename T = MathDefaultType>
+    static T RadicalInverse(int base, std::uint64_t index);
+
+    // Halton sequence, dimension in [0, 16) uses the dimension-th prime
+    template <typename T = MathDefaultType>
+    static T Halton(int dimension, std::uint64_t index);
+    template <typename T = MathDefaultType>
+    static Vector2G<T> Halton2(std::uint64_t index);
+
+    // First two dimensions of the Sobol sequence, optionally XOR scrambled
+    template <typename T = MathDefaultType>
+    static Vector2G<T> Sobol2(std::uint32_t index,
+                              std::uint32_t scrambleX = 0,
+                              std::uint32_t scrambleY = 0);
+
+    // Roberts' R2 sequence, based on the plastic number
+    template <typename T = MathDefaultType>
+    static Vector2G<T> R2(std::uint64_t index);
+
+    template <typename T>
+    static void FillHalton2(Vector2G<T> *pointsOut,
+                            std::size_t count,
+                            std::uint64_t firstIndex = 0);
+    template <typename T>
+    static void FillSobol2(Vector2G<T> *pointsOut,
+                           std::size_t count,
+                           std::uint32_t firstIndex = 0);
+    template <typename T>
+    static void FillR2(Vector2G<T> *pointsOut,
+                       std::size_t count,
+                       std::uint64_t firstIndex = 0);
+
+    Sampling() = delete;
+
+private:
+    template <typename T>
+    static SIMD4G<T> LoadBlock(const T *src, std::size_t count);
+
+    // sin and cos of 2 * pi * u, for u in [0, 1)
+    template <typename T>
+    static void SinCos2Pi(const SIMD4G<T> &u,
+                          SIMD4G<T> *sinOut,
+                          SIMD4G<T> *cosOut);
+
+    template <typename T>
+    static void StoreBlock(const SIMD4G<T> &x,
+                           const SIMD4G<T> &y,
+                           std::size_t count,
+                           Vector2G<T> *out);
+    template <typename T>
+    static void StoreBlock(const SIMD4G<T> &x,
+                           const SIMD4G<T> &y,
+                           const SIMD4G<T> &z,
+                           std::size_t count,
+                           Vector3G<T> *out);
+
+    template <typename T>
+    static void GetNormalBasis(const Vector3G<T> &normal,
+                               Vector3G<T> *tangent,
+                               Vector3G<T> *bitangent);
+
+    template <typename T>
+    static T ToUnit(std::uint32_t bits);
+};
+}
+
+#include "BangMath/Sampling.tcc"
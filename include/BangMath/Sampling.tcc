@@ -0,0 +1,515 @@
+#include "BangMath/Sampling.h"
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+#include "BangMath/Math.h"
+#include "BangMath/SIMD.h"
+#include "BangMath/Vector2.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+Vector2G<T> Sampling::UnitToCircle(T u)
+{
+    const T phi = T(2) * Math::Pi<T>() * u;
+    return Vector2G<T>(Math::Cos(phi), Math::Sin(phi));
+}
+
+template <typename T>
+Vector2G<T> Sampling::SquareToUniformDisk(const Vector2G<T> &uv)
+{
+    return Sampling::UnitToCircle(uv.y) * Math::Sqrt(uv.x);
+}
+
+// Shirley & Chiu, "A Low Distortion Map Between Disk and Square" (1997)
+template <typename T>
+Vector2G<T> Sampling::SquareToConcentricDisk(const Vector2G<T> &uv)
+{
+    const T a = T(2) * uv.x - T(1);
+    const T b = T(2) * uv.y - T(1);
+    if (a == 0 && b == 0)
+    {
+        return Vector2G<T>::Zero();
+    }
+
+    const T quarterPi = Math::Pi<T>() / T(4);
+    T r, phi;
+    if (Math::Abs(a) > Math::Abs(b))
+    {
+        r = a;
+        phi = quarterPi * (b / a);
+    }
+    else
+    {
+        r = b;
+        phi = T(2) * quarterPi - quarterPi * (a / b);
+    }
+    return Vector2G<T>(r * Math::Cos(phi), r * Math::Sin(phi));
+}
+
+template <typename T>
+Vector3G<T> Sampling::SquareToUniformSphere(const Vector2G<T> &uv)
+{
+    const T z = T(1) - T(2) * uv.x;
+    const T r = Math::Sqrt(Math::Max(T(0), T(1) - z * z));
+    const auto circle = Sampling::UnitToCircle(uv.y);
+    return Vector3G<T>(r * circle.x, r * circle.y, z);
+}
+
+template <typename T>
+Vector3G<T> Sampling::CubeToUniformBall(const Vector3G<T> &uvw)
+{
+    const auto direction =
+        Sampling::SquareToUniformSphere(Vector2G<T>(uvw.x, uvw.y));
+    return direction * static_cast<T>(std::cbrt(uvw.z));
+}
+
+template <typename T>
+Vector3G<T> Sampling::SquareToUniformHemisphere(const Vector2G<T> &uv)
+{
+    const T z = uv.x;
+    const T r = Math::Sqrt(Math::Max(T(0), T(1) - z * z));
+    const auto circle = Sampling::UnitToCircle(uv.y);
+    return Vector3G<T>(r * circle.x, r * circle.y, z);
+}
+
+// Malley's method: project a uniform disk sample up to the hemisphere
+template <typename T>
+Vector3G<T> Sampling::SquareToCosineHemisphere(const Vector2G<T> &uv)
+{
+    const auto disk = Sampling::SquareToUniformDisk(uv);
+    const T z = Math::Sqrt(Math::Max(T(0), T(1) - uv.x));
+    return Vector3G<T>(disk.x, disk.y, z);
+}
+
+template <typename T>
+Vector3G<T> Sampling::SquareToTriangleBarycentric(const Vector2G<T> &uv)
+{
+    const T s = Math::Sqrt(uv.x);
+    const T b0 = T(1) - s;
+    const T b1 = uv.y * s;
+    return Vector3G<T>(b0, b1, T(1) - b0 - b1);
+}
+
+template <typename T>
+Vector3G<T> Sampling::ToNormalSpace(const Vector3G<T> &direction,
+                                    const Vector3G<T> &normal)
+{
+    Vector3G<T> tangent, bitangent;
+    Sampling::GetNormalBasis(normal, &tangent, &bitangent);
+    return tangent * direction.x + bitangent * direction.y +
+           normal * direction.z;
+}
+
+template <typename T>
+void Sampling::UnitToCircle(const T *u,
+                            std::size_t count,
+                            Vector2G<T> *pointsOut)
+{
+    using SIMD = SIMD4G<T>;
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(u + i, blockCount), &sinPhi, &cosPhi);
+        Sampling::StoreBlock(cosPhi, sinPhi, blockCount, pointsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToUniformDisk(const T *u,
+                                   const T *v,
+                                   std::size_t count,
+                                   Vector2G<T> *pointsOut)
+{
+    using SIMD = SIMD4G<T>;
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD r = SIMD::Sqrt(Sampling::LoadBlock(u + i, blockCount));
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(v + i, blockCount), &sinPhi, &cosPhi);
+        Sampling::StoreBlock(
+            r * cosPhi, r * sinPhi, blockCount, pointsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToUniformSphere(const T *u,
+                                     const T *v,
+                                     std::size_t count,
+                                     Vector3G<T> *pointsOut)
+{
+    using SIMD = SIMD4G<T>;
+    const SIMD zero(T(0)), one(T(1)), two(T(2));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD z = one - two * Sampling::LoadBlock(u + i, blockCount);
+        const SIMD r = SIMD::Sqrt(SIMD::Max(zero, one - z * z));
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(v + i, blockCount), &sinPhi, &cosPhi);
+        Sampling::StoreBlock(
+            r * cosPhi, r * sinPhi, z, blockCount, pointsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToSphereScaled(const T *u,
+                                    const T *v,
+                                    const T *radii,
+                                    std::size_t count,
+                                    Vector3G<T> *pointsOut)
+{
+    using SIMD = SIMD4G<T>;
+    const SIMD zero(T(0)), one(T(1)), two(T(2));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD radius = Sampling::LoadBlock(radii + i, blockCount);
+        const SIMD z = one - two * Sampling::LoadBlock(u + i, blockCount);
+        const SIMD r = SIMD::Sqrt(SIMD::Max(zero, one - z * z)) * radius;
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(v + i, blockCount), &sinPhi, &cosPhi);
+        Sampling::StoreBlock(
+            r * cosPhi, r * sinPhi, z * radius, blockCount, pointsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToUniformHemisphere(const T *u,
+                                         const T *v,
+                                         const Vector3G<T> &normal,
+                                         std::size_t count,
+                                         Vector3G<T> *directionsOut)
+{
+    using SIMD = SIMD4G<T>;
+
+    Vector3G<T> tangent, bitangent;
+    Sampling::GetNormalBasis(normal, &tangent, &bitangent);
+    const SIMD tx(tangent.x), ty(tangent.y), tz(tangent.z);
+    const SIMD bx(bitangent.x), by(bitangent.y), bz(bitangent.z);
+    const SIMD nx(normal.x), ny(normal.y), nz(normal.z);
+
+    const SIMD zero(T(0)), one(T(1));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD z = Sampling::LoadBlock(u + i, blockCount);
+        const SIMD r = SIMD::Sqrt(SIMD::Max(zero, one - z * z));
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(v + i, blockCount), &sinPhi, &cosPhi);
+        const SIMD x = r * cosPhi, y = r * sinPhi;
+        Sampling::StoreBlock(tx * x + bx * y + nx * z,
+                             ty * x + by * y + ny * z,
+                             tz * x + bz * y + nz * z,
+                             blockCount,
+                             directionsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToCosineHemisphere(const T *u,
+                                        const T *v,
+                                        const Vector3G<T> &normal,
+                                        std::size_t count,
+                                        Vector3G<T> *directionsOut)
+{
+    using SIMD = SIMD4G<T>;
+
+    Vector3G<T> tangent, bitangent;
+    Sampling::GetNormalBasis(normal, &tangent, &bitangent);
+    const SIMD tx(tangent.x), ty(tangent.y), tz(tangent.z);
+    const SIMD bx(bitangent.x), by(bitangent.y), bz(bitangent.z);
+    const SIMD nx(normal.x), ny(normal.y), nz(normal.z);
+
+    const SIMD zero(T(0)), one(T(1));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD uBlock = Sampling::LoadBlock(u + i, blockCount);
+        const SIMD r = SIMD::Sqrt(uBlock);
+        const SIMD z = SIMD::Sqrt(SIMD::Max(zero, one - uBlock));
+        SIMD sinPhi, cosPhi;
+        Sampling::SinCos2Pi(
+            Sampling::LoadBlock(v + i, blockCount), &sinPhi, &cosPhi);
+        const SIMD x = r * cosPhi, y = r * sinPhi;
+        Sampling::StoreBlock(tx * x + bx * y + nx * z,
+                             ty * x + by * y + ny * z,
+                             tz * x + bz * y + nz * z,
+                             blockCount,
+                             directionsOut + i);
+    }
+}
+
+template <typename T>
+void Sampling::SquareToTriangleBarycentric(const T *u,
+                                           const T *v,
+                                           std::size_t count,
+                                           Vector3G<T> *barycentricsOut)
+{
+    using SIMD = SIMD4G<T>;
+    const SIMD one(T(1));
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        const std::size_t blockCount = Math::Min(count - i, std::size_t(4));
+        const SIMD s = SIMD::Sqrt(Sampling::LoadBlock(u + i, blockCount));
+        const SIMD b0 = one - s;
+        const SIMD b1 = Sampling::LoadBlock(v + i, blockCount) * s;
+        Sampling::StoreBlock(
+            b0, b1, one - b0 - b1, blockCount, barycentricsOut + i);
+    }
+}
+
+template <typename T>
+T Sampling::RadicalInverse(int base, std::uint64_t index)
+{
+    const double invBase = 1.0 / base;
+    double invBaseN = 1.0;
+    std::uint64_t reversedDigits = 0;
+    while (index > 0)
+    {
+        const std::uint64_t next = index / base;
+        const std::uint64_t digit = index - next * base;
+        reversedDigits = reversedDigits * base + digit;
+        invBaseN *= invBase;
+        index = next;
+    }
+
+    // Never return 1 after the rounding to T
+    const T oneMinusEpsilon = T(1) - std::numeric_limits<T>::epsilon() / T(2);
+    return Math::Min(static_cast<T>(reversedDigits * invBaseN),
+                     oneMinusEpsilon);
+}
+
+template <typename T>
+T Sampling::Halton(int dimension, std::uint64_t index)
+{
+    static const int Primes[16] = {
+        2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53};
+    return Sampling::RadicalInverse<T>(Primes[dimension], index);
+}
+
+template <typename T>
+Vector2G<T> Sampling::Halton2(std::uint64_t index)
+{
+    return Vector2G<T>(Sampling::Halton<T>(0, index),
+                       Sampling::Halton<T>(1, index));
+}
+
+// Kollig & Keller, "Efficient Multidimensional Sampling" (2002)
+template <typename T>
+Vector2G<T> Sampling::Sobol2(std::uint32_t index,
+                             std::uint32_t scrambleX,
+                             std::uint32_t scrambleY)
+{
+    // First dimension is the base 2 radical inverse, i.e. reversed bits
+    std::uint32_t x = index;
+    x = (x << 16) | (x >> 16);
+    x = ((x & 0x00ff00ffu) << 8) | ((x & 0xff00ff00u) >> 8);
+    x = ((x & 0x0f0f0f0fu) << 4) | ((x & 0xf0f0f0f0u) >> 4);
+    x = ((x & 0x33333333u) << 2) | ((x & 0xccccccccu) >> 2);
+    x = ((x & 0x55555555u) << 1) | ((x & 0xaaaaaaaau) >> 1);
+    x ^= scrambleX;
+
+    std::uint32_t y = scrambleY;
+    for (std::uint32_t v = (1u << 31); index != 0; index >>= 1, v ^= (v >> 1))
+    {
+        if (index & 1)
+        {
+            y ^= v;
+        }
+    }
+
+    return Vector2G<T>(Sampling::ToUnit<T>(x), Sampling::ToUnit<T>(y));
+}
+
+// http://extremelearning.com.au/unreasonable-effectiveness-of-quasirandom-
+// sequences/
+template <typename T>
+Vector2G<T> Sampling::R2(std::uint64_t index)
+{
+    const double plastic = 1.32471795724474602596;
+    const double a1 = 1.0 / plastic;
+    const double a2 = 1.0 / (plastic * plastic);
+    const double n = static_cast<double>(index);
+    const double x = 0.5 + a1 * n;
+    const double y = 0.5 + a2 * n;
+    const T oneMinusEpsilon = T(1) - std::numeric_limits<T>::epsilon() / T(2);
+    return Vector2G<T>(
+        Math::Min(static_cast<T>(x - std::floor(x)), oneMinusEpsilon),
+        Math::Min(static_cast<T>(y - std::floor(y)), oneMinusEpsilon));
+}
+
+template <typename T>
+void Sampling::FillHalton2(Vector2G<T> *pointsOut,
+                           std::size_t count,
+                           std::uint64_t firstIndex)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pointsOut[i] = Sampling::Halton2<T>(firstIndex + i);
+    }
+}
+
+template <typename T>
+void Sampling::FillSobol2(Vector2G<T> *pointsOut,
+                          std::size_t count,
+                          std::uint32_t firstIndex)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pointsOut[i] = Sampling::Sobol2<T>(
+            firstIndex + static_cast<std::uint32_t>(i));
+    }
+}
+
+template <typename T>
+void Sampling::FillR2(Vector2G<T> *pointsOut,
+                      std::size_t count,
+                      std::uint64_t firstIndex)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        pointsOut[i] = Sampling::R2<T>(firstIndex + i);
+    }
+}
+
+template <typename T>
+SIMD4G<T> Sampling::LoadBlock(const T *src, std::size_t count)
+{
+    if (count == 4)
+    {
+        return SIMD4G<T>::Load(src);
+    }
+
+    T block[4] = {};
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        block[i] = src[i];
+    }
+    return SIMD4G<T>::Load(block);
+}
+
+// With 2 pi u = 2a + pi, a = pi (u - 1/2) is in [-pi/2, pi/2), where short
+// Taylor series of sin(a) and cos(a) are accurate to the precision of T.
+// Then sin(2a + pi) = -2 sin(a) cos(a) and cos(2a + pi) = 2 sin(a)^2 - 1.
+template <typename T>
+void Sampling::SinCos2Pi(const SIMD4G<T> &u,
+                         SIMD4G<T> *sinOut,
+                         SIMD4G<T> *cosOut)
+{
+    using SIMD = SIMD4G<T>;
+
+    static const double SinCoefficients[] = {1.0,
+                                             -1.0 / 6.0,
+                                             1.0 / 120.0,
+                                             -1.0 / 5040.0,
+                                             1.0 / 362880.0,
+                                             -1.0 / 39916800.0,
+                                             1.0 / 6227020800.0,
+                                             -1.0 / 1307674368000.0,
+                                             1.0 / 355687428096000.0,
+                                             -1.0 / 121645100408832000.0};
+    static const double CosCoefficients[] = {1.0,
+                                             -1.0 / 2.0,
+                                             1.0 / 24.0,
+                                             -1.0 / 720.0,
+                                             1.0 / 40320.0,
+                                             -1.0 / 3628800.0,
+                                             1.0 / 479001600.0,
+                                             -1.0 / 87178291200.0,
+                                             1.0 / 20922789888000.0,
+                                             -1.0 / 6402373705728000.0,
+                                             1.0 / 2432902008176640000.0};
+    const bool isSinglePrecision = (sizeof(T) <= sizeof(float));
+    const int numSinTerms = (isSinglePrecision ? 6 : 10);
+    const int numCosTerms = (isSinglePrecision ? 7 : 11);
+
+    const SIMD a = (u - SIMD(T(0.5))) * SIMD(Math::Pi<T>());
+    const SIMD a2 = a * a;
+
+    SIMD sinPoly(static_cast<T>(SinCoefficients[numSinTerms - 1]));
+    for (int k = numSinTerms - 2; k >= 0; --k)
+    {
+        sinPoly = sinPoly * a2 + SIMD(static_cast<T>(SinCoefficients[k]));
+    }
+
+    SIMD cosPoly(static_cast<T>(CosCoefficients[numCosTerms - 1]));
+    for (int k = numCosTerms - 2; k >= 0; --k)
+    {
+        cosPoly = cosPoly * a2 + SIMD(static_cast<T>(CosCoefficients[k]));
+    }
+
+    const SIMD sinA = a * sinPoly;
+    const SIMD two(T(2));
+    *sinOut = -(two * sinA * cosPoly);
+    *cosOut = two * sinA * sinA - SIMD(T(1));
+}
+
+template <typename T>
+void Sampling::StoreBlock(const SIMD4G<T> &x,
+                          const SIMD4G<T> &y,
+                          std::size_t count,
+                          Vector2G<T> *out)
+{
+    T xs[4], ys[4];
+    x.Store(xs);
+    y.Store(ys);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = Vector2G<T>(xs[i], ys[i]);
+    }
+}
+
+template <typename T>
+void Sampling::StoreBlock(const SIMD4G<T> &x,
+                          const SIMD4G<T> &y,
+                          const SIMD4G<T> &z,
+                          std::size_t count,
+                          Vector3G<T> *out)
+{
+    T xs[4], ys[4], zs[4];
+    x.Store(xs);
+    y.Store(ys);
+    z.Store(zs);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = Vector3G<T>(xs[i], ys[i], zs[i]);
+    }
+}
+
+// Duff et al., "Building an Orthonormal Basis, Revisited" (2017)
+template <typename T>
+void Sampling::GetNormalBasis(const Vector3G<T> &normal,
+                              Vector3G<T> *tangent,
+                              Vector3G<T> *bitangent)
+{
+    const T sign = (normal.z >= 0) ? T(1) : T(-1);
+    const T a = T(-1) / (sign + normal.z);
+    const T b = normal.x * normal.y * a;
+    *tangent = Vector3G<T>(T(1) + sign * normal.x * normal.x * a,
+                           sign * b,
+                           -sign * normal.x);
+    *bitangent = Vector3G<T>(b, sign + normal.y * normal.y * a, -normal.y);
+}
+
+template <typename T>
+T Sampling::ToUnit(std::uint32_t bits)
+{
+    if (std::is_same<T, float>::value)
+    {
+        return static_cast<T>(static_cast<float>(bits >> 8) *
+                              (1.0f / 16777216.0f));
+    }
+    return static_cast<T>(bits * (1.0 / 4294967296.0));
+}
+}
@@ -4,7 +4,7 @@
 
 /**
 * @file    SimplexNoise.h
-* @brief   A Perlin Simplex Noise C++ Implementation (1D, 2D, 3D).
+* @brief   A Perlin Simplex Noise C++ Implementation (1D, 2D, 3D, 4D).
 *
 * Copyright (c) 2014-2018 Sebastien Rombauts (sebastien.rombauts@gmail.com)
 *
@@ -40,11 +40,117 @@ public:
     static float Noise(float x);
     static float Noise(float x, float y);
     static float Noise(float x, float y, float z);
+    static float Noise(float x, float y, float z, float w);
 
     // Fractal/Fractional Brownian Motion (fBm) noise summation
     float Fractal(size_t octaves, float x) const;
     float Fractal(size_t octaves, float x, float y) const;
     float Fractal(size_t octaves, float x, float y, float z) const;
+    float Fractal(size_t octaves, float x, float y, float z, float w) const;
+
+    /**
+     * Noise and its analytic gradient, cheaper than finite differences and
+     * exact. Useful for terrain normals and domain warping.
+     */
+    static float NoiseWithGradient(float x, float *gradientX);
+    static float NoiseWithGradient(float x,
+                                   float y,
+                                   float *gradientX,
+                                   float *gradientY);
+    static float NoiseWithGradient(float x,
+                                   float y,
+                                   float z,
+                                   float *gradientX,
+                                   float *gradientY,
+                                   float *gradientZ);
+    static float NoiseWithGradient(float x,
+                                   float y,
+                                   float z,
+                                   float w,
+                                   float *gradientX,
+                                   float *gradientY,
+                                   float *gradientZ,
+                                   float *gradientW);
+
+    float FractalWithGradient(size_t octaves,
+                              float x,
+                              float *gradientX) const;
+    float FractalWithGradient(size_t octaves,
+                              float x,
+                              float y,
+                              float *gradientX,
+                              float *gradientY) const;
+    float FractalWithGradient(size_t octaves,
+                              float x,
+                              float y,
+                              float z,
+                              float *gradientX,
+                              float *gradientY,
+                              float *gradientZ) const;
+    float FractalWithGradient(size_t octaves,
+                              float x,
+                              float y,
+                              float z,
+                              float w,
+                              float *gradientX,
+                              float *gradientY,
+                              float *gradientZ,
+                              float *gradientW) const;
+
+    /**
+     * Batch versions, evaluating count points given as separate coordinate
+     * arrays. Four points are evaluated at a time with SIMD, giving the same
+     * values as the single point functions.
+     */
+    static void Noise(const float *x,
+                      const float *y,
+                      size_t count,
+                      float *noiseOut);
+    static void Noise(const float *x,
+                      const float *y,
+                      const float *z,
+                      size_t count,
+                      float *noiseOut);
+    void Fractal(size_t octaves,
+                 const float *x,
+                 const float *y,
+                 size_t count,
+                 float *noiseOut) const;
+    void Fractal(size_t octaves,
+                 const float *x,
+                 const float *y,
+                 const float *z,
+                 size_t count,
+                 float *noiseOut) const;
+
+    /**
+     * Fills a row-major grid (x varies fastest) with the fractal noise
+     * sampled at origin + (column, row[, slice]) * step.
+     *
+     * @param[in] numThreads  Rows are split in tiles evaluated by this many
+     * threads. 0 uses std::thread::hardware_concurrency().
+     */
+    void FractalGrid(size_t octaves,
+                     float originX,
+                     float originY,
+                     float stepX,
+                     float stepY,
+                     size_t width,
+                     size_t height,
+                     float *noiseOut,
+                     size_t numThreads = 1) const;
+    void FractalGrid(size_t octaves,
+                     float originX,
+                     float originY,
+                     float originZ,
+                     float stepX,
+                     float stepY,
+                     float stepZ,
+                     size_t width,
+                     size_t height,
+                     size_t depth,
+                     float *noiseOut,
+                     size_t numThreads = 1) const;
 
 private:
     // Parameters of Fractional Brownian Motion (fBm) : sum of N "octaves" of
@@ -57,6 +163,22 @@ private:
                           /// between successive octaves (default to 2.0).
     float m_persistence;  ///< Persistence is the loss of amplitude between
                           /// successive octaves (usually 1/lacunarity)
+
+    // Number of points the fractal and grid functions evaluate at once
+    static constexpr size_t ChunkSize = 256;
+    // Number of grid rows per tile in the multithreaded grid functions
+    static constexpr size_t RowsPerTile = 16;
+
+    static void Noise4(const float *x, const float *y, float *noiseOut);
+    static void Noise4(const float *x,
+                       const float *y,
+                       const float *z,
+                       float *noiseOut);
+
+    template <class RowFunction>
+    static void ForEachRow(size_t numRows,
+                           size_t numThreads,
+                           RowFunction rowFunction);
 };
 }
 
@@ -2,7 +2,7 @@
 
 /**
  * @file    SimplexNoise.cpp
- * @brief   A Perlin Simplex Noise C++ Implementation (1D, 2D, 3D).
+ * @brief   A Perlin Simplex Noise C++ Implementation (1D, 2D, 3D, 4D).
  *
  * Copyright (c) 2014-2018 Sebastien Rombauts (sebastien.rombauts@gmail.com)
  *
@@ -27,8 +27,12 @@
  * or copy at http://opensource.org/licenses/MIT)
  */
 
+#include <algorithm>
 #include <cstdint>  // int32_t/uint8_t
 
+#include "BangMath/Parallel.h"
+#include "BangMath/SIMD.h"
+
 namespace Bang
 {
 /**
@@ -184,6 +188,243 @@ static float Grad(int32_t hash, float x, float y, float z)
     return ((h & 1) ? -u : u) + ((h & 2) ? -v : v);
 }
 
+/**
+ * Helper functions to compute gradients-dot-residual vectors (4D)
+ *
+ * @param[in] hash  hash value
+ * @param[in] x     x coord of the distance to the corner
+ * @param[in] y     y coord of the distance to the corner
+ * @param[in] z     z coord of the distance to the corner
+ * @param[in] w     w coord of the distance to the corner
+ *
+ * @return gradient value
+ */
+static float Grad(int32_t hash, float x, float y, float z, float w)
+{
+    const int32_t h = hash & 31;  // Convert low 5 bits of hash code into 32
+    const float u = h < 24 ? x : y;  // simple gradient directions, and
+    const float v = h < 16 ? y : z;  // compute the dot product.
+    const float t = h < 8 ? z : w;
+    return ((h & 1) ? -u : u) + ((h & 2) ? -v : v) + ((h & 4) ? -t : t);
+}
+
+/**
+ * Gradients of the above Grad functions for every hash value, so the batch
+ * functions can gather them instead of branching. The Grad functions are
+ * linear, so the dot product with the gradient gives the same result.
+ */
+struct SimplexNoiseGradients
+{
+    float x[256];
+    float y[256];
+    float z[256];
+    float w[256];
+};
+
+static const SimplexNoiseGradients &GetSimplexNoiseGradients2D()
+{
+    static const SimplexNoiseGradients gradients = []() {
+        SimplexNoiseGradients g;
+        for (int32_t h = 0; h < 256; ++h)
+        {
+            g.x[h] = Grad(h, 1.0f, 0.0f);
+            g.y[h] = Grad(h, 0.0f, 1.0f);
+            g.z[h] = 0.0f;
+            g.w[h] = 0.0f;
+        }
+        return g;
+    }();
+    return gradients;
+}
+
+static const SimplexNoiseGradients &GetSimplexNoiseGradients3D()
+{
+    static const SimplexNoiseGradients gradients = []() {
+        SimplexNoiseGradients g;
+        for (int32_t h = 0; h < 256; ++h)
+        {
+            g.x[h] = Grad(h, 1.0f, 0.0f, 0.0f);
+            g.y[h] = Grad(h, 0.0f, 1.0f, 0.0f);
+            g.z[h] = Grad(h, 0.0f, 0.0f, 1.0f);
+            g.w[h] = 0.0f;
+        }
+        return g;
+    }();
+    return gradients;
+}
+
+static const SimplexNoiseGradients &GetSimplexNoiseGradients4D()
+{
+    static const SimplexNoiseGradients gradients = []() {
+        SimplexNoiseGradients g;
+        for (int32_t h = 0; h < 256; ++h)
+        {
+            g.x[h] = Grad(h, 1.0f, 0.0f, 0.0f, 0.0f);
+            g.y[h] = Grad(h, 0.0f, 1.0f, 0.0f, 0.0f);
+            g.z[h] = Grad(h, 0.0f, 0.0f, 1.0f, 0.0f);
+            g.w[h] = Grad(h, 0.0f, 0.0f, 0.0f, 1.0f);
+        }
+        return g;
+    }();
+    return gradients;
+}
+
+/**
+ * Helper functions to find the simplex containing a point (2D, 3D, 4D)
+ *
+ * @param[out] distances  distances from the point to each simplex corner
+ * @param[out] hashes     hashed gradient index of each simplex corner
+ */
+static inline void GetSimplexCorners(float x,
+                                     float y,
+                                     float (&distances)[3][2],
+                                     int (&hashes)[3])
+{
+    static const float F2 = 0.366025403f;  // F2 = (sqrt(3) - 1) / 2
+    static const float G2 = 0.211324865f;  // G2 = (3 - sqrt(3)) / 6
+
+    const float s = (x + y) * F2;
+    const int32_t i = FastFloor(x + s);
+    const int32_t j = FastFloor(y + s);
+    const float t = static_cast<float>(i + j) * G2;
+    const float x0 = x - (i - t);
+    const float y0 = y - (j - t);
+    const int32_t i1 = (x0 > y0) ? 1 : 0;
+    const int32_t j1 = 1 - i1;
+
+    distances[0][0] = x0;
+    distances[0][1] = y0;
+    distances[1][0] = x0 - i1 + G2;
+    distances[1][1] = y0 - j1 + G2;
+    distances[2][0] = x0 - 1.0f + 2.0f * G2;
+    distances[2][1] = y0 - 1.0f + 2.0f * G2;
+
+    hashes[0] = Hash(i + Hash(j));
+    hashes[1] = Hash(i + i1 + Hash(j + j1));
+    hashes[2] = Hash(i + 1 + Hash(j + 1));
+}
+
+static inline void GetSimplexCorners(float x,
+                                     float y,
+                                     float z,
+                                     float (&distances)[4][3],
+                                     int (&hashes)[4])
+{
+    static const float F3 = 1.0f / 3.0f;
+    static const float G3 = 1.0f / 6.0f;
+
+    const float s = (x + y + z) * F3;
+    const int32_t i = FastFloor(x + s);
+    const int32_t j = FastFloor(y + s);
+    const int32_t k = FastFloor(z + s);
+    const float t = (i + j + k) * G3;
+    const float x0 = x - (i - t);
+    const float y0 = y - (j - t);
+    const float z0 = z - (k - t);
+
+    // Same rank ordering as the branches of Noise(x, y, z)
+    const bool xy = (x0 >= y0), yz = (y0 >= z0), xz = (x0 >= z0);
+    const int32_t i1 = (xy && xz) ? 1 : 0;
+    const int32_t j1 = (!xy && yz) ? 1 : 0;
+    const int32_t k1 = 1 - i1 - j1;
+    const int32_t i2 = (xy || (yz && xz)) ? 1 : 0;
+    const int32_t j2 = (!xy || yz) ? 1 : 0;
+    const int32_t k2 = (i2 && j2) ? 0 : 1;
+
+    const int32_t offsets[4][3] = {
+        {0, 0, 0}, {i1, j1, k1}, {i2, j2, k2}, {1, 1, 1}};
+    for (int c = 0; c < 4; ++c)
+    {
+        distances[c][0] = x0 - offsets[c][0] + c * G3;
+        distances[c][1] = y0 - offsets[c][1] + c * G3;
+        distances[c][2] = z0 - offsets[c][2] + c * G3;
+        hashes[c] =
+            Hash(i + offsets[c][0] +
+                 Hash(j + offsets[c][1] + Hash(k + offsets[c][2])));
+    }
+}
+
+static inline void GetSimplexCorners(float x,
+                                     float y,
+                                     float z,
+                                     float w,
+                                     float (&distances)[5][4],
+                                     int (&hashes)[5])
+{
+    static const float F4 = 0.309016994f;  // F4 = (sqrt(5) - 1) / 4
+    static const float G4 = 0.138196601f;  // G4 = (5 - sqrt(5)) / 20
+
+    // Skew the input space to determine which simplex cell we're in
+    const float s = (x + y + z + w) * F4;
+    const int32_t i = FastFloor(x + s);
+    const int32_t j = FastFloor(y + s);
+    const int32_t k = FastFloor(z + s);
+    const int32_t l = FastFloor(w + s);
+    const float t = (i + j + k + l) * G4;
+    const float d0[4] = {x - (i - t), y - (j - t), z - (k - t), w - (l - t)};
+
+    // For the 4D case, the simplex is a 4D shape. Rank the coordinates of
+    // the offset to find which of the 24 possible simplices we're in: the
+    // corner n (1 to 3) steps along the axes with a rank of 4 - n or more.
+    int rank[4] = {0, 0, 0, 0};
+    for (int a = 0; a < 4; ++a)
+    {
+        for (int b = a + 1; b < 4; ++b)
+        {
+            ++rank[(d0[a] > d0[b]) ? a : b];
+        }
+    }
+
+    const int32_t cell[4] = {i, j, k, l};
+    for (int c = 0; c < 5; ++c)
+    {
+        int32_t offsets[4];
+        for (int a = 0; a < 4; ++a)
+        {
+            offsets[a] = (rank[a] >= 4 - c) ? 1 : 0;
+            distances[c][a] = d0[a] - offsets[a] + c * G4;
+        }
+        hashes[c] = Hash(
+            cell[0] + offsets[0] +
+            Hash(cell[1] + offsets[1] +
+                 Hash(cell[2] + offsets[2] + Hash(cell[3] + offsets[3]))));
+    }
+}
+
+/**
+ * Adds the contribution (r^2 - |d|^2)^4 * (g . d) of a simplex corner and
+ * its analytic gradient, being d the distance to the corner, g the corner
+ * gradient and r^2 the squared radius of influence
+ */
+template <int N>
+static inline void AddSimplexCorner(float squaredRadius,
+                                    const float (&distance)[N],
+                                    const float (&cornerGradient)[N],
+                                    float *noise,
+                                    float (&gradient)[N])
+{
+    float t = squaredRadius;
+    float gradientDotDistance = 0.0f;
+    for (int a = 0; a < N; ++a)
+    {
+        t -= distance[a] * distance[a];
+        gradientDotDistance += cornerGradient[a] * distance[a];
+    }
+    if (t < 0.0f)
+    {
+        return;
+    }
+
+    const float t2 = t * t;
+    const float t4 = t2 * t2;
+    *noise += t4 * gradientDotDistance;
+    for (int a = 0; a < N; ++a)
+    {
+        gradient[a] += t4 * cornerGradient[a] -
+                       8.0f * t2 * t * gradientDotDistance * distance[a];
+    }
+}
+
 SimplexNoise::SimplexNoise(float frequency,
                            float amplitude,
                            float lacunarity,
@@ -507,6 +748,40 @@ float SimplexNoise::Noise(float x, float y, float z)
     return 32.0f * (n0 + n1 + n2 + n3);
 }
 
+/**
+ * 4D Perlin simplex noise
+ *
+ * @param[in] x float coordinate
+ * @param[in] y float coordinate
+ * @param[in] z float coordinate
+ * @param[in] w float coordinate
+ *
+ * @return Noise value in the range[-1; 1], value of 0 on all integer
+ * coordinates.
+ */
+inline float SimplexNoise::Noise(float x, float y, float z, float w)
+{
+    float distances[5][4];
+    int hashes[5];
+    GetSimplexCorners(x, y, z, w, distances, hashes);
+
+    // Calculate the contribution from the five corners
+    float n = 0.0f;
+    for (int c = 0; c < 5; ++c)
+    {
+        const float(&d)[4] = distances[c];
+        float t = 0.6f - d[0] * d[0] - d[1] * d[1] - d[2] * d[2] - d[3] * d[3];
+        if (t >= 0.0f)
+        {
+            t *= t;
+            n += t * t * Grad(hashes[c], d[0], d[1], d[2], d[3]);
+        }
+    }
+
+    // The result is scaled to stay just inside [-1,1]
+    return 27.0f * n;
+}
+
 /**
  * Fractal/Fractional Brownian Motion (fBm) summation of 1D Perlin Simplex noise
  *
@@ -594,4 +869,787 @@ float SimplexNoise::Fractal(size_t octaves, float x, float y, float z) const
 
     return (output / denom);
 }
+
+/**
+ * Fractal/Fractional Brownian Motion (fBm) summation of 4D Perlin Simplex noise
+ *
+ * @param[in] octaves   number of fraction of noise to sum
+ * @param[in] x         x float coordinate
+ * @param[in] y         y float coordinate
+ * @param[in] z         z float coordinate
+ * @param[in] w         w float coordinate
+ *
+ * @return Noise value in the range[-1; 1], value of 0 on all integer
+ * coordinates.
+ */
+inline float SimplexNoise::Fractal(size_t octaves,
+                                   float x,
+                                   float y,
+                                   float z,
+                                   float w) const
+{
+    float output = 0.f;
+    float denom = 0.f;
+    float frequency = m_frequency;
+    float amplitude = m_amplitude;
+
+    for (size_t i = 0; i < octaves; i++)
+    {
+        output += (amplitude * Noise(x * frequency,
+                                     y * frequency,
+                                     z * frequency,
+                                     w * frequency));
+        denom += amplitude;
+
+        frequency *= m_lacunarity;
+        amplitude *= m_persistence;
+    }
+
+    return (output / denom);
+}
+
+/**
+ * 1D Perlin simplex noise and its analytic derivative
+ *
+ * @param[in] x             float coordinate
+ * @param[out] gradientX    derivative of the noise along x
+ *
+ * @return Same noise value as Noise(x)
+ */
+inline float SimplexNoise::NoiseWithGradient(float x, float *gradientX)
+{
+    const int32_t i0 = FastFloor(x);
+    const float distances[2][1] = {{x - i0}, {x - i0 - 1.0f}};
+
+    float noise = 0.0f;
+    float gradient[1] = {0.0f};
+    for (int c = 0; c < 2; ++c)
+    {
+        const float cornerGradient[1] = {Grad(Hash(i0 + c), 1.0f)};
+        AddSimplexCorner(
+            1.0f, distances[c], cornerGradient, &noise, gradient);
+    }
+
+    *gradientX = 0.395f * gradient[0];
+    return 0.395f * noise;
+}
+
+/**
+ * 2D Perlin simplex noise and its analytic gradient
+ *
+ * @param[in] x             float coordinate
+ * @param[in] y             float coordinate
+ * @param[out] gradientX    partial derivative of the noise along x
+ * @param[out] gradientY    partial derivative of the noise along y
+ *
+ * @return Same noise value as Noise(x, y)
+ */
+inline float SimplexNoise::NoiseWithGradient(float x,
+                                             float y,
+                                             float *gradientX,
+                                             float *gradientY)
+{
+    float distances[3][2];
+    int hashes[3];
+    GetSimplexCorners(x, y, distances, hashes);
+
+    const SimplexNoiseGradients &gradients = GetSimplexNoiseGradients2D();
+    float noise = 0.0f;
+    float gradient[2] = {0.0f, 0.0f};
+    for (int c = 0; c < 3; ++c)
+    {
+        const int h = hashes[c];
+        const float cornerGradient[2] = {gradients.x[h], gradients.y[h]};
+        AddSimplexCorner(
+            0.5f, distances[c], cornerGradient, &noise, gradient);
+    }
+
+    *gradientX = 45.23065f * gradient[0];
+    *gradientY = 45.23065f * gradient[1];
+    return 45.23065f * noise;
+}
+
+/**
+ * 3D Perlin simplex noise and its analytic gradient
+ *
+ * @return Same noise value as Noise(x, y, z)
+ */
+inline float SimplexNoise::NoiseWithGradient(float x,
+                                             float y,
+                                             float z,
+                                             float *gradientX,
+                                             float *gradientY,
+                                             float *gradientZ)
+{
+    float distances[4][3];
+    int hashes[4];
+    GetSimplexCorners(x, y, z, distances, hashes);
+
+    const SimplexNoiseGradients &gradients = GetSimplexNoiseGradients3D();
+    float noise = 0.0f;
+    float gradient[3] = {0.0f, 0.0f, 0.0f};
+    for (int c = 0; c < 4; ++c)
+    {
+        const int h = hashes[c];
+        const float cornerGradient[3] = {
+            gradients.x[h], gradients.y[h], gradients.z[h]};
+        AddSimplexCorner(
+            0.6f, distances[c], cornerGradient, &noise, gradient);
+    }
+
+    *gradientX = 32.0f * gradient[0];
+    *gradientY = 32.0f * gradient[1];
+    *gradientZ = 32.0f * gradient[2];
+    return 32.0f * noise;
+}
+
+/**
+ * 4D Perlin simplex noise and its analytic gradient
+ *
+ * @return Same noise value as Noise(x, y, z, w)
+ */
+inline float SimplexNoise::NoiseWithGradient(float x,
+                                             float y,
+                                             float z,
+                                             float w,
+                                             float *gradientX,
+                                             float *gradientY,
+                                             float *gradientZ,
+                                             float *gradientW)
+{
+    float distances[5][4];
+    int hashes[5];
+    GetSimplexCorners(x, y, z, w, distances, hashes);
+
+    const SimplexNoiseGradients &gradients = GetSimplexNoiseGradients4D();
+    float noise = 0.0f;
+    float gradient[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int c = 0; c < 5; ++c)
+    {
+        const int h = hashes[c];
+        const float cornerGradient[4] = {
+            gradients.x[h], gradients.y[h], gradients.z[h], gradients.w[h]};
+        AddSimplexCorner(
+            0.6f, distances[c], cornerGradient, &noise, gradient);
+    }
+
+    *gradientX = 27.0f * gradient[0];
+    *gradientY = 27.0f * gradient[1];
+    *gradientZ = 27.0f * gradient[2];
+    *gradientW = 27.0f * gradient[3];
+    return 27.0f * noise;
+}
+
+/**
+ * fBm summation of 1D Perlin Simplex noise and its analytic derivative
+ *
+ * @return Same noise value as Fractal(octaves, x)
+ */
+inline float SimplexNoise::FractalWithGradient(size_t octaves,
+                                               float x,
+                                               float *gradientX) const
+{
+    float output = 0.f;
+    float gradient = 0.f;
+    float denom = 0.f;
+    float frequency = m_frequency;
+    float amplitude = m_amplitude;
+
+    for (size_t i = 0; i < octaves; i++)
+    {
+        float octaveGradient;
+        output +=
+            (amplitude * NoiseWithGradient(x * frequency, &octaveGradient));
+        gradient += (amplitude * frequency) * octaveGradient;
+        denom += amplitude;
+
+        frequency *= m_lacunarity;
+        amplitude *= m_persistence;
+    }
+
+    *gradientX = (gradient / denom);
+    return (output / denom);
+}
+
+/**
+ * fBm summation of 2D Perlin Simplex noise and its analytic gradient
+ *
+ * @return Same noise value as Fractal(octaves, x, y)
+ */
+inline float SimplexNoise::FractalWithGradient(size_t octaves,
+                                               float x,
+                                               float y,
+                                               float *gradientX,
+                                               float *gradientY) const
+{
+    float output = 0.f;
+    float gradient[2] = {0.f, 0.f};
+    float denom = 0.f;
+    float frequency = m_frequency;
+    float amplitude = m_amplitude;
+
+    for (size_t i = 0; i < octaves; i++)
+    {
+        float octaveGradient[2];
+        output += (amplitude * NoiseWithGradient(x * frequency,
+                                                 y * frequency,
+                                                 &octaveGradient[0],
+                                                 &octaveGradient[1]));
+        for (int a = 0; a < 2; ++a)
+        {
+            gradient[a] += (amplitude * frequency) * octaveGradient[a];
+        }
+        denom += amplitude;
+
+        frequency *= m_lacunarity;
+        amplitude *= m_persistence;
+    }
+
+    *gradientX = (gradient[0] / denom);
+    *gradientY = (gradient[1] / denom);
+    return (output / denom);
+}
+
+/**
+ * fBm summation of 3D Perlin Simplex noise and its analytic gradient
+ *
+ * @return Same noise value as Fractal(octaves, x, y, z)
+ */
+inline float SimplexNoise::FractalWithGradient(size_t octaves,
+                                               float x,
+                                               float y,
+                                               float z,
+                                               float *gradientX,
+                                               float *gradientY,
+                                               float *gradientZ) const
+{
+    float output = 0.f;
+    float gradient[3] = {0.f, 0.f, 0.f};
+    float denom = 0.f;
+    float frequency = m_frequency;
+    float amplitude = m_amplitude;
+
+    for (size_t i = 0; i < octaves; i++)
+    {
+        float octaveGradient[3];
+        output += (amplitude * NoiseWithGradient(x * frequency,
+                                                 y * frequency,
+                                                 z * frequency,
+                                                 &octaveGradient[0],
+                                                 &octaveGradient[1],
+                                                 &octaveGradient[2]));
+        for (int a = 0; a < 3; ++a)
+        {
+            gradient[a] += (amplitude * frequency) * octaveGradient[a];
+        }
+        denom += amplitude;
+
+        frequency *= m_lacunarity;
+        amplitude *= m_persistence;
+    }
+
+    *gradientX = (gradient[0] / denom);
+    *gradientY = (gradient[1] / denom);
+    *gradientZ = (gradient[2] / denom);
+    return (output / denom);
+}
+
+/**
+ * fBm summation of 4D Perlin Simplex noise and its analytic gradient
+ *
+ * @return Same noise value as Fractal(octaves, x, y, z, w)
+ */
+inline float SimplexNoise::FractalWithGradient(size_t octaves,
+                                               float x,
+                                               float y,
+                                               float z,
+                                               float w,
+                                               float *gradientX,
+                                               float *gradientY,
+                                               float *gradientZ,
+                                               float *gradientW) const
+{
+    float output = 0.f;
+    float gradient[4] = {0.f, 0.f, 0.f, 0.f};
+    float denom = 0.f;
+    float frequency = m_frequency;
+    float amplitude = m_amplitude;
+
+    for (size_t i = 0; i < octaves; i++)
+    {
+        float octaveGradient[4];
+        output += (amplitude * NoiseWithGradient(x * frequency,
+                                                 y * frequency,
+                                                 z * frequency,
+                                                 w * frequency,
+                                                 &octaveGradient[0],
+                                                 &octaveGradient[1],
+                                                 &octaveGradient[2],
+                                                 &octaveGradient[3]));
+        for (int a = 0; a < 4; ++a)
+        {
+            gradient[a] += (amplitude * frequency) * octaveGradient[a];
+        }
+        denom += amplitude;
+
+        frequency *= m_lacunarity;
+        amplitude *= m_persistence;
+    }
+
+    *gradientX = (gradient[0] / denom);
+    *gradientY = (gradient[1] / denom);
+    *gradientZ = (gradient[2] / denom);
+    *gradientW = (gradient[3] / denom);
+    return (output / denom);
+}
+
+/**
+ * 2D Perlin simplex noise of four points at once
+ *
+ * Same steps as the single point version. The coordinates math runs in
+ * SIMD, while the lattice hashing and the gradients gather are done per
+ * lane.
+ */
+inline void SimplexNoise::Noise4(const float *x,
+                                 const float *y,
+                                 float *noiseOut)
+{
+    using SIMD = SIMD4G<float>;
+    static const float F2 = 0.366025403f;
+    static const float G2 = 0.211324865f;
+    const SimplexNoiseGradients &gradients = GetSimplexNoiseGradients2D();
+
+    // Skew the input space to determine which simplex cell we're in
+    const SIMD vx = SIMD::Load(x);
+    const SIMD vy = SIMD::Load(y);
+    const SIMD s = (vx + vy) * SIMD(F2);
+    float xs[4], ys[4];
+    (vx + s).Store(xs);
+    (vy + s).Store(ys);
+
+    int32_t i[4], j[4];
+    float cellI[4], cellJ[4], cellSum[4];
+    for (int l = 0; l < 4; ++l)
+    {
+        i[l] = FastFloor(xs[l]);
+        j[l] = FastFloor(ys[l]);
+        cellI[l] = static_cast<float>(i[l]);
+        cellJ[l] = static_cast<float>(j[l]);
+        cellSum[l] = static_cast<float>(i[l] + j[l]);
+    }
+
+    // Unskew the cell origin back to (x,y) space
+    const SIMD t = SIMD::Load(cellSum) * SIMD(G2);
+    const SIMD x0 = vx - (SIMD::Load(cellI) - t);
+    const SIMD y0 = vy - (SIMD::Load(cellJ) - t);
+
+    // Lower (x0 > y0) or upper triangle, and gradients of the three corners
+    const int lowerMask = SIMD::LessMask(y0, x0);
+    float i1[4], j1[4];
+    float g0x[4], g0y[4], g1x[4], g1y[4], g2x[4], g2y[4];
+    for (int l = 0; l < 4; ++l)
+    {
+        const int32_t di = (lowerMask >> l) & 1;
+        const int32_t dj = 1 - di;
+        i1[l] = static_cast<float>(di);
+        j1[l] = static_cast<float>(dj);
+
+        const int gi0 = Hash(i[l] + Hash(j[l]));
+        const int gi1 = Hash(i[l] + di + Hash(j[l] + dj));
+        const int gi2 = Hash(i[l] + 1 + Hash(j[l] + 1));
+        g0x[l] = gradients.x[gi0];
+        g0y[l] = gradients.y[gi0];
+        g1x[l] = gradients.x[gi1];
+        g1y[l] = gradients.y[gi1];
+        g2x[l] = gradients.x[gi2];
+        g2y[l] = gradients.y[gi2];
+    }
+
+    const SIMD x1 = x0 - SIMD::Load(i1) + SIMD(G2);
+    const SIMD y1 = y0 - SIMD::Load(j1) + SIMD(G2);
+    const SIMD x2 = x0 - SIMD(1.0f) + SIMD(2.0f * G2);
+    const SIMD y2 = y0 - SIMD(1.0f) + SIMD(2.0f * G2);
+
+    // Contributions of the three corners, zero outside of their radius
+    const SIMD zero(0.0f), radius(0.5f);
+    SIMD t0 = SIMD::Max(zero, radius - x0 * x0 - y0 * y0);
+    SIMD t1 = SIMD::Max(zero, radius - x1 * x1 - y1 * y1);
+    SIMD t2 = SIMD::Max(zero, radius - x2 * x2 - y2 * y2);
+    t0 = t0 * t0;
+    t1 = t1 * t1;
+    t2 = t2 * t2;
+    const SIMD n0 =
+        t0 * t0 * (SIMD::Load(g0x) * x0 + SIMD::Load(g0y) * y0);
+    const SIMD n1 =
+        t1 * t1 * (SIMD::Load(g1x) * x1 + SIMD::Load(g1y) * y1);
+    const SIMD n2 =
+        t2 * t2 * (SIMD::Load(g2x) * x2 + SIMD::Load(g2y) * y2);
+
+    (SIMD(45.23065f) * (n0 + n1 + n2)).Store(noiseOut);
+}
+
+/**
+ * 3D Perlin simplex noise of four points at once
+ */
+inline void SimplexNoise::Noise4(const float *x,
+                                 const float *y,
+                                 const float *z,
+                                 float *noiseOut)
+{
+    using SIMD = SIMD4G<float>;
+    static const float F3 = 1.0f / 3.0f;
+    static const float G3 = 1.0f / 6.0f;
+    const SimplexNoiseGradients &gradients = GetSimplexNoiseGradients3D();
+
+    // Skew the input space to determine which simplex cell we're in
+    const SIMD vx = SIMD::Load(x);
+    const SIMD vy = SIMD::Load(y);
+    const SIMD vz = SIMD::Load(z);
+    const SIMD s = (vx + vy + vz) * SIMD(F3);
+    float xs[4], ys[4], zs[4];
+    (vx + s).Store(xs);
+    (vy + s).Store(ys);
+    (vz + s).Store(zs);
+
+    int32_t i[4], j[4], k[4];
+    float cellI[4], cellJ[4], cellK[4], cellSum[4];
+    for (int l = 0; l < 4; ++l)
+    {
+        i[l] = FastFloor(xs[l]);
+        j[l] = FastFloor(ys[l]);
+        k[l] = FastFloor(zs[l]);
+        cellI[l] = static_cast<float>(i[l]);
+        cellJ[l] = static_cast<float>(j[l]);
+        cellK[l] = static_cast<float>(k[l]);
+        cellSum[l] = static_cast<float>(i[l] + j[l] + k[l]);
+    }
+
+    // Unskew the cell origin back to (x,y,z) space
+    const SIMD t = SIMD::Load(cellSum) * SIMD(G3);
+    const SIMD x0 = vx - (SIMD::Load(cellI) - t);
+    const SIMD y0 = vy - (SIMD::Load(cellJ) - t);
+    const SIMD z0 = vz - (SIMD::Load(cellK) - t);
+
+    // Rank ordering of x0, y0, z0 gives the simplex we are in, same as the
+    // branches of the single point version
+    const int xyMask = SIMD::LessEqualMask(y0, x0);
+    const int yzMask = SIMD::LessEqualMask(z0, y0);
+    const int xzMask = SIMD::LessEqualMask(z0, x0);
+    float i1[4], j1[4], k1[4], i2[4], j2[4], k2[4];
+    float g0x[4], g0y[4], g0z[4], g1x[4], g1y[4], g1z[4];
+    float g2x[4], g2y[4], g2z[4], g3x[4], g3y[4], g3z[4];
+    for (int l = 0; l < 4; ++l)
+    {
+        const bool xy = ((xyMask >> l) & 1) != 0;
+        const bool yz = ((yzMask >> l) & 1) != 0;
+        const bool xz = ((xzMask >> l) & 1) != 0;
+        const int32_t di1 = (xy && xz) ? 1 : 0;
+        const int32_t dj1 = (!xy && yz) ? 1 : 0;
+        const int32_t dk1 = 1 - di1 - dj1;
+        const int32_t di2 = (xy || (yz && xz)) ? 1 : 0;
+        const int32_t dj2 = (!xy || yz) ? 1 : 0;
+        const int32_t dk2 = (di2 && dj2) ? 0 : 1;
+        i1[l] = static_cast<float>(di1);
+        j1[l] = static_cast<float>(dj1);
+        k1[l] = static_cast<float>(dk1);
+        i2[l] = static_cast<float>(di2);
+        j2[l] = static_cast<float>(dj2);
+        k2[l] = static_cast<float>(dk2);
+
+        const int gi0 = Hash(i[l] + Hash(j[l] + Hash(k[l])));
+        const int gi1 =
+            Hash(i[l] + di1 + Hash(j[l] + dj1 + Hash(k[l] + dk1)));
+        const int gi2 =
+            Hash(i[l] + di2 + Hash(j[l] + dj2 + Hash(k[l] + dk2)));
+        const int gi3 = Hash(i[l] + 1 + Hash(j[l] + 1 + Hash(k[l] + 1)));
+        g0x[l] = gradients.x[gi0];
+        g0y[l] = gradients.y[gi0];
+        g0z[l] = gradients.z[gi0];
+        g1x[l] = gradients.x[gi1];
+        g1y[l] = gradients.y[gi1];
+        g1z[l] = gradients.z[gi1];
+        g2x[l] = gradients.x[gi2];
+        g2y[l] = gradients.y[gi2];
+        g2z[l] = gradients.z[gi2];
+        g3x[l] = gradients.x[gi3];
+        g3y[l] = gradients.y[gi3];
+        g3z[l] = gradients.z[gi3];
+    }
+
+    const SIMD g1(G3), g2(2.0f * G3), g3(3.0f * G3), one(1.0f);
+    const SIMD x1 = x0 - SIMD::Load(i1) + g1;
+    const SIMD y1 = y0 - SIMD::Load(j1) + g1;
+    const SIMD z1 = z0 - SIMD::Load(k1) + g1;
+    const SIMD x2 = x0 - SIMD::Load(i2) + g2;
+    const SIMD y2 = y0 - SIMD::Load(j2) + g2;
+    const SIMD z2 = z0 - SIMD::Load(k2) + g2;
+    const SIMD x3 = x0 - one + g3;
+    const SIMD y3 = y0 - one + g3;
+    const SIMD z3 = z0 - one + g3;
+
+    // Contributions of the four corners, zero outside of their radius
+    const SIMD zero(0.0f), radius(0.6f);
+    SIMD t0 = SIMD::Max(zero, radius - x0 * x0 - y0 * y0 - z0 * z0);
+    SIMD t1 = SIMD::Max(zero, radius - x1 * x1 - y1 * y1 - z1 * z1);
+    SIMD t2 = SIMD::Max(zero, radius - x2 * x2 - y2 * y2 - z2 * z2);
+    SIMD t3 = SIMD::Max(zero, radius - x3 * x3 - y3 * y3 - z3 * z3);
+    t0 = t0 * t0;
+    t1 = t1 * t1;
+    t2 = t2 * t2;
+    t3 = t3 * t3;
+    const SIMD n0 = t0 * t0 * (SIMD::Load(g0x) * x0 + SIMD::Load(g0y) * y0 +
+                               SIMD::Load(g0z) * z0);
+    const SIMD n1 = t1 * t1 * (SIMD::Load(g1x) * x1 + SIMD::Load(g1y) * y1 +
+                               SIMD::Load(g1z) * z1);
+    const SIMD n2 = t2 * t2 * (SIMD::Load(g2x) * x2 + SIMD::Load(g2y) * y2 +
+                               SIMD::Load(g2z) * z2);
+    const SIMD n3 = t3 * t3 * (SIMD::Load(g3x) * x3 + SIMD::Load(g3y) * y3 +
+                               SIMD::Load(g3z) * z3);
+
+    (SIMD(32.0f) * (n0 + n1 + n2 + n3)).Store(noiseOut);
+}
+
+/**
+ * Batch 2D Perlin simplex noise
+ *
+ * @param[in] x         x float coordinates
+ * @param[in] y         y float coordinates
+ * @param[in] count     number of points
+ * @param[out] noiseOut count noise values in the range [-1; 1]
+ */
+inline void SimplexNoise::Noise(const float *x,
+                                const float *y,
+                                size_t count,
+                                float *noiseOut)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        Noise4(x + i, y + i, noiseOut + i);
+    }
+
+    if (i < count)
+    {
+        float tailX[4] = {}, tailY[4] = {}, tailNoise[4];
+        std::copy(x + i, x + count, tailX);
+        std::copy(y + i, y + count, tailY);
+        Noise4(tailX, tailY, tailNoise);
+        std::copy(tailNoise, tailNoise + (count - i), noiseOut + i);
+    }
+}
+
+/**
+ * Batch 3D Perlin simplex noise
+ *
+ * @param[in] x         x float coordinates
+ * @param[in] y         y float coordinates
+ * @param[in] z         z float coordinates
+ * @param[in] count     number of points
+ * @param[out] noiseOut count noise values in the range [-1; 1]
+ */
+inline void SimplexNoise::Noise(const float *x,
+                                const float *y,
+                                const float *z,
+                                size_t count,
+                                float *noiseOut)
+{
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4)
+    {
+        Noise4(x + i, y + i, z + i, noiseOut + i);
+    }
+
+    if (i < count)
+    {
+        float tailX[4] = {}, tailY[4] = {}, tailZ[4] = {}, tailNoise[4];
+        std::copy(x + i, x + count, tailX);
+        std::copy(y + i, y + count, tailY);
+        std::copy(z + i, z + count, tailZ);
+        Noise4(tailX, tailY, tailZ, tailNoise);
+        std::copy(tailNoise, tailNoise + (count - i), noiseOut + i);
+    }
+}
+
+/**
+ * Batch fBm summation of 2D Perlin Simplex noise
+ *
+ * Points are processed in chunks, evaluating all the octaves of a chunk
+ * before moving to the next one to stay in cache.
+ */
+inline void SimplexNoise::Fractal(size_t octaves,
+                                  const float *x,
+                                  const float *y,
+                                  size_t count,
+                                  float *noiseOut) const
+{
+    float xs[ChunkSize], ys[ChunkSize], noise[ChunkSize];
+    for (size_t first = 0; first < count; first += ChunkSize)
+    {
+        const size_t n = std::min(count - first, size_t(ChunkSize));
+        float *output = noiseOut + first;
+        std::fill(output, output + n, 0.0f);
+
+        float denom = 0.f;
+        float frequency = m_frequency;
+        float amplitude = m_amplitude;
+        for (size_t octave = 0; octave < octaves; ++octave)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                xs[i] = x[first + i] * frequency;
+                ys[i] = y[first + i] * frequency;
+            }
+            Noise(xs, ys, n, noise);
+            for (size_t i = 0; i < n; ++i)
+            {
+                output[i] += (amplitude * noise[i]);
+            }
+            denom += amplitude;
+
+            frequency *= m_lacunarity;
+            amplitude *= m_persistence;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            output[i] = (output[i] / denom);
+        }
+    }
+}
+
+/**
+ * Batch fBm summation of 3D Perlin Simplex noise
+ */
+inline void SimplexNoise::Fractal(size_t octaves,
+                                  const float *x,
+                                  const float *y,
+                                  const float *z,
+                                  size_t count,
+                                  float *noiseOut) const
+{
+    float xs[ChunkSize], ys[ChunkSize], zs[ChunkSize], noise[ChunkSize];
+    for (size_t first = 0; first < count; first += ChunkSize)
+    {
+        const size_t n = std::min(count - first, size_t(ChunkSize));
+        float *output = noiseOut + first;
+        std::fill(output, output + n, 0.0f);
+
+        float denom = 0.f;
+        float frequency = m_frequency;
+        float amplitude = m_amplitude;
+        for (size_t octave = 0; octave < octaves; ++octave)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                xs[i] = x[first + i] * frequency;
+                ys[i] = y[first + i] * frequency;
+                zs[i] = z[first + i] * frequency;
+            }
+            Noise(xs, ys, zs, n, noise);
+            for (size_t i = 0; i < n; ++i)
+            {
+                output[i] += (amplitude * noise[i]);
+            }
+            denom += amplitude;
+
+            frequency *= m_lacunarity;
+            amplitude *= m_persistence;
+        }
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            output[i] = (output[i] / denom);
+        }
+    }
+}
+
+/**
+ * Fills a width x height grid with 2D fBm noise
+ */
+inline void SimplexNoise::FractalGrid(size_t octaves,
+                                      float originX,
+                                      float originY,
+                                      float stepX,
+                                      float stepY,
+                                      size_t width,
+                                      size_t height,
+                                      float *noiseOut,
+                                      size_t numThreads) const
+{
+    ForEachRow(height, numThreads, [&](size_t row) {
+        float xs[ChunkSize], ys[ChunkSize];
+        const float y = originY + static_cast<float>(row) * stepY;
+        std::fill(ys, ys + ChunkSize, y);
+
+        float *rowOutput = noiseOut + row * width;
+        for (size_t first = 0; first < width; first += ChunkSize)
+        {
+            const size_t n = std::min(width - first, size_t(ChunkSize));
+            for (size_t i = 0; i < n; ++i)
+            {
+                xs[i] = originX + static_cast<float>(first + i) * stepX;
+            }
+            Fractal(octaves, xs, ys, n, rowOutput + first);
+        }
+    });
+}
+
+/**
+ * Fills a width x height x depth grid with 3D fBm noise
+ */
+inline void SimplexNoise::FractalGrid(size_t octaves,
+                                      float originX,
+                                      float originY,
+                                      float originZ,
+                                      float stepX,
+                                      float stepY,
+                                      float stepZ,
+                                      size_t width,
+                                      size_t height,
+                                      size_t depth,
+                                      float *noiseOut,
+                                      size_t numThreads) const
+{
+    ForEachRow(height * depth, numThreads, [&](size_t row) {
+        float xs[ChunkSize], ys[ChunkSize], zs[ChunkSize];
+        const size_t slice = row / height;
+        const float y =
+            originY + static_cast<float>(row - slice * height) * stepY;
+        const float z = originZ + static_cast<float>(slice) * stepZ;
+        std::fill(ys, ys + ChunkSize, y);
+        std::fill(zs, zs + ChunkSize, z);
+
+        float *rowOutput = noiseOut + row * width;
+        for (size_t first = 0; first < width; first += ChunkSize)
+        {
+            const size_t n = std::min(width - first, size_t(ChunkSize));
+            for (size_t i = 0; i < n; ++i)
+            {
+                xs[i] = originX + static_cast<float>(first + i) * stepX;
+            }
+            Fractal(octaves, xs, ys, zs, n, rowOutput + first);
+        }
+    });
+}
+
+/**
+ * Calls rowFunction(row) for every row in [0, numRows), splitting them in
+ * tiles of RowsPerTile rows that numThreads threads pick in order. The
+ * calling thread is one of them.
+ */
+template <class RowFunction>
+void SimplexNoise::ForEachRow(size_t numRows,
+                              size_t numThreads,
+                              RowFunction rowFunction)
+{
+    Parallel::ForTiles(numRows,
+                       RowsPerTile,
+                       numThreads,
+                       [&](size_t beginRow, size_t endRow, size_t) {
+                           for (size_t row = beginRow; row < endRow; ++row)
+                           {
+                               rowFunction(row);
+                           }
+                       });
+}
 }
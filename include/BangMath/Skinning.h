@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "BangMath/Defines.h"
+#include "BangMath/SIMD.h"
+
+namespace Bang
+{
+template <typename>
+class AABoxG;
+template <typename>
+class Matrix3x4G;
+template <typename>
+class Matrix4G;
+template <typename>
+class Vector3G;
+
+// Linear blend skinning over vertex streams. Every vertex blends the palette
+// matrices of its bones by weight, and its position and normal are
+// transformed by the blend.
+//
+// With SIMD, four vertices are skinned at a time: their blended matrices
+// are accumulated a column per register, transposed so that each lane holds
+// one vertex, and positions and normals are then transformed, normalized
+// and bounded in x, y, z lanes, loaded and stored packed. Meshes are split
+// in tiles of consecutive vertices that several threads can pick.
+template <typename T>
+class SkinningG
+{
+public:
+    static constexpr std::size_t VerticesPerTile = 1024;
+
+    // Vertex i has influencesPerVertex bone indices into the palette and
+    // weights starting at i * influencesPerVertex. Its weights should add up
+    // to one, and zero weights are skipped. Vertices without a non zero
+    // weight are copied unchanged, like in DualQuaternionG::Skin. Palettes
+    // are affine: the last row of Matrix4G is ignored.
+    //
+    // Normals are transformed by the linear part of the blend and
+    // normalized, which is exact for palettes without non uniform scale.
+    // normals and normalsOut can be null, and the outputs can be the same
+    // buffers as the inputs. The bounds of the skinned positions go to
+    // boundsOut if it is not null. numThreads 0 uses as many threads as the
+    // hardware supports.
+    static void LinearBlend(const Matrix4G<T> *palette,
+                            const std::uint32_t *boneIndices,
+                            const T *boneWeights,
+                            std::size_t influencesPerVertex,
+                            const Vector3G<T> *positions,
+                            const Vector3G<T> *normals,
+                            Vector3G<T> *positionsOut,
+                            Vector3G<T> *normalsOut,
+                            std::size_t count,
+                            AABoxG<T> *boundsOut = nullptr,
+                            std::size_t numThreads = 1);
+    static void LinearBlend(const Matrix3x4G<T> *palette,
+                            const std::uint32_t *boneIndices,
+                            const T *boneWeights,
+                            std::size_t influencesPerVertex,
+                            const Vector3G<T> *positions,
+                            const Vector3G<T> *normals,
+                            Vector3G<T> *positionsOut,
+                            Vector3G<T> *normalsOut,
+                            std::size_t count,
+                            AABoxG<T> *boundsOut = nullptr,
+                            std::size_t numThreads = 1);
+
+    SkinningG() = delete;
+
+private:
+    template <typename Matrix>
+    static void LinearBlendTiles(const Matrix *palette,
+                                 const std::uint32_t *boneIndices,
+                                 const T *boneWeights,
+                                 std::size_t influencesPerVertex,
+                                 const Vector3G<T> *positions,
+                                 const Vector3G<T> *normals,
+                                 Vector3G<T> *positionsOut,
+                                 Vector3G<T> *normalsOut,
+                                 std::size_t count,
+                                 AABoxG<T> *boundsOut,
+                                 std::size_t numThreads);
+
+    // Skins vertices [begin, end), adding them to bounds if not null
+    template <typename Matrix>
+    static void LinearBlendRange(const Matrix *palette,
+                                 const std::uint32_t *boneIndices,
+                                 const T *boneWeights,
+                                 std::size_t influencesPerVertex,
+                                 const Vector3G<T> *positions,
+                                 const Vector3G<T> *normals,
+                                 Vector3G<T> *positionsOut,
+                                 Vector3G<T> *normalsOut,
+                                 std::size_t begin,
+                                 std::size_t end,
+                                 AABoxG<T> *bounds);
+
+    // Columns of the palette matrices, the lanes past z being unused
+    static void LoadColumns(const Matrix4G<T> &m, SIMD4G<T> *columns);
+    static void LoadColumns(const Matrix3x4G<T> &m, SIMD4G<T> *columns);
+    static Vector3G<T> GetColumn(const Matrix4G<T> &m, std::size_t i);
+    static const Vector3G<T> &GetColumn(const Matrix3x4G<T> &m,
+                                        std::size_t i);
+};
+
+BANG_MATH_DEFINE_USINGS(Skinning)
+}
+
+#include "BangMath/Skinning.tcc"
@@ -0,0 +1,348 @@
+#include "BangMath/Skinning.h"
+
+#include <limits>
+#include <vector>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Matrix3x4.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Matrix4SIMD.h"
+#include "BangMath/Parallel.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr std::size_t SkinningG<T>::VerticesPerTile;
+
+template <typename T>
+void SkinningG<T>::LinearBlend(const Matrix4G<T> *palette,
+                               const std::uint32_t *boneIndices,
+                               const T *boneWeights,
+                               std::size_t influencesPerVertex,
+                               const Vector3G<T> *positions,
+                               const Vector3G<T> *normals,
+                               Vector3G<T> *positionsOut,
+                               Vector3G<T> *normalsOut,
+                               std::size_t count,
+                               AABoxG<T> *boundsOut,
+                               std::size_t numThreads)
+{
+    LinearBlendTiles(palette,
+                     boneIndices,
+                     boneWeights,
+                     influencesPerVertex,
+                     positions,
+                     normals,
+                     positionsOut,
+                     normalsOut,
+                     count,
+                     boundsOut,
+                     numThreads);
+}
+
+template <typename T>
+void SkinningG<T>::LinearBlend(const Matrix3x4G<T> *palette,
+                               const std::uint32_t *boneIndices,
+                               const T *boneWeights,
+                               std::size_t influencesPerVertex,
+                               const Vector3G<T> *positions,
+                               const Vector3G<T> *normals,
+                               Vector3G<T> *positionsOut,
+                               Vector3G<T> *normalsOut,
+                               std::size_t count,
+                               AABoxG<T> *boundsOut,
+                               std::size_t numThreads)
+{
+    LinearBlendTiles(palette,
+                     boneIndices,
+                     boneWeights,
+                     influencesPerVertex,
+                     positions,
+                     normals,
+                     positionsOut,
+                     normalsOut,
+                     count,
+                     boundsOut,
+                     numThreads);
+}
+
+template <typename T>
+template <typename Matrix>
+void SkinningG<T>::LinearBlendTiles(const Matrix *palette,
+                                    const std::uint32_t *boneIndices,
+                                    const T *boneWeights,
+                                    std::size_t influencesPerVertex,
+                                    const Vector3G<T> *positions,
+                                    const Vector3G<T> *normals,
+                                    Vector3G<T> *positionsOut,
+                                    Vector3G<T> *normalsOut,
+                                    std::size_t count,
+                                    AABoxG<T> *boundsOut,
+                                    std::size_t numThreads)
+{
+    const std::size_t numTiles =
+        (count + VerticesPerTile - 1) / VerticesPerTile;
+
+    // Bounds are kept per tile and merged at the end, so the result does not
+    // depend on which thread did what
+    std::vector<AABoxG<T>> tileBounds(boundsOut ? numTiles : 0);
+
+    Parallel::ForTiles(
+        count,
+        VerticesPerTile,
+        numThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            AABoxG<T> *bounds =
+                (boundsOut ? &tileBounds[begin / VerticesPerTile] : nullptr);
+            LinearBlendRange(palette,
+                             boneIndices,
+                             boneWeights,
+                             influencesPerVertex,
+                             positions,
+                             normals,
+                             positionsOut,
+                             normalsOut,
+                             begin,
+                             end,
+                             bounds);
+        });
+
+    if (boundsOut)
+    {
+        boundsOut->SetMin(Vector3G<T>::Infinity());
+        boundsOut->SetMax(Vector3G<T>::NInfinity());
+        for (const AABoxG<T> &bounds : tileBounds)
+        {
+            boundsOut->AddPoint(bounds.GetMin());
+            boundsOut->AddPoint(bounds.GetMax());
+        }
+    }
+}
+
+template <typename T>
+template <typename Matrix>
+void SkinningG<T>::LinearBlendRange(const Matrix *palette,
+                                    const std::uint32_t *boneIndices,
+                                    const T *boneWeights,
+                                    std::size_t influencesPerVertex,
+                                    const Vector3G<T> *positions,
+                                    const Vector3G<T> *normals,
+                                    Vector3G<T> *positionsOut,
+                                    Vector3G<T> *normalsOut,
+                                    std::size_t begin,
+                                    std::size_t end,
+                                    AABoxG<T> *bounds)
+{
+    const bool skinNormals = (normals && normalsOut);
+
+    std::size_t i = begin;
+    if (SIMD4G<T>::IsAccelerated)
+    {
+        const SIMD4G<T> zero(static_cast<T>(0));
+        const SIMD4G<T> one(static_cast<T>(1));
+        const SIMD4G<T> minSqLength(std::numeric_limits<T>::min());
+        const SIMD4G<T> identity[4] = {SIMD4G<T>(1, 0, 0, 0),
+                                       SIMD4G<T>(0, 1, 0, 0),
+                                       SIMD4G<T>(0, 0, 1, 0),
+                                       zero};
+        SIMD4G<T> minX(std::numeric_limits<T>::infinity());
+        SIMD4G<T> minY = minX, minZ = minX;
+        SIMD4G<T> maxX = -minX, maxY = -minX, maxZ = -minX;
+
+        for (; i + 4 <= end; i += 4)
+        {
+            // m[c][k]: column c of the blended matrix of vertex i + k, then
+            // after the transposes, row k of column c for the four vertices
+            SIMD4G<T> m[4][4];
+            bool anyUnweighted = false;
+            bool unweighted[4];
+            Vector3G<T> unweightedNormals[4];
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                const std::size_t first = (i + k) * influencesPerVertex;
+                m[0][k] = m[1][k] = m[2][k] = m[3][k] = zero;
+                unweighted[k] = true;
+                for (std::size_t j = 0; j < influencesPerVertex; ++j)
+                {
+                    const T weight = boneWeights[first + j];
+                    if (weight == static_cast<T>(0))
+                    {
+                        continue;
+                    }
+                    unweighted[k] = false;
+                    SIMD4G<T> columns[4];
+                    LoadColumns(palette[boneIndices[first + j]], columns);
+                    const SIMD4G<T> w(weight);
+                    m[0][k] = m[0][k] + (columns[0] * w);
+                    m[1][k] = m[1][k] + (columns[1] * w);
+                    m[2][k] = m[2][k] + (columns[2] * w);
+                    m[3][k] = m[3][k] + (columns[3] * w);
+                }
+
+                // Passed through by the identity. Their normals are kept
+                // aside, so that they are not normalized.
+                if (unweighted[k])
+                {
+                    anyUnweighted = true;
+                    m[0][k] = identity[0];
+                    m[1][k] = identity[1];
+                    m[2][k] = identity[2];
+                    m[3][k] = identity[3];
+                    if (skinNormals)
+                    {
+                        unweightedNormals[k] = normals[i + k];
+                    }
+                }
+            }
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                SIMD4G<T>::Transpose(m[c][0], m[c][1], m[c][2], m[c][3]);
+            }
+
+            SIMD4G<T> x, y, z;
+            Matrix4SIMD::LoadPacked3(&positions[i].x, &x, &y, &z);
+            const SIMD4G<T> px =
+                (m[0][0] * x) + (m[1][0] * y) + (m[2][0] * z) + m[3][0];
+            const SIMD4G<T> py =
+                (m[0][1] * x) + (m[1][1] * y) + (m[2][1] * z) + m[3][1];
+            const SIMD4G<T> pz =
+                (m[0][2] * x) + (m[1][2] * y) + (m[2][2] * z) + m[3][2];
+            Matrix4SIMD::StorePacked3(px, py, pz, &positionsOut[i].x);
+
+            if (bounds)
+            {
+                minX = SIMD4G<T>::Min(minX, px);
+                minY = SIMD4G<T>::Min(minY, py);
+                minZ = SIMD4G<T>::Min(minZ, pz);
+                maxX = SIMD4G<T>::Max(maxX, px);
+                maxY = SIMD4G<T>::Max(maxY, py);
+                maxZ = SIMD4G<T>::Max(maxZ, pz);
+            }
+
+            if (skinNormals)
+            {
+                Matrix4SIMD::LoadPacked3(&normals[i].x, &x, &y, &z);
+                SIMD4G<T> nx = (m[0][0] * x) + (m[1][0] * y) + (m[2][0] * z);
+                SIMD4G<T> ny = (m[0][1] * x) + (m[1][1] * y) + (m[2][1] * z);
+                SIMD4G<T> nz = (m[0][2] * x) + (m[1][2] * y) + (m[2][2] * z);
+
+                // Zero normals stay zero
+                const SIMD4G<T> invLength =
+                    one / SIMD4G<T>::Sqrt(SIMD4G<T>::Max(
+                              (nx * nx) + (ny * ny) + (nz * nz), minSqLength));
+                nx = nx * invLength;
+                ny = ny * invLength;
+                nz = nz * invLength;
+                Matrix4SIMD::StorePacked3(nx, ny, nz, &normalsOut[i].x);
+                for (std::size_t k = 0; anyUnweighted && k < 4; ++k)
+                {
+                    if (unweighted[k])
+                    {
+                        normalsOut[i + k] = unweightedNormals[k];
+                    }
+                }
+            }
+        }
+
+        if (bounds && i > begin)
+        {
+            T lanes[6][4];
+            minX.Store(lanes[0]);
+            minY.Store(lanes[1]);
+            minZ.Store(lanes[2]);
+            maxX.Store(lanes[3]);
+            maxY.Store(lanes[4]);
+            maxZ.Store(lanes[5]);
+            for (std::size_t k = 0; k < 4; ++k)
+            {
+                bounds->AddPoint(
+                    Vector3G<T>(lanes[0][k], lanes[1][k], lanes[2][k]));
+                bounds->AddPoint(
+                    Vector3G<T>(lanes[3][k], lanes[4][k], lanes[5][k]));
+            }
+        }
+    }
+
+    for (; i < end; ++i)
+    {
+        const std::size_t first = i * influencesPerVertex;
+        bool weighted = false;
+        Matrix3x4G<T> m(Vector3G<T>::Zero(),
+                        Vector3G<T>::Zero(),
+                        Vector3G<T>::Zero(),
+                        Vector3G<T>::Zero());
+        for (std::size_t j = 0; j < influencesPerVertex; ++j)
+        {
+            const T weight = boneWeights[first + j];
+            if (weight == static_cast<T>(0))
+            {
+                continue;
+            }
+            weighted = true;
+            const Matrix &bone = palette[boneIndices[first + j]];
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                m[c] += GetColumn(bone, c) * weight;
+            }
+        }
+
+        if (weighted)
+        {
+            positionsOut[i] = m.TransformedPoint(positions[i]);
+            if (skinNormals)
+            {
+                normalsOut[i] =
+                    m.TransformedVector(normals[i]).NormalizedSafe();
+            }
+        }
+        else
+        {
+            positionsOut[i] = positions[i];
+            if (skinNormals)
+            {
+                normalsOut[i] = normals[i];
+            }
+        }
+        if (bounds)
+        {
+            bounds->AddPoint(positionsOut[i]);
+        }
+    }
+}
+
+template <typename T>
+void SkinningG<T>::LoadColumns(const Matrix4G<T> &m, SIMD4G<T> *columns)
+{
+    columns[0] = SIMD4G<T>::Load(&m.c0.x);
+    columns[1] = SIMD4G<T>::Load(&m.c1.x);
+    columns[2] = SIMD4G<T>::Load(&m.c2.x);
+    columns[3] = SIMD4G<T>::Load(&m.c3.x);
+}
+
+template <typename T>
+void SkinningG<T>::LoadColumns(const Matrix3x4G<T> &m, SIMD4G<T> *columns)
+{
+    // Columns are three apart. The last one is loaded ending at the end of
+    // the matrix, and shifted down a lane.
+    const T *data = m.Data();
+    columns[0] = SIMD4G<T>::Load(data);
+    columns[1] = SIMD4G<T>::Load(data + 3);
+    columns[2] = SIMD4G<T>::Load(data + 6);
+    const SIMD4G<T> last = SIMD4G<T>::Load(data + 8);
+    columns[3] = SIMD4G<T>::template Shuffle<1, 2, 3, 3>(last, last);
+}
+
+template <typename T>
+Vector3G<T> SkinningG<T>::GetColumn(const Matrix4G<T> &m, std::size_t i)
+{
+    return m[i].xyz();
+}
+
+template <typename T>
+const Vector3G<T> &SkinningG<T>::GetColumn(const Matrix3x4G<T> &m,
+                                           std::size_t i)
+{
+    return m[i];
+}
+}
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Defines.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+// Hashed uniform grid for neighbour queries over points or boxes, e.g.
+// fixed radius searches in particle and crowd simulations. Space is split in
+// cubic cells of the given size, hashed into a table of buckets, so the grid
+// is unbounded and its memory only depends on the number of entries.
+//
+// Build() counting sorts the entries by bucket into flat arrays (the points
+// are copied in bucket order), which can be split across threads. Boxes are
+// referenced from every cell they overlap. Entries are reported by their
+// index in the built array, once each even when they span several cells or
+// their cells share a bucket.
+template <typename T>
+class SpatialGridG
+{
+public:
+    // tableSize: number of buckets, rounded up to a power of two. 0 chooses
+    // it on every Build from the number of entries.
+    explicit SpatialGridG(T cellSize = static_cast<T>(1),
+                          std::size_t tableSize = 0);
+
+    void SetCellSize(T cellSize);
+    void SetTableSize(std::size_t tableSize);
+
+    // numThreads: threads used for the build, the calling thread included.
+    // 0 uses as many as the hardware supports.
+    void Build(const std::vector<Vector3G<T>> &points,
+               std::size_t numThreads = 1);
+    void Build(const Vector3G<T> *points,
+               std::size_t count,
+               std::size_t numThreads = 1);
+    void Build(const std::vector<AABoxG<T>> &aaBoxes,
+               std::size_t numThreads = 1);
+    void Build(const AABoxG<T> *aaBoxes,
+               std::size_t count,
+               std::size_t numThreads = 1);
+    void Clear();
+
+    // Appends the entries closer than radius to center (the distance to a
+    // box is the distance to its closest point)
+    void QueryRadius(const Vector3G<T> &center,
+                     T radius,
+                     std::vector<std::size_t> *indicesOut) const;
+
+    // Calls visitor(index, sqDistance) for the entries closer than radius
+    template <class Visitor>
+    void VisitRadius(const Vector3G<T> &center,
+                     T radius,
+                     Visitor visitor) const;
+
+    void QueryOverlaps(const AABoxG<T> &aaBox,
+                       std::vector<std::size_t> *indicesOut) const;
+
+    // Calls visitor(index) for the entries overlapping the box
+    template <class Visitor>
+    void VisitOverlaps(const AABoxG<T> &aaBox, Visitor visitor) const;
+
+    // Appends the k entries closest to point, closest first. Searches cell
+    // rings around the point until no unvisited entry can be closer.
+    void QueryKNearest(const Vector3G<T> &point,
+                       std::size_t k,
+                       std::vector<std::size_t> *indicesOut) const;
+    void QueryKNearest(const Vector3G<T> &point,
+                       std::size_t k,
+                       T maxDistance,
+                       std::vector<std::size_t> *indicesOut) const;
+
+    T GetCellSize() const;
+    std::size_t GetTableSize() const;
+    std::size_t GetEntryCount() const;
+    bool IsEmpty() const;
+
+private:
+    using Cell = Vector3G<int>;
+
+    T m_cellSize;
+    T m_invCellSize;
+    std::size_t m_requestedTableSize;
+    std::uint32_t m_hashMask = 0;
+    std::size_t m_entryCount = 0;
+
+    // m_bucketStarts[b] to m_bucketStarts[b + 1] are the references of
+    // bucket b: entry indices, and positions for points
+    std::vector<std::uint32_t> m_bucketStarts;
+    std::vector<std::uint32_t> m_indices;
+    std::vector<Vector3G<T>> m_positions;
+    // Copy of the boxes when built from boxes, by entry index
+    std::vector<AABoxG<T>> m_aaBoxes;
+    // Cells spanned by all the entries
+    Cell m_minCell;
+    Cell m_maxCell;
+
+    // Reference of an entry to the bucket of one of its cells
+    struct BucketReference
+    {
+        std::uint32_t bucket;
+        std::uint32_t entry;
+    };
+
+    // Entries per thread below which the build does not use more threads
+    static constexpr std::size_t MinEntriesPerThread = 4096;
+
+    // getEntryCells(i, &minCell, &maxCell) gives the cells of entry i
+    template <class GetEntryCells>
+    void BuildBuckets(std::size_t count,
+                      std::size_t numThreads,
+                      const GetEntryCells &getEntryCells);
+    void PrepareTable(std::size_t count);
+
+    bool HasBoxes() const;
+    Cell GetCell(const Vector3G<T> &point) const;
+    std::uint32_t GetBucket(const Cell &cell) const;
+    // Cells of the entry of the given reference
+    void GetCellRange(std::size_t reference,
+                      Cell *minCellOut,
+                      Cell *maxCellOut) const;
+    T GetSqDistance(std::size_t reference, const Vector3G<T> &point) const;
+    bool Overlaps(std::size_t reference, const AABoxG<T> &aaBox) const;
+
+    // Calls function(reference) for the references of the cell that belong
+    // to the entries whose cell range contains it and whose cell closest to
+    // dedupCell is it, so each entry is seen from one cell only
+    template <class Function>
+    void ForEachReference(const Cell &cell,
+                          const Cell &dedupCell,
+                          Function function) const;
+
+    // Calls function(chunk) for chunk in [0, numChunks), spread over as
+    // many threads, the calling one included
+    template <class Function>
+    static void ForEachChunk(std::size_t numChunks, Function function);
+    static std::size_t GetChunkBegin(std::size_t count,
+                                     std::size_t numChunks,
+                                     std::size_t chunk);
+};
+
+BANG_MATH_DEFINE_USINGS(SpatialGrid)
+}
+
+#include "BangMath/SpatialGrid.tcc"
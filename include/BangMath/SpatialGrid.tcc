@@ -0,0 +1,550 @@
+#include "BangMath/SpatialGrid.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "BangMath/Math.h"
+#include "BangMath/Parallel.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr std::size_t SpatialGridG<T>::MinEntriesPerThread;
+
+template <typename T>
+SpatialGridG<T>::SpatialGridG(T cellSize, std::size_t tableSize)
+    : m_requestedTableSize(tableSize)
+{
+    SetCellSize(cellSize);
+}
+
+template <typename T>
+void SpatialGridG<T>::SetCellSize(T cellSize)
+{
+    m_cellSize = cellSize;
+    m_invCellSize = T(1) / cellSize;
+}
+
+template <typename T>
+void SpatialGridG<T>::SetTableSize(std::size_t tableSize)
+{
+    m_requestedTableSize = tableSize;
+}
+
+template <typename T>
+void SpatialGridG<T>::Build(const std::vector<Vector3G<T>> &points,
+                            std::size_t numThreads)
+{
+    Build(points.data(), points.size(), numThreads);
+}
+
+template <typename T>
+void SpatialGridG<T>::Build(const Vector3G<T> *points,
+                            std::size_t count,
+                            std::size_t numThreads)
+{
+    m_aaBoxes.clear();
+    BuildBuckets(count, numThreads, [&](std::size_t i, Cell *min, Cell *max) {
+        *min = *max = GetCell(points[i]);
+    });
+
+    // Copied in bucket order, so the queries read them sequentially
+    m_positions.resize(m_indices.size());
+    for (std::size_t i = 0; i < m_indices.size(); ++i)
+    {
+        m_positions[i] = points[m_indices[i]];
+    }
+}
+
+template <typename T>
+void SpatialGridG<T>::Build(const std::vector<AABoxG<T>> &aaBoxes,
+                            std::size_t numThreads)
+{
+    Build(aaBoxes.data(), aaBoxes.size(), numThreads);
+}
+
+template <typename T>
+void SpatialGridG<T>::Build(const AABoxG<T> *aaBoxes,
+                            std::size_t count,
+                            std::size_t numThreads)
+{
+    m_positions.clear();
+    m_aaBoxes.assign(aaBoxes, aaBoxes + count);
+    BuildBuckets(count, numThreads, [&](std::size_t i, Cell *min, Cell *max) {
+        *min = GetCell(aaBoxes[i].GetMin());
+        *max = GetCell(aaBoxes[i].GetMax());
+    });
+}
+
+template <typename T>
+void SpatialGridG<T>::Clear()
+{
+    m_entryCount = 0;
+    m_bucketStarts.clear();
+    m_indices.clear();
+    m_positions.clear();
+    m_aaBoxes.clear();
+}
+
+template <typename T>
+void SpatialGridG<T>::QueryRadius(const Vector3G<T> &center,
+                                  T radius,
+                                  std::vector<std::size_t> *indicesOut) const
+{
+    VisitRadius(center, radius, [indicesOut](std::size_t index, T) {
+        indicesOut->push_back(index);
+    });
+}
+
+template <typename T>
+template <class Visitor>
+void SpatialGridG<T>::VisitRadius(const Vector3G<T> &center,
+                                  T radius,
+                                  Visitor visitor) const
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    const Vector3G<T> extents(radius);
+    const Cell minCell = Cell::Max(GetCell(center - extents), m_minCell);
+    const Cell maxCell = Cell::Min(GetCell(center + extents), m_maxCell);
+    const T sqRadius = radius * radius;
+    for (int z = minCell.z; z <= maxCell.z; ++z)
+    {
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+        {
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+            {
+                ForEachReference(
+                    Cell(x, y, z), minCell, [&](std::size_t reference) {
+                        const T sqDistance = GetSqDistance(reference, center);
+                        if (sqDistance <= sqRadius)
+                        {
+                            visitor(static_cast<std::size_t>(
+                                        m_indices[reference]),
+                                    sqDistance);
+                        }
+                    });
+            }
+        }
+    }
+}
+
+template <typename T>
+void SpatialGridG<T>::QueryOverlaps(const AABoxG<T> &aaBox,
+                                    std::vector<std::size_t> *indicesOut) const
+{
+    VisitOverlaps(aaBox, [indicesOut](std::size_t index) {
+        indicesOut->push_back(index);
+    });
+}
+
+template <typename T>
+template <class Visitor>
+void SpatialGridG<T>::VisitOverlaps(const AABoxG<T> &aaBox,
+                                    Visitor visitor) const
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    const Cell minCell = Cell::Max(GetCell(aaBox.GetMin()), m_minCell);
+    const Cell maxCell = Cell::Min(GetCell(aaBox.GetMax()), m_maxCell);
+    for (int z = minCell.z; z <= maxCell.z; ++z)
+    {
+        for (int y = minCell.y; y <= maxCell.y; ++y)
+        {
+            for (int x = minCell.x; x <= maxCell.x; ++x)
+            {
+                ForEachReference(
+                    Cell(x, y, z), minCell, [&](std::size_t reference) {
+                        if (Overlaps(reference, aaBox))
+                        {
+                            visitor(static_cast<std::size_t>(
+                                m_indices[reference]));
+                        }
+                    });
+            }
+        }
+    }
+}
+
+template <typename T>
+void SpatialGridG<T>::QueryKNearest(const Vector3G<T> &point,
+                                    std::size_t k,
+                                    std::vector<std::size_t> *indicesOut) const
+{
+    QueryKNearest(point, k, Math::Infinity<T>(), indicesOut);
+}
+
+// Visits the cells in rings of growing Chebyshev distance around the cell of
+// the point. Entries not visited after ring r are outside the cube of rings
+// [0, r], so farther than r cells from the point: once the k-th closest
+// entry is nearer than that, it can not change.
+template <typename T>
+void SpatialGridG<T>::QueryKNearest(const Vector3G<T> &point,
+                                    std::size_t k,
+                                    T maxDistance,
+                                    std::vector<std::size_t> *indicesOut) const
+{
+    if (IsEmpty() || k == 0)
+    {
+        return;
+    }
+
+    // Max heap of the closest entries found
+    std::vector<std::pair<T, std::size_t>> closest;
+    closest.reserve(k);
+    const T sqMaxDistance = maxDistance * maxDistance;
+    const auto visitReference = [&](std::size_t reference) {
+        const T sqDistance = GetSqDistance(reference, point);
+        if (sqDistance > sqMaxDistance)
+        {
+            return;
+        }
+        const std::size_t index = m_indices[reference];
+        if (closest.size() < k)
+        {
+            closest.emplace_back(sqDistance, index);
+            std::push_heap(closest.begin(), closest.end());
+        }
+        else if (sqDistance < closest.front().first)
+        {
+            std::pop_heap(closest.begin(), closest.end());
+            closest.back() = std::make_pair(sqDistance, index);
+            std::push_heap(closest.begin(), closest.end());
+        }
+    };
+
+    // Rings closer than the cells of the entries are empty
+    const Cell center = GetCell(point);
+    int firstRing = 0;
+    for (int i = 0; i < 3; ++i)
+    {
+        firstRing = Math::Max(firstRing, m_minCell[i] - center[i]);
+        firstRing = Math::Max(firstRing, center[i] - m_maxCell[i]);
+    }
+
+    for (int ring = firstRing;; ++ring)
+    {
+        const Cell ringMin = Cell::Max(center - Cell(ring), m_minCell);
+        const Cell ringMax = Cell::Min(center + Cell(ring), m_maxCell);
+        for (int z = ringMin.z; z <= ringMax.z; ++z)
+        {
+            for (int y = ringMin.y; y <= ringMax.y; ++y)
+            {
+                // Inside the ring only the cells at its x ends are new
+                const bool onRingFace = (Math::Abs(z - center.z) == ring ||
+                                         Math::Abs(y - center.y) == ring);
+                const int xStep = (onRingFace ? 1 : Math::Max(2 * ring, 1));
+                for (int x = center.x - ring; x <= center.x + ring;
+                     x += xStep)
+                {
+                    if (x >= ringMin.x && x <= ringMax.x)
+                    {
+                        ForEachReference(
+                            Cell(x, y, z), center, visitReference);
+                    }
+                }
+            }
+        }
+
+        const T searchedDistance = static_cast<T>(ring) * m_cellSize;
+        if (closest.size() == k &&
+            closest.front().first <= searchedDistance * searchedDistance)
+        {
+            break;
+        }
+        if (searchedDistance >= maxDistance ||
+            (ringMin == m_minCell && ringMax == m_maxCell))
+        {
+            break;
+        }
+    }
+
+    std::sort_heap(closest.begin(), closest.end());
+    for (const auto &entry : closest)
+    {
+        indicesOut->push_back(entry.second);
+    }
+}
+
+template <typename T>
+T SpatialGridG<T>::GetCellSize() const
+{
+    return m_cellSize;
+}
+
+template <typename T>
+std::size_t SpatialGridG<T>::GetTableSize() const
+{
+    return (m_bucketStarts.empty() ? 0 : m_bucketStarts.size() - 1);
+}
+
+template <typename T>
+std::size_t SpatialGridG<T>::GetEntryCount() const
+{
+    return m_entryCount;
+}
+
+template <typename T>
+bool SpatialGridG<T>::IsEmpty() const
+{
+    return (m_entryCount == 0);
+}
+
+// Counting sort of the references by bucket. Each thread lists the
+// references of its chunk of entries, and then counts and writes the ones
+// of its range of buckets, reading the chunks in order so that the result
+// does not depend on the number of threads. The memory used is bounded by
+// the number of references, instead of a table of counts per thread.
+template <typename T>
+template <class GetEntryCells>
+void SpatialGridG<T>::BuildBuckets(std::size_t count,
+                                   std::size_t numThreads,
+                                   const GetEntryCells &getEntryCells)
+{
+    m_entryCount = count;
+    PrepareTable(count);
+    const std::size_t tableSize = m_hashMask + std::size_t(1);
+
+    // A chunk of entries and a range of buckets per thread
+    const std::size_t numChunks = Parallel::GetThreadCount(
+        numThreads, count / std::size_t(MinEntriesPerThread));
+
+    std::vector<std::vector<BucketReference>> chunkReferences(numChunks);
+    std::vector<Cell> chunkMinCells(numChunks, Cell(0));
+    std::vector<Cell> chunkMaxCells(numChunks, Cell(0));
+    ForEachChunk(numChunks, [&](std::size_t chunk) {
+        std::vector<BucketReference> &references = chunkReferences[chunk];
+        const std::size_t begin = GetChunkBegin(count, numChunks, chunk);
+        const std::size_t end = GetChunkBegin(count, numChunks, chunk + 1);
+        references.reserve(end - begin);
+        Cell chunkMin(0), chunkMax(0);
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            Cell min, max;
+            getEntryCells(i, &min, &max);
+            chunkMin = (i == begin ? min : Cell::Min(chunkMin, min));
+            chunkMax = (i == begin ? max : Cell::Max(chunkMax, max));
+            for (int z = min.z; z <= max.z; ++z)
+            {
+                for (int y = min.y; y <= max.y; ++y)
+                {
+                    for (int x = min.x; x <= max.x; ++x)
+                    {
+                        const BucketReference reference = {
+                            GetBucket(Cell(x, y, z)),
+                            static_cast<std::uint32_t>(i)};
+                        references.push_back(reference);
+                    }
+                }
+            }
+        }
+        chunkMinCells[chunk] = chunkMin;
+        chunkMaxCells[chunk] = chunkMax;
+    });
+
+    // Counts of bucket b go to m_bucketStarts[b + 1], so that turned into
+    // write offsets they end up as the bucket ends, which are the starts of
+    // the next buckets
+    m_bucketStarts.assign(tableSize + 1, 0);
+    std::vector<std::uint32_t> rangeOffsets(numChunks + 1, 0);
+    ForEachChunk(numChunks, [&](std::size_t chunk) {
+        const std::uint32_t bucketBegin = static_cast<std::uint32_t>(
+            GetChunkBegin(tableSize, numChunks, chunk));
+        const std::uint32_t numBuckets = static_cast<std::uint32_t>(
+            GetChunkBegin(tableSize, numChunks, chunk + 1) - bucketBegin);
+        std::uint32_t rangeCount = 0;
+        for (const std::vector<BucketReference> &references : chunkReferences)
+        {
+            for (const BucketReference &reference : references)
+            {
+                if (reference.bucket - bucketBegin < numBuckets)
+                {
+                    ++m_bucketStarts[reference.bucket + 1];
+                    ++rangeCount;
+                }
+            }
+        }
+        rangeOffsets[chunk + 1] = rangeCount;
+    });
+    for (std::size_t chunk = 0; chunk < numChunks; ++chunk)
+    {
+        rangeOffsets[chunk + 1] += rangeOffsets[chunk];
+    }
+
+    m_indices.resize(rangeOffsets[numChunks]);
+    ForEachChunk(numChunks, [&](std::size_t chunk) {
+        const std::uint32_t bucketBegin = static_cast<std::uint32_t>(
+            GetChunkBegin(tableSize, numChunks, chunk));
+        const std::uint32_t numBuckets = static_cast<std::uint32_t>(
+            GetChunkBegin(tableSize, numChunks, chunk + 1) - bucketBegin);
+        std::uint32_t offset = rangeOffsets[chunk];
+        for (std::uint32_t bucket = bucketBegin;
+             bucket < bucketBegin + numBuckets;
+             ++bucket)
+        {
+            const std::uint32_t bucketCount = m_bucketStarts[bucket + 1];
+            m_bucketStarts[bucket + 1] = offset;
+            offset += bucketCount;
+        }
+
+        for (const std::vector<BucketReference> &references : chunkReferences)
+        {
+            for (const BucketReference &reference : references)
+            {
+                if (reference.bucket - bucketBegin < numBuckets)
+                {
+                    m_indices[m_bucketStarts[reference.bucket + 1]++] =
+                        reference.entry;
+                }
+            }
+        }
+    });
+
+    // Every chunk has entries when there are any
+    for (std::size_t chunk = 0; chunk < numChunks && count > 0; ++chunk)
+    {
+        const Cell &minCell = chunkMinCells[chunk];
+        const Cell &maxCell = chunkMaxCells[chunk];
+        m_minCell = (chunk == 0 ? minCell : Cell::Min(m_minCell, minCell));
+        m_maxCell = (chunk == 0 ? maxCell : Cell::Max(m_maxCell, maxCell));
+    }
+}
+
+// About two buckets per entry by default
+template <typename T>
+void SpatialGridG<T>::PrepareTable(std::size_t count)
+{
+    std::size_t tableSize =
+        (m_requestedTableSize > 0 ? m_requestedTableSize : 2 * count);
+    std::size_t powerOfTwo = 16;
+    while (powerOfTwo < tableSize)
+    {
+        powerOfTwo *= 2;
+    }
+    m_hashMask = static_cast<std::uint32_t>(powerOfTwo - 1);
+}
+
+template <typename T>
+bool SpatialGridG<T>::HasBoxes() const
+{
+    return !m_aaBoxes.empty();
+}
+
+template <typename T>
+typename SpatialGridG<T>::Cell SpatialGridG<T>::GetCell(
+    const Vector3G<T> &point) const
+{
+    return Cell(static_cast<int>(Math::Floor(point.x * m_invCellSize)),
+                static_cast<int>(Math::Floor(point.y * m_invCellSize)),
+                static_cast<int>(Math::Floor(point.z * m_invCellSize)));
+}
+
+// Teschner et al. spatial hash, with unsigned arithmetic to wrap around
+template <typename T>
+std::uint32_t SpatialGridG<T>::GetBucket(const Cell &cell) const
+{
+    const std::uint32_t hash =
+        (static_cast<std::uint32_t>(cell.x) * 73856093u) ^
+        (static_cast<std::uint32_t>(cell.y) * 19349663u) ^
+        (static_cast<std::uint32_t>(cell.z) * 83492791u);
+    return (hash & m_hashMask);
+}
+
+template <typename T>
+void SpatialGridG<T>::GetCellRange(std::size_t reference,
+                                   Cell *minCellOut,
+                                   Cell *maxCellOut) const
+{
+    if (HasBoxes())
+    {
+        const AABoxG<T> &aaBox = m_aaBoxes[m_indices[reference]];
+        *minCellOut = GetCell(aaBox.GetMin());
+        *maxCellOut = GetCell(aaBox.GetMax());
+    }
+    else
+    {
+        *minCellOut = *maxCellOut = GetCell(m_positions[reference]);
+    }
+}
+
+template <typename T>
+T SpatialGridG<T>::GetSqDistance(std::size_t reference,
+                                 const Vector3G<T> &point) const
+{
+    if (HasBoxes())
+    {
+        const AABoxG<T> &aaBox = m_aaBoxes[m_indices[reference]];
+        return Vector3G<T>::SqDistance(aaBox.GetClosestPointInAABB(point),
+                                       point);
+    }
+    return Vector3G<T>::SqDistance(m_positions[reference], point);
+}
+
+template <typename T>
+bool SpatialGridG<T>::Overlaps(std::size_t reference,
+                               const AABoxG<T> &aaBox) const
+{
+    if (HasBoxes())
+    {
+        return m_aaBoxes[m_indices[reference]].Overlap(aaBox);
+    }
+    return aaBox.Contains(m_positions[reference]);
+}
+
+// Other cells may share the bucket, and an entry spanning several cells of
+// the query is referenced from all of them (and more than once from a bucket
+// if several of its cells share it). Only the reference from the cell
+// of the entry closest to dedupCell passes, which is always visited when
+// dedupCell is the min corner of the query cells (or the ring center).
+template <typename T>
+template <class Function>
+void SpatialGridG<T>::ForEachReference(const Cell &cell,
+                                       const Cell &dedupCell,
+                                       Function function) const
+{
+    const std::uint32_t bucket = GetBucket(cell);
+    const std::uint32_t begin = m_bucketStarts[bucket];
+    const std::uint32_t end = m_bucketStarts[bucket + 1];
+    for (std::uint32_t reference = begin; reference < end; ++reference)
+    {
+        // Cells of a box sharing a bucket give consecutive references
+        if (HasBoxes() && reference > begin &&
+            m_indices[reference] == m_indices[reference - 1])
+        {
+            continue;
+        }
+
+        Cell minCell, maxCell;
+        GetCellRange(reference, &minCell, &maxCell);
+        if (Cell::Clamp(dedupCell, minCell, maxCell) == cell)
+        {
+            function(reference);
+        }
+    }
+}
+
+template <typename T>
+template <class Function>
+void SpatialGridG<T>::ForEachChunk(std::size_t numChunks, Function function)
+{
+    Parallel::ForTiles(
+        numChunks,
+        1,
+        numChunks,
+        [&](std::size_t chunk, std::size_t, std::size_t) { function(chunk); });
+}
+
+template <typename T>
+std::size_t SpatialGridG<T>::GetChunkBegin(std::size_t count,
+                                           std::size_t numChunks,
+                                           std::size_t chunk)
+{
+    return count * chunk / numChunks;
+}
+}
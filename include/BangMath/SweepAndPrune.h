@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "BangMath/AABox.h"
+#include "BangMath/Defines.h"
+
+namespace Bang
+{
+// Sort based broad phase over a set of boxes, better than a tree when most
+// objects barely move. The boxes are kept sorted by their min along one
+// axis (the one where the box centers spread the most), so overlapping
+// pairs are found by sweeping forward from each box until the boxes start
+// after its max.
+//
+// Sorting uses the order of the previous update (temporal coherence): an
+// insertion sort over the nearly sorted entries, falling back to a radix
+// sort when many objects were added, the axis changed or the order was
+// shuffled too much. The sweep can be split across threads.
+//
+// Each update reports which pairs started and stopped overlapping since the
+// previous one instead of the full set. Handles of removed objects are not
+// reused until the next update, so their pairs are reported as removed.
+template <typename T>
+class SweepAndPruneG
+{
+public:
+    using Handle = std::int32_t;
+    using Pair = std::pair<Handle, Handle>;
+    static constexpr Handle NullHandle = -1;
+
+    Handle Add(const AABoxG<T> &aaBox);
+    void Remove(Handle handle);
+    void SetAABox(Handle handle, const AABoxG<T> &aaBox);
+    // Removes all the objects and pairs, without reporting them
+    void Clear();
+
+    // Finds the overlapping pairs, each one as (smaller handle, greater
+    // handle), and appends the ones not overlapping in the previous update to
+    // addedPairsOut and the ones that stopped overlapping to removedPairsOut
+    // (any of them can be null).
+    // numThreads: threads used for the sweep, the calling thread included.
+    // 0 uses as many as the hardware supports.
+    void UpdatePairs(std::vector<Pair> *addedPairsOut,
+                     std::vector<Pair> *removedPairsOut,
+                     std::size_t numThreads = 1);
+
+    // Pairs found in the last update, sorted
+    const std::vector<Pair> &GetPairs() const;
+    const AABoxG<T> &GetAABox(Handle handle) const;
+    std::size_t GetObjectCount() const;
+    int GetSweepAxis() const;
+
+private:
+    // Sorted element of the sweep, with everything the sweep needs in place
+    struct Entry
+    {
+        T min;
+        T max;
+        // The other two axes
+        T otherMins[2];
+        T otherMaxs[2];
+        Handle handle;
+    };
+
+    // Entries swept by each thread at a time
+    static constexpr std::size_t EntriesPerTile = 1024;
+
+    std::vector<AABoxG<T>> m_aaBoxes;
+    std::vector<bool> m_alive;
+    std::vector<Handle> m_freeHandles;
+    std::vector<Handle> m_pendingFreeHandles;
+    std::vector<Handle> m_addedHandles;
+    std::size_t m_objectCount = 0;
+
+    // Handles in the order of the last update
+    std::vector<Handle> m_order;
+    std::vector<Entry> m_entries;
+    std::vector<Entry> m_sortBuffer;
+    std::vector<std::uint64_t> m_sortKeys;
+    std::vector<std::uint64_t> m_sortKeyBuffer;
+    std::vector<Pair> m_pairs;
+    std::vector<Pair> m_newPairs;
+    std::vector<std::vector<Pair>> m_threadPairs;
+    int m_sweepAxis = 0;
+
+    int ComputeSweepAxis() const;
+    void GatherEntries(int axis);
+    void SetEntry(Handle handle, int axis, Entry *entry) const;
+    // Returns false (leaving the entries partially sorted) if it takes
+    // more than maxShifts moves
+    bool InsertionSortEntries(std::size_t maxShifts);
+    void RadixSortEntries();
+    void FindPairs(std::size_t numThreads);
+    void SweepRange(std::size_t begin,
+                    std::size_t end,
+                    std::vector<Pair> *pairsOut) const;
+
+    // Keys whose unsigned order is the order of the values
+    static std::uint64_t GetSortKey(T value);
+    static std::uint64_t GetSortKey(T value, std::true_type isFloatingPoint);
+    static std::uint64_t GetSortKey(T value, std::false_type isFloatingPoint);
+};
+
+BANG_MATH_DEFINE_USINGS(SweepAndPrune)
+}
+
+#include "BangMath/SweepAndPrune.tcc"
@@ -0,0 +1,387 @@
+#include "BangMath/SweepAndPrune.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include "BangMath/Math.h"
+#include "BangMath/Parallel.h"
+#include "BangMath/Vector3.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr typename SweepAndPruneG<T>::Handle SweepAndPruneG<T>::NullHandle;
+
+template <typename T>
+constexpr std::size_t SweepAndPruneG<T>::EntriesPerTile;
+
+template <typename T>
+typename SweepAndPruneG<T>::Handle SweepAndPruneG<T>::Add(
+    const AABoxG<T> &aaBox)
+{
+    Handle handle;
+    if (m_freeHandles.empty())
+    {
+        handle = static_cast<Handle>(m_aaBoxes.size());
+        m_aaBoxes.push_back(aaBox);
+        m_alive.push_back(true);
+    }
+    else
+    {
+        handle = m_freeHandles.back();
+        m_freeHandles.pop_back();
+        m_aaBoxes[handle] = aaBox;
+        m_alive[handle] = true;
+    }
+    m_addedHandles.push_back(handle);
+    ++m_objectCount;
+    return handle;
+}
+
+template <typename T>
+void SweepAndPruneG<T>::Remove(Handle handle)
+{
+    m_alive[handle] = false;
+    m_pendingFreeHandles.push_back(handle);
+    --m_objectCount;
+}
+
+template <typename T>
+void SweepAndPruneG<T>::SetAABox(Handle handle, const AABoxG<T> &aaBox)
+{
+    m_aaBoxes[handle] = aaBox;
+}
+
+template <typename T>
+void SweepAndPruneG<T>::Clear()
+{
+    m_aaBoxes.clear();
+    m_alive.clear();
+    m_freeHandles.clear();
+    m_pendingFreeHandles.clear();
+    m_addedHandles.clear();
+    m_order.clear();
+    m_entries.clear();
+    m_pairs.clear();
+    m_objectCount = 0;
+}
+
+template <typename T>
+void SweepAndPruneG<T>::UpdatePairs(std::vector<Pair> *addedPairsOut,
+                                    std::vector<Pair> *removedPairsOut,
+                                    std::size_t numThreads)
+{
+    const int sweepAxis = ComputeSweepAxis();
+    const bool axisChanged = (sweepAxis != m_sweepAxis);
+    m_sweepAxis = sweepAxis;
+
+    // Coherent updates only move a few entries a few places. Anything much
+    // worse than that is sorted from scratch.
+    GatherEntries(sweepAxis);
+    const std::size_t maxShifts = 4 * m_entries.size() + 64;
+    if (axisChanged || !InsertionSortEntries(maxShifts))
+    {
+        RadixSortEntries();
+    }
+
+    m_order.resize(m_entries.size());
+    for (std::size_t i = 0; i < m_entries.size(); ++i)
+    {
+        m_order[i] = m_entries[i].handle;
+    }
+
+    FindPairs(numThreads);
+    std::sort(m_newPairs.begin(), m_newPairs.end());
+
+    if (addedPairsOut)
+    {
+        std::set_difference(m_newPairs.begin(),
+                            m_newPairs.end(),
+                            m_pairs.begin(),
+                            m_pairs.end(),
+                            std::back_inserter(*addedPairsOut));
+    }
+    if (removedPairsOut)
+    {
+        std::set_difference(m_pairs.begin(),
+                            m_pairs.end(),
+                            m_newPairs.begin(),
+                            m_newPairs.end(),
+                            std::back_inserter(*removedPairsOut));
+    }
+    m_pairs.swap(m_newPairs);
+
+    // The pairs of the removed objects are already reported
+    m_freeHandles.insert(m_freeHandles.end(),
+                         m_pendingFreeHandles.begin(),
+                         m_pendingFreeHandles.end());
+    m_pendingFreeHandles.clear();
+}
+
+template <typename T>
+const std::vector<typename SweepAndPruneG<T>::Pair>
+    &SweepAndPruneG<T>::GetPairs() const
+{
+    return m_pairs;
+}
+
+template <typename T>
+const AABoxG<T> &SweepAndPruneG<T>::GetAABox(Handle handle) const
+{
+    return m_aaBoxes[handle];
+}
+
+template <typename T>
+std::size_t SweepAndPruneG<T>::GetObjectCount() const
+{
+    return m_objectCount;
+}
+
+template <typename T>
+int SweepAndPruneG<T>::GetSweepAxis() const
+{
+    return m_sweepAxis;
+}
+
+// Axis with the largest variance of the box centers, so that the fewest
+// boxes overlap along it. Only changes when another axis is clearly better,
+// since changing it requires a full sort.
+template <typename T>
+int SweepAndPruneG<T>::ComputeSweepAxis() const
+{
+    if (m_objectCount == 0)
+    {
+        return m_sweepAxis;
+    }
+
+    Vector3G<T> sum = Vector3G<T>::Zero();
+    Vector3G<T> sqSum = Vector3G<T>::Zero();
+    for (std::size_t i = 0; i < m_aaBoxes.size(); ++i)
+    {
+        if (m_alive[i])
+        {
+            const Vector3G<T> center = m_aaBoxes[i].GetCenter();
+            sum += center;
+            sqSum += center * center;
+        }
+    }
+
+    const T count = static_cast<T>(m_objectCount);
+    const Vector3G<T> variance = sqSum / count - (sum * sum) / (count * count);
+    int bestAxis = m_sweepAxis;
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        if (variance[axis] > variance[bestAxis] * static_cast<T>(1.25))
+        {
+            bestAxis = axis;
+        }
+    }
+    return bestAxis;
+}
+
+// Previous order first, then the added objects at the end
+template <typename T>
+void SweepAndPruneG<T>::GatherEntries(int axis)
+{
+    m_entries.clear();
+    m_entries.reserve(m_objectCount);
+    for (const Handle handle : m_order)
+    {
+        if (m_alive[handle])
+        {
+            m_entries.emplace_back();
+            SetEntry(handle, axis, &m_entries.back());
+        }
+    }
+    for (const Handle handle : m_addedHandles)
+    {
+        if (m_alive[handle])
+        {
+            m_entries.emplace_back();
+            SetEntry(handle, axis, &m_entries.back());
+        }
+    }
+    m_addedHandles.clear();
+}
+
+template <typename T>
+void SweepAndPruneG<T>::SetEntry(Handle handle, int axis, Entry *entry) const
+{
+    const auto &bMin = m_aaBoxes[handle].GetMin();
+    const auto &bMax = m_aaBoxes[handle].GetMax();
+    const int otherAxis0 = (axis + 1) % 3;
+    const int otherAxis1 = (axis + 2) % 3;
+    entry->min = bMin[axis];
+    entry->max = bMax[axis];
+    entry->otherMins[0] = bMin[otherAxis0];
+    entry->otherMins[1] = bMin[otherAxis1];
+    entry->otherMaxs[0] = bMax[otherAxis0];
+    entry->otherMaxs[1] = bMax[otherAxis1];
+    entry->handle = handle;
+}
+
+template <typename T>
+bool SweepAndPruneG<T>::InsertionSortEntries(std::size_t maxShifts)
+{
+    std::size_t shifts = 0;
+    for (std::size_t i = 1; i < m_entries.size(); ++i)
+    {
+        const Entry entry = m_entries[i];
+        std::size_t j = i;
+        while (j > 0 && entry.min < m_entries[j - 1].min)
+        {
+            m_entries[j] = m_entries[j - 1];
+            --j;
+            if (++shifts > maxShifts)
+            {
+                m_entries[j] = entry;
+                return false;
+            }
+        }
+        m_entries[j] = entry;
+    }
+    return true;
+}
+
+// LSD radix sort by bytes, skipping the bytes shared by all the keys
+template <typename T>
+void SweepAndPruneG<T>::RadixSortEntries()
+{
+    constexpr int NumPasses = 8;
+    const std::size_t numEntries = m_entries.size();
+    m_sortKeys.resize(numEntries);
+    m_sortKeyBuffer.resize(numEntries);
+    m_sortBuffer.resize(numEntries);
+
+    std::size_t counts[NumPasses][256] = {};
+    for (std::size_t i = 0; i < numEntries; ++i)
+    {
+        const std::uint64_t key = GetSortKey(m_entries[i].min);
+        m_sortKeys[i] = key;
+        for (int pass = 0; pass < NumPasses; ++pass)
+        {
+            ++counts[pass][(key >> (8 * pass)) & 0xFF];
+        }
+    }
+
+    for (int pass = 0; pass < NumPasses; ++pass)
+    {
+        const int shift = 8 * pass;
+        std::size_t *passCounts = counts[pass];
+        if (numEntries == 0 ||
+            passCounts[(m_sortKeys[0] >> shift) & 0xFF] == numEntries)
+        {
+            continue;
+        }
+
+        std::size_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit)
+        {
+            const std::size_t count = passCounts[digit];
+            passCounts[digit] = offset;
+            offset += count;
+        }
+        for (std::size_t i = 0; i < numEntries; ++i)
+        {
+            const std::uint64_t key = m_sortKeys[i];
+            const std::size_t dst = passCounts[(key >> shift) & 0xFF]++;
+            m_sortKeyBuffer[dst] = key;
+            m_sortBuffer[dst] = m_entries[i];
+        }
+        m_sortKeys.swap(m_sortKeyBuffer);
+        m_entries.swap(m_sortBuffer);
+    }
+}
+
+// Each thread sweeps tiles of entries, into its own pairs. A sweep from an
+// entry may go past the end of its tile, so every pair is found once, from
+// the entry that comes first.
+template <typename T>
+void SweepAndPruneG<T>::FindPairs(std::size_t numThreads)
+{
+    const std::size_t numEntries = m_entries.size();
+    const std::size_t numTiles =
+        (numEntries + EntriesPerTile - 1) / EntriesPerTile;
+    numThreads = Parallel::GetThreadCount(numThreads, numTiles);
+
+    m_newPairs.clear();
+    if (numThreads <= 1)
+    {
+        SweepRange(0, numEntries, &m_newPairs);
+        return;
+    }
+
+    m_threadPairs.resize(numThreads);
+    for (std::vector<Pair> &threadPairs : m_threadPairs)
+    {
+        threadPairs.clear();
+    }
+    Parallel::ForTiles(
+        numEntries,
+        EntriesPerTile,
+        numThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t thread) {
+            SweepRange(begin, end, &m_threadPairs[thread]);
+        });
+
+    for (const std::vector<Pair> &threadPairs : m_threadPairs)
+    {
+        m_newPairs.insert(
+            m_newPairs.end(), threadPairs.begin(), threadPairs.end());
+    }
+}
+
+template <typename T>
+void SweepAndPruneG<T>::SweepRange(std::size_t begin,
+                                   std::size_t end,
+                                   std::vector<Pair> *pairsOut) const
+{
+    const std::size_t numEntries = m_entries.size();
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const Entry &entry = m_entries[i];
+        for (std::size_t j = i + 1;
+             j < numEntries && m_entries[j].min <= entry.max;
+             ++j)
+        {
+            const Entry &other = m_entries[j];
+            if (other.otherMins[0] <= entry.otherMaxs[0] &&
+                other.otherMaxs[0] >= entry.otherMins[0] &&
+                other.otherMins[1] <= entry.otherMaxs[1] &&
+                other.otherMaxs[1] >= entry.otherMins[1])
+            {
+                pairsOut->emplace_back(Math::Min(entry.handle, other.handle),
+                                       Math::Max(entry.handle, other.handle));
+            }
+        }
+    }
+}
+
+template <typename T>
+std::uint64_t SweepAndPruneG<T>::GetSortKey(T value)
+{
+    return GetSortKey(value, std::is_floating_point<T>());
+}
+
+// Positive floats already sort as their bits. Setting the sign bit puts them
+// after the negative ones, whose bits are flipped to reverse their order.
+template <typename T>
+std::uint64_t SweepAndPruneG<T>::GetSortKey(T value, std::true_type)
+{
+    using Bits = typename std::
+        conditional<sizeof(T) == 4, std::uint32_t, std::uint64_t>::type;
+    Bits bits;
+    std::memcpy(&bits, &value, sizeof(Bits));
+    const Bits signBit = Bits(1) << (8 * sizeof(Bits) - 1);
+    return ((bits & signBit) ? ~bits : (bits | signBit));
+}
+
+template <typename T>
+std::uint64_t SweepAndPruneG<T>::GetSortKey(T value, std::false_type)
+{
+    const auto bits =
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(value));
+    return (bits ^ (std::uint64_t(1) << 63));
+}
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "BangMath/Defines.h"
+#include "BangMath/Matrix4.h"
+#include "BangMath/Transformation.h"
+
+namespace Bang
+{
+// Parent-child hierarchy of transformations, stored in flat arrays where
+// every node comes after its parent. The local and world matrices of every
+// node are cached, and changing a local transformation only flags the node.
+// Update then walks the arrays once: a node is recomputed if it was flagged
+// or its parent was recomputed, so only the changed subtrees are touched.
+//
+// World matrices are products of the local matrices, so unlike Composed
+// they keep the shear of non uniform scales under rotations.
+//
+// Update can split the pass in tiles of consecutive nodes for several
+// threads. A node whose parent is in a tile still being processed waits for
+// it, so hierarchies added breadth first (or many small ones) scale best.
+template <typename T>
+class TransformHierarchyG
+{
+public:
+    static constexpr std::size_t NullIndex =
+        std::numeric_limits<std::size_t>::max();
+
+    TransformHierarchyG() = default;
+
+    // Adds a node and returns its index, increasing from 0. The parent must
+    // already be in the hierarchy, or be NullIndex for a root.
+    std::size_t Add(const TransformationG<T> &localTransformation,
+                    std::size_t parent = NullIndex);
+    void Reserve(std::size_t count);
+    void Clear();
+
+    void SetLocalTransformation(std::size_t node,
+                                const TransformationG<T> &transformation);
+    void SetLocalPosition(std::size_t node, const Vector3G<T> &position);
+    void SetLocalRotation(std::size_t node, const QuaternionG<T> &rotation);
+    void SetLocalScale(std::size_t node, const Vector3G<T> &scale);
+
+    // Recomputes the matrices of the flagged nodes and their descendants.
+    // numThreads 0 uses as many threads as the hardware supports.
+    void Update(std::size_t numThreads = 1);
+
+    // Matrices as of the last Update
+    const Matrix4G<T> &GetLocalMatrix(std::size_t node) const;
+    const Matrix4G<T> &GetWorldMatrix(std::size_t node) const;
+    const Matrix4G<T> &GetWorldMatrixInverse(std::size_t node) const;
+    // All the world matrices, in node order
+    const Matrix4G<T> *GetWorldMatrices() const;
+
+    // Whether the world matrix of the node changed in the last Update
+    bool HasChanged(std::size_t node) const;
+    // Whether some node has been changed since the last Update
+    bool IsDirty() const;
+
+    const TransformationG<T> &GetLocalTransformation(std::size_t node) const;
+    std::size_t GetParent(std::size_t node) const;
+    std::size_t GetSize() const;
+
+private:
+    static constexpr std::size_t NodesPerTile = 256;
+
+    std::vector<std::size_t> m_parents;
+    std::vector<TransformationG<T>> m_localTransformations;
+    std::vector<Matrix4G<T>> m_localMatrices;
+    std::vector<Matrix4G<T>> m_localMatricesInverse;
+    std::vector<Matrix4G<T>> m_worldMatrices;
+    std::vector<Matrix4G<T>> m_worldMatricesInverse;
+
+    // Nodes whose local transformation changed since the last Update, and
+    // nodes whose world matrix changed in the last Update
+    std::vector<std::uint8_t> m_dirty;
+    std::vector<std::uint8_t> m_changed;
+    bool m_anyDirty = false;
+
+    void MarkDirty(std::size_t node);
+    void UpdateNode(std::size_t node);
+};
+
+BANG_MATH_DEFINE_USINGS(TransformHierarchy)
+}
+
+#include "BangMath/TransformHierarchy.tcc"
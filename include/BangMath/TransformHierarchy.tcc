@@ -0,0 +1,251 @@
+#include "BangMath/TransformHierarchy.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <thread>
+
+#include "BangMath/Parallel.h"
+
+namespace Bang
+{
+template <typename T>
+constexpr std::size_t TransformHierarchyG<T>::NullIndex;
+
+template <typename T>
+constexpr std::size_t TransformHierarchyG<T>::NodesPerTile;
+
+template <typename T>
+std::size_t TransformHierarchyG<T>::Add(
+    const TransformationG<T> &localTransformation,
+    std::size_t parent)
+{
+    assert(parent == NullIndex || parent < GetSize());
+
+    const std::size_t node = GetSize();
+    m_parents.push_back(parent);
+    m_localTransformations.push_back(localTransformation);
+    m_localMatrices.emplace_back();
+    m_localMatricesInverse.emplace_back();
+    m_worldMatrices.emplace_back();
+    m_worldMatricesInverse.emplace_back();
+    m_dirty.push_back(1);
+    m_changed.push_back(0);
+    m_anyDirty = true;
+    return node;
+}
+
+template <typename T>
+void TransformHierarchyG<T>::Reserve(std::size_t count)
+{
+    m_parents.reserve(count);
+    m_localTransformations.reserve(count);
+    m_localMatrices.reserve(count);
+    m_localMatricesInverse.reserve(count);
+    m_worldMatrices.reserve(count);
+    m_worldMatricesInverse.reserve(count);
+    m_dirty.reserve(count);
+    m_changed.reserve(count);
+}
+
+template <typename T>
+void TransformHierarchyG<T>::Clear()
+{
+    m_parents.clear();
+    m_localTransformations.clear();
+    m_localMatrices.clear();
+    m_localMatricesInverse.clear();
+    m_worldMatrices.clear();
+    m_worldMatricesInverse.clear();
+    m_dirty.clear();
+    m_changed.clear();
+    m_anyDirty = false;
+}
+
+template <typename T>
+void TransformHierarchyG<T>::SetLocalTransformation(
+    std::size_t node,
+    const TransformationG<T> &transformation)
+{
+    m_localTransformations[node] = transformation;
+    MarkDirty(node);
+}
+
+template <typename T>
+void TransformHierarchyG<T>::SetLocalPosition(std::size_t node,
+                                              const Vector3G<T> &position)
+{
+    m_localTransformations[node].SetPosition(position);
+    MarkDirty(node);
+}
+
+template <typename T>
+void TransformHierarchyG<T>::SetLocalRotation(std::size_t node,
+                                              const QuaternionG<T> &rotation)
+{
+    m_localTransformations[node].SetRotation(rotation);
+    MarkDirty(node);
+}
+
+template <typename T>
+void TransformHierarchyG<T>::SetLocalScale(std::size_t node,
+                                           const Vector3G<T> &scale)
+{
+    m_localTransformations[node].SetScale(scale);
+    MarkDirty(node);
+}
+
+template <typename T>
+void TransformHierarchyG<T>::Update(std::size_t numThreads)
+{
+    const std::size_t numNodes = GetSize();
+    if (!m_anyDirty)
+    {
+        std::fill(m_changed.begin(), m_changed.end(), 0);
+        return;
+    }
+    m_anyDirty = false;
+
+    const std::size_t numTiles = (numNodes + NodesPerTile - 1) / NodesPerTile;
+    numThreads = Parallel::GetThreadCount(numThreads, numTiles);
+    if (numThreads <= 1)
+    {
+        for (std::size_t node = 0; node < numNodes; ++node)
+        {
+            UpdateNode(node);
+        }
+        return;
+    }
+
+    // Tiles are claimed in order, so the tile a node waits for has been
+    // claimed already, and the wait always ends
+    std::unique_ptr<std::atomic<bool>[]> tilesDone(
+        new std::atomic<bool>[numTiles]);
+    for (std::size_t tile = 0; tile < numTiles; ++tile)
+    {
+        tilesDone[tile].store(false, std::memory_order_relaxed);
+    }
+
+    Parallel::ForTiles(
+        numNodes,
+        NodesPerTile,
+        numThreads,
+        [&](std::size_t begin, std::size_t end, std::size_t) {
+            for (std::size_t node = begin; node < end; ++node)
+            {
+                const std::size_t parent = m_parents[node];
+                if (parent != NullIndex && parent < begin)
+                {
+                    const std::atomic<bool> &parentTileDone =
+                        tilesDone[parent / NodesPerTile];
+                    while (!parentTileDone.load(std::memory_order_acquire))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+                UpdateNode(node);
+            }
+            tilesDone[begin / NodesPerTile].store(true,
+                                                  std::memory_order_release);
+        });
+}
+
+template <typename T>
+const Matrix4G<T> &TransformHierarchyG<T>::GetLocalMatrix(
+    std::size_t node) const
+{
+    return m_localMatrices[node];
+}
+
+template <typename T>
+const Matrix4G<T> &TransformHierarchyG<T>::GetWorldMatrix(
+    std::size_t node) const
+{
+    return m_worldMatrices[node];
+}
+
+template <typename T>
+const Matrix4G<T> &TransformHierarchyG<T>::GetWorldMatrixInverse(
+    std::size_t node) const
+{
+    return m_worldMatricesInverse[node];
+}
+
+template <typename T>
+const Matrix4G<T> *TransformHierarchyG<T>::GetWorldMatrices() const
+{
+    return m_worldMatrices.data();
+}
+
+template <typename T>
+bool TransformHierarchyG<T>::HasChanged(std::size_t node) const
+{
+    return m_changed[node] != 0;
+}
+
+template <typename T>
+bool TransformHierarchyG<T>::IsDirty() const
+{
+    return m_anyDirty;
+}
+
+template <typename T>
+const TransformationG<T> &TransformHierarchyG<T>::GetLocalTransformation(
+    std::size_t node) const
+{
+    return m_localTransformations[node];
+}
+
+template <typename T>
+std::size_t TransformHierarchyG<T>::GetParent(std::size_t node) const
+{
+    return m_parents[node];
+}
+
+template <typename T>
+std::size_t TransformHierarchyG<T>::GetSize() const
+{
+    return m_parents.size();
+}
+
+template <typename T>
+void TransformHierarchyG<T>::MarkDirty(std::size_t node)
+{
+    m_dirty[node] = 1;
+    m_anyDirty = true;
+}
+
+template <typename T>
+void TransformHierarchyG<T>::UpdateNode(std::size_t node)
+{
+    const std::size_t parent = m_parents[node];
+    const bool parentChanged = (parent != NullIndex && m_changed[parent]);
+    const bool localChanged = (m_dirty[node] != 0);
+    m_changed[node] = (localChanged || parentChanged);
+    if (!m_changed[node])
+    {
+        return;
+    }
+
+    if (localChanged)
+    {
+        const TransformationG<T> &local = m_localTransformations[node];
+        m_localMatrices[node] = local.GetMatrix();
+        m_localMatricesInverse[node] = local.GetMatrixInverse();
+        m_dirty[node] = 0;
+    }
+
+    if (parent == NullIndex)
+    {
+        m_worldMatrices[node] = m_localMatrices[node];
+        m_worldMatricesInverse[node] = m_localMatricesInverse[node];
+    }
+    else
+    {
+        m_worldMatrices[node] = m_worldMatrices[parent] * m_localMatrices[node];
+        m_worldMatricesInverse[node] =
+            m_localMatricesInverse[node] * m_worldMatricesInverse[parent];
+    }
+}
+}
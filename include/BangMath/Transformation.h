@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstddef>
+
 #include "BangMath/Defines.h"
 
 namespace Bang
 {
 template <typename>
+class Matrix3x4G;
+template <typename>
 class Matrix4G;
 template <typename>
 class Vector3G;
@@ -28,6 +32,9 @@ public:
     TransformationG<T> Inversed() const;
     Matrix4G<T> GetMatrix() const;
     Matrix4G<T> GetMatrixInverse() const;
+    // Same matrices without the constant last row, cheaper to build and use
+    Matrix3x4G<T> GetMatrix3x4() const;
+    Matrix3x4G<T> GetMatrix3x4Inverse() const;
     void FillFromMatrix(const Matrix4G<T> &transformMatrix);
 
     void SetPosition(const Vector3G<T> &position);
@@ -54,6 +61,21 @@ public:
     Vector3G<T> FromWorldToLocalVector(const Vector3G<T> &vector) const;
     Vector3G<T> FromWorldToLocalDirection(const Vector3G<T> &dir) const;
 
+    // Batch versions of the above. The matrix is built once for all the
+    // elements, and the output can be the same buffer as the input.
+    void FromLocalToWorldPoints(const Vector3G<T> *points,
+                                Vector3G<T> *pointsOut,
+                                std::size_t count) const;
+    void FromLocalToWorldVectors(const Vector3G<T> *vectors,
+                                 Vector3G<T> *vectorsOut,
+                                 std::size_t count) const;
+    void FromWorldToLocalPoints(const Vector3G<T> *points,
+                                Vector3G<T> *pointsOut,
+                                std::size_t count) const;
+    void FromWorldToLocalVectors(const Vector3G<T> *vectors,
+                                 Vector3G<T> *vectorsOut,
+                                 std::size_t count) const;
+
     const Vector3G<T> &GetPosition() const;
     const QuaternionG<T> &GetRotation() const;
     const Vector3G<T> &GetScale() const;
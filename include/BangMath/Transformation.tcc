@@ -1,6 +1,8 @@
 #pragma once
 #include "BangMath/Transformation.h"
 
+#include "BangMath/Matrix3x4.h"
+
 namespace Bang
 {
 template <typename T>
@@ -30,7 +32,7 @@ template <typename T>
 TransformationG<T> TransformationG<T>::Inversed() const
 {
     return TransformationG(
-        -GetPosition(), GetRotation().Inversed(), 1.0f / GetScale());
+        -GetPosition(), GetRotation().Inversed(), T(1) / GetScale());
 }
 
 template <typename T>
@@ -47,6 +49,20 @@ Matrix4G<T> TransformationG<T>::GetMatrixInverse() const
         GetPosition(), GetRotation(), GetScale());
 }
 
+template <typename T>
+Matrix3x4G<T> TransformationG<T>::GetMatrix3x4() const
+{
+    return Matrix3x4G<T>::TransformMatrix(
+        GetPosition(), GetRotation(), GetScale());
+}
+
+template <typename T>
+Matrix3x4G<T> TransformationG<T>::GetMatrix3x4Inverse() const
+{
+    return Matrix3x4G<T>::TransformMatrixInverse(
+        GetPosition(), GetRotation(), GetScale());
+}
+
 template <typename T>
 void TransformationG<T>::FillFromMatrix(const Matrix4G<T> &transformMatrix)
 {
@@ -146,14 +162,14 @@ template <typename T>
 Vector3G<T> TransformationG<T>::FromLocalToWorldPoint(
     const Vector3G<T> &point) const
 {
-    return GetMatrix().TransformedPoint(point);
+    return GetMatrix3x4().TransformedPoint(point);
 }
 
 template <typename T>
 Vector3G<T> TransformationG<T>::FromLocalToWorldVector(
     const Vector3G<T> &vector) const
 {
-    return GetMatrix().TransformedVector(vector);
+    return GetMatrix3x4().TransformedVector(vector);
 }
 
 template <typename T>
@@ -167,14 +183,14 @@ template <typename T>
 Vector3G<T> TransformationG<T>::FromWorldToLocalPoint(
     const Vector3G<T> &point) const
 {
-    return GetMatrixInverse().TransformedPoint(point);
+    return GetMatrix3x4Inverse().TransformedPoint(point);
 }
 
 template <typename T>
 Vector3G<T> TransformationG<T>::FromWorldToLocalVector(
     const Vector3G<T> &vector) const
 {
-    return GetMatrixInverse().TransformedVector(vector);
+    return GetMatrix3x4Inverse().TransformedVector(vector);
 }
 
 template <typename T>
@@ -184,6 +200,38 @@ Vector3G<T> TransformationG<T>::FromWorldToLocalDirection(
     return GetRotation().Inversed() * dir;
 }
 
+template <typename T>
+void TransformationG<T>::FromLocalToWorldPoints(const Vector3G<T> *points,
+                                                Vector3G<T> *pointsOut,
+                                                std::size_t count) const
+{
+    GetMatrix3x4().TransformPoints(points, pointsOut, count);
+}
+
+template <typename T>
+void TransformationG<T>::FromLocalToWorldVectors(const Vector3G<T> *vectors,
+                                                 Vector3G<T> *vectorsOut,
+                                                 std::size_t count) const
+{
+    GetMatrix3x4().TransformVectors(vectors, vectorsOut, count);
+}
+
+template <typename T>
+void TransformationG<T>::FromWorldToLocalPoints(const Vector3G<T> *points,
+                                                Vector3G<T> *pointsOut,
+                                                std::size_t count) const
+{
+    GetMatrix3x4Inverse().TransformPoints(points, pointsOut, count);
+}
+
+template <typename T>
+void TransformationG<T>::FromWorldToLocalVectors(const Vector3G<T> *vectors,
+                                                 Vector3G<T> *vectorsOut,
+                                                 std::size_t count) const
+{
+    GetMatrix3x4Inverse().TransformVectors(vectors, vectorsOut, count);
+}
+
 template <typename T>
 const Vector3G<T> &TransformationG<T>::GetPosition() const
 {
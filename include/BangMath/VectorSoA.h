@@ -0,0 +1,144 @@
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "BangMath/AlignedAllocator.h"
+#include "BangMath/Defines.h"
+#include "BangMath/SIMD.h"
+
+namespace Bang
+{
+template <typename>
+class Vector2G;
+template <typename>
+class Vector3G;
+template <typename>
+class Vector4G;
+
+// Structure-of-arrays storage for N-component vectors: one aligned stream per
+// component (all the x's, then all the y's, ...). Streams are padded to the
+// SIMD width and the padding is kept at zero, so the bulk operations below
+// always run on whole SIMD4G blocks.
+template <typename T, int N>
+class VectorSoAG
+{
+public:
+    using VectorType = typename std::conditional<
+        N == 2,
+        Vector2G<T>,
+        typename std::conditional<N == 3, Vector3G<T>, Vector4G<T>>::type>::
+        type;
+
+    // Proxy returned by operator[], reads and writes go to the streams
+    class Reference
+    {
+    public:
+        Reference(VectorSoAG<T, N> *soa, std::size_t index);
+
+        Reference &operator=(const VectorType &v);
+        Reference &operator=(const Reference &r);
+        operator VectorType() const;
+        T &operator[](std::size_t component);
+
+    private:
+        VectorSoAG<T, N> *m_soa = nullptr;
+        std::size_t m_index = 0;
+    };
+
+    VectorSoAG() = default;
+    explicit VectorSoAG(std::size_t size);
+    explicit VectorSoAG(const std::vector<VectorType> &vectors);
+
+    void Resize(std::size_t size);
+    void Reserve(std::size_t capacity);
+    void Clear();
+    void PushBack(const VectorType &v);
+
+    std::size_t GetSize() const;
+    // Size rounded up to the SIMD width. Lanes past GetSize() are zero.
+    std::size_t GetPaddedSize() const;
+    bool IsEmpty() const;
+
+    T *GetComponent(std::size_t component);
+    const T *GetComponent(std::size_t component) const;
+
+    VectorType Get(std::size_t i) const;
+    void Set(std::size_t i, const VectorType &v);
+
+    // AoS <-> SoA conversion. Storage is reused, so converting every frame
+    // does not allocate once the capacity has been reached.
+    void FromVectors(const VectorType *vectors, std::size_t count);
+    void FromVectors(const std::vector<VectorType> &vectors);
+    void ToVectors(VectorType *vectorsOut) const;
+    void ToVectors(std::vector<VectorType> *vectorsOut) const;
+
+    Reference operator[](std::size_t i);
+    VectorType operator[](std::size_t i) const;
+
+    // Element-wise bulk operations. a and b must have the same size, out is
+    // resized to it and can be a or b.
+    static void Add(const VectorSoAG<T, N> &a,
+                    const VectorSoAG<T, N> &b,
+                    VectorSoAG<T, N> *out);
+    static void Subtract(const VectorSoAG<T, N> &a,
+                         const VectorSoAG<T, N> &b,
+                         VectorSoAG<T, N> *out);
+    static void Multiply(const VectorSoAG<T, N> &a,
+                         const VectorSoAG<T, N> &b,
+                         VectorSoAG<T, N> *out);
+    static void Scale(const VectorSoAG<T, N> &a, T s, VectorSoAG<T, N> *out);
+    static void Lerp(const VectorSoAG<T, N> &a,
+                     const VectorSoAG<T, N> &b,
+                     T t,
+                     VectorSoAG<T, N> *out);
+    static void Min(const VectorSoAG<T, N> &a,
+                    const VectorSoAG<T, N> &b,
+                    VectorSoAG<T, N> *out);
+    static void Max(const VectorSoAG<T, N> &a,
+                    const VectorSoAG<T, N> &b,
+                    VectorSoAG<T, N> *out);
+    // Like NormalizedSafe, zero vectors stay zero
+    static void Normalize(const VectorSoAG<T, N> &a, VectorSoAG<T, N> *out);
+    // Only for N == 3
+    static void Cross(const VectorSoAG<T, N> &a,
+                      const VectorSoAG<T, N> &b,
+                      VectorSoAG<T, N> *out);
+
+    // Per-element scalars, out must hold a.GetSize() values
+    static void Dot(const VectorSoAG<T, N> &a,
+                    const VectorSoAG<T, N> &b,
+                    T *out);
+    static void SqLength(const VectorSoAG<T, N> &a, T *out);
+    static void Length(const VectorSoAG<T, N> &a, T *out);
+
+private:
+    static constexpr std::size_t Alignment = 32;
+
+    std::vector<T, AlignedAllocator<T, Alignment>> m_data;
+    std::size_t m_size = 0;
+    std::size_t m_stride = 0;
+
+    void Reallocate(std::size_t stride);
+    static std::size_t RoundUpStride(std::size_t n);
+    static SIMD4G<T> SqLengthBlock(const VectorSoAG<T, N> &a, std::size_t i);
+    static void StoreClipped(const SIMD4G<T> &values,
+                             std::size_t i,
+                             std::size_t size,
+                             T *out);
+};
+
+template <typename T>
+using Vector2SoAG = VectorSoAG<T, 2>;
+template <typename T>
+using Vector3SoAG = VectorSoAG<T, 3>;
+template <typename T>
+using Vector4SoAG = VectorSoAG<T, 4>;
+
+BANG_MATH_DEFINE_USINGS(Vector2SoA)
+BANG_MATH_DEFINE_USINGS(Vector3SoA)
+BANG_MATH_DEFINE_USINGS(Vector4SoA)
+}
+
+#include "BangMath/VectorSoA.tcc"
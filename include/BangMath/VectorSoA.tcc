@@ -0,0 +1,483 @@
+#include "BangMath/VectorSoA.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "BangMath/Math.h"
+
+namespace Bang
+{
+template <typename T, int N>
+VectorSoAG<T, N>::Reference::Reference(VectorSoAG<T, N> *soa,
+                                       std::size_t index)
+    : m_soa(soa), m_index(index)
+{
+}
+
+template <typename T, int N>
+typename VectorSoAG<T, N>::Reference &VectorSoAG<T, N>::Reference::operator=(
+    const VectorType &v)
+{
+    m_soa->Set(m_index, v);
+    return *this;
+}
+
+template <typename T, int N>
+typename VectorSoAG<T, N>::Reference &VectorSoAG<T, N>::Reference::operator=(
+    const Reference &r)
+{
+    m_soa->Set(m_index, static_cast<VectorType>(r));
+    return *this;
+}
+
+template <typename T, int N>
+VectorSoAG<T, N>::Reference::operator VectorType() const
+{
+    return m_soa->Get(m_index);
+}
+
+template <typename T, int N>
+T &VectorSoAG<T, N>::Reference::operator[](std::size_t component)
+{
+    return m_soa->GetComponent(component)[m_index];
+}
+
+template <typename T, int N>
+VectorSoAG<T, N>::VectorSoAG(std::size_t size)
+{
+    Resize(size);
+}
+
+template <typename T, int N>
+VectorSoAG<T, N>::VectorSoAG(const std::vector<VectorType> &vectors)
+{
+    FromVectors(vectors);
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Resize(std::size_t size)
+{
+    if (size > m_stride)
+    {
+        Reallocate(RoundUpStride(std::max(size, m_stride * 2)));
+    }
+    else
+    {
+        // Keep the padding invariant for the elements we drop
+        for (int c = 0; c < N; ++c)
+        {
+            T *component = GetComponent(c);
+            std::fill(component + std::min(size, m_size),
+                      component + m_size,
+                      static_cast<T>(0));
+        }
+    }
+    m_size = size;
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Reserve(std::size_t capacity)
+{
+    if (capacity > m_stride)
+    {
+        Reallocate(RoundUpStride(capacity));
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Clear()
+{
+    Resize(0);
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::PushBack(const VectorType &v)
+{
+    Resize(GetSize() + 1);
+    Set(GetSize() - 1, v);
+}
+
+template <typename T, int N>
+std::size_t VectorSoAG<T, N>::GetSize() const
+{
+    return m_size;
+}
+
+template <typename T, int N>
+std::size_t VectorSoAG<T, N>::GetPaddedSize() const
+{
+    return (GetSize() + 3) & ~static_cast<std::size_t>(3);
+}
+
+template <typename T, int N>
+bool VectorSoAG<T, N>::IsEmpty() const
+{
+    return (GetSize() == 0);
+}
+
+template <typename T, int N>
+T *VectorSoAG<T, N>::GetComponent(std::size_t component)
+{
+    assert(component < static_cast<std::size_t>(N));
+    return m_data.data() + component * m_stride;
+}
+
+template <typename T, int N>
+const T *VectorSoAG<T, N>::GetComponent(std::size_t component) const
+{
+    assert(component < static_cast<std::size_t>(N));
+    return m_data.data() + component * m_stride;
+}
+
+template <typename T, int N>
+typename VectorSoAG<T, N>::VectorType VectorSoAG<T, N>::Get(
+    std::size_t i) const
+{
+    assert(i < GetSize());
+    VectorType v;
+    for (int c = 0; c < N; ++c)
+    {
+        v[c] = GetComponent(c)[i];
+    }
+    return v;
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Set(std::size_t i, const VectorType &v)
+{
+    assert(i < GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        GetComponent(c)[i] = v[c];
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::FromVectors(const VectorType *vectors,
+                                   std::size_t count)
+{
+    Resize(count);
+    for (int c = 0; c < N; ++c)
+    {
+        T *component = GetComponent(c);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            component[i] = vectors[i][c];
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::FromVectors(const std::vector<VectorType> &vectors)
+{
+    FromVectors(vectors.data(), vectors.size());
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::ToVectors(VectorType *vectorsOut) const
+{
+    for (int c = 0; c < N; ++c)
+    {
+        const T *component = GetComponent(c);
+        for (std::size_t i = 0; i < GetSize(); ++i)
+        {
+            vectorsOut[i][c] = component[i];
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::ToVectors(std::vector<VectorType> *vectorsOut) const
+{
+    vectorsOut->resize(GetSize());
+    ToVectors(vectorsOut->data());
+}
+
+template <typename T, int N>
+typename VectorSoAG<T, N>::Reference VectorSoAG<T, N>::operator[](
+    std::size_t i)
+{
+    return Reference(this, i);
+}
+
+template <typename T, int N>
+typename VectorSoAG<T, N>::VectorType VectorSoAG<T, N>::operator[](
+    std::size_t i) const
+{
+    return Get(i);
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Add(const VectorSoAG<T, N> &a,
+                           const VectorSoAG<T, N> &b,
+                           VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            (SIMD4G<T>::Load(ac + i) + SIMD4G<T>::Load(bc + i)).Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Subtract(const VectorSoAG<T, N> &a,
+                                const VectorSoAG<T, N> &b,
+                                VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            (SIMD4G<T>::Load(ac + i) - SIMD4G<T>::Load(bc + i)).Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Multiply(const VectorSoAG<T, N> &a,
+                                const VectorSoAG<T, N> &b,
+                                VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            (SIMD4G<T>::Load(ac + i) * SIMD4G<T>::Load(bc + i)).Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Scale(const VectorSoAG<T, N> &a,
+                             T s,
+                             VectorSoAG<T, N> *out)
+{
+    out->Resize(a.GetSize());
+    const SIMD4G<T> scale(s);
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            (SIMD4G<T>::Load(ac + i) * scale).Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Lerp(const VectorSoAG<T, N> &a,
+                            const VectorSoAG<T, N> &b,
+                            T t,
+                            VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    const SIMD4G<T> tv(t);
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            const SIMD4G<T> av = SIMD4G<T>::Load(ac + i);
+            const SIMD4G<T> bv = SIMD4G<T>::Load(bc + i);
+            (av + (bv - av) * tv).Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Min(const VectorSoAG<T, N> &a,
+                           const VectorSoAG<T, N> &b,
+                           VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            SIMD4G<T>::Min(SIMD4G<T>::Load(ac + i), SIMD4G<T>::Load(bc + i))
+                .Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Max(const VectorSoAG<T, N> &a,
+                           const VectorSoAG<T, N> &b,
+                           VectorSoAG<T, N> *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (int c = 0; c < N; ++c)
+    {
+        const T *ac = a.GetComponent(c);
+        const T *bc = b.GetComponent(c);
+        T *oc = out->GetComponent(c);
+        for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+        {
+            SIMD4G<T>::Max(SIMD4G<T>::Load(ac + i), SIMD4G<T>::Load(bc + i))
+                .Store(oc + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Normalize(const VectorSoAG<T, N> &a,
+                                 VectorSoAG<T, N> *out)
+{
+    out->Resize(a.GetSize());
+
+    // Dividing by max(length, min normal) leaves zero vectors (and padding)
+    // at zero without needing a per-lane select
+    const SIMD4G<T> minLength(Math::Min<T>());
+    for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+    {
+        const SIMD4G<T> length =
+            SIMD4G<T>::Max(SIMD4G<T>::Sqrt(SqLengthBlock(a, i)), minLength);
+        for (int c = 0; c < N; ++c)
+        {
+            (SIMD4G<T>::Load(a.GetComponent(c) + i) / length)
+                .Store(out->GetComponent(c) + i);
+        }
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Cross(const VectorSoAG<T, N> &a,
+                             const VectorSoAG<T, N> &b,
+                             VectorSoAG<T, N> *out)
+{
+    static_assert(N == 3, "Cross is only defined for 3D vectors");
+    assert(a.GetSize() == b.GetSize());
+    out->Resize(a.GetSize());
+    for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+    {
+        const SIMD4G<T> ax = SIMD4G<T>::Load(a.GetComponent(0) + i);
+        const SIMD4G<T> ay = SIMD4G<T>::Load(a.GetComponent(1) + i);
+        const SIMD4G<T> az = SIMD4G<T>::Load(a.GetComponent(2) + i);
+        const SIMD4G<T> bx = SIMD4G<T>::Load(b.GetComponent(0) + i);
+        const SIMD4G<T> by = SIMD4G<T>::Load(b.GetComponent(1) + i);
+        const SIMD4G<T> bz = SIMD4G<T>::Load(b.GetComponent(2) + i);
+        ((ay * bz) - (az * by)).Store(out->GetComponent(0) + i);
+        ((az * bx) - (ax * bz)).Store(out->GetComponent(1) + i);
+        ((ax * by) - (ay * bx)).Store(out->GetComponent(2) + i);
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Dot(const VectorSoAG<T, N> &a,
+                           const VectorSoAG<T, N> &b,
+                           T *out)
+{
+    assert(a.GetSize() == b.GetSize());
+    for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+    {
+        SIMD4G<T> dot(static_cast<T>(0));
+        for (int c = 0; c < N; ++c)
+        {
+            dot = dot + SIMD4G<T>::Load(a.GetComponent(c) + i) *
+                            SIMD4G<T>::Load(b.GetComponent(c) + i);
+        }
+        StoreClipped(dot, i, a.GetSize(), out);
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::SqLength(const VectorSoAG<T, N> &a, T *out)
+{
+    for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+    {
+        StoreClipped(SqLengthBlock(a, i), i, a.GetSize(), out);
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Length(const VectorSoAG<T, N> &a, T *out)
+{
+    for (std::size_t i = 0; i < a.GetPaddedSize(); i += 4)
+    {
+        StoreClipped(
+            SIMD4G<T>::Sqrt(SqLengthBlock(a, i)), i, a.GetSize(), out);
+    }
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::Reallocate(std::size_t stride)
+{
+    std::vector<T, AlignedAllocator<T, Alignment>> data(N * stride,
+                                                        static_cast<T>(0));
+    for (int c = 0; c < N; ++c)
+    {
+        std::copy(GetComponent(c),
+                  GetComponent(c) + GetSize(),
+                  data.data() + c * stride);
+    }
+    m_data.swap(data);
+    m_stride = stride;
+}
+
+template <typename T, int N>
+std::size_t VectorSoAG<T, N>::RoundUpStride(std::size_t n)
+{
+    // Multiple of the SIMD width, and of the alignment so that every
+    // component stream starts aligned too
+    const std::size_t granule =
+        std::max(static_cast<std::size_t>(4), Alignment / sizeof(T));
+    return ((n + granule - 1) / granule) * granule;
+}
+
+template <typename T, int N>
+SIMD4G<T> VectorSoAG<T, N>::SqLengthBlock(const VectorSoAG<T, N> &a,
+                                          std::size_t i)
+{
+    SIMD4G<T> sqLength(static_cast<T>(0));
+    for (int c = 0; c < N; ++c)
+    {
+        const SIMD4G<T> v = SIMD4G<T>::Load(a.GetComponent(c) + i);
+        sqLength = sqLength + v * v;
+    }
+    return sqLength;
+}
+
+template <typename T, int N>
+void VectorSoAG<T, N>::StoreClipped(const SIMD4G<T> &values,
+                                    std::size_t i,
+                                    std::size_t size,
+                                    T *out)
+{
+    if (i + 4 <= size)
+    {
+        values.Store(out + i);
+    }
+    else
+    {
+        T block[4];
+        values.Store(block);
+        std::copy(block, block + (size - i), out + i);
+    }
+}
+}